@@ -1,12 +1,39 @@
 #include "EffectEngine.h"
 #include "FileAudioIO.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <cstring>
+#include <vector>
 
 using namespace gearboxfx;
 
+struct LooperEvent {
+    double        seconds;
+    LooperCommand cmd;
+};
+
+// "<seconds>:<command>,..." sorted by time; false on a malformed entry.
+static bool parseLooperEvents(const std::string& list, std::vector<LooperEvent>& events) {
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        const size_t colon = item.find(':');
+        if (colon == std::string::npos) return false;
+        LooperEvent ev{};
+        char* end = nullptr;
+        ev.seconds = std::strtod(item.c_str(), &end);
+        if (end != item.c_str() + colon || ev.seconds < 0.0) return false;
+        if (!parseLooperCommand(item.substr(colon + 1), ev.cmd)) return false;
+        events.push_back(ev);
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const LooperEvent& a, const LooperEvent& b) { return a.seconds < b.seconds; });
+    return !events.empty();
+}
+
 static void printUsage(const char* prog) {
     std::cout <<
         "Usage: " << prog << " [options]\n"
@@ -18,6 +45,11 @@ static void printUsage(const char* prog) {
         "  --play            Stream output to speakers (real-time mode)\n"
         "  --buffer <size>   DSP buffer size in frames (default: 256)\n"
         "  --bypass          Bypass all effects (pass-through)\n"
+        "  --bpm <tempo>     Tempo for synced modulation (default: the preset's \"bpm\")\n"
+        "  --looper <list>   Looper commands at input times, e.g. 0:record,4:play,8:overdub\n"
+        "                    (record play overdub stop undo redo clear; --output only)\n"
+        "  --profile         Print per-node DSP timing after the render (--output only)\n"
+        "  --profile-hw      As --profile, plus per-type hardware counters (Linux perf)\n"
         "  --list-presets    Print registered effect types and exit\n"
         "  --help            Show this help\n"
         "\n"
@@ -35,7 +67,11 @@ int main(int argc, char* argv[]) {
     bool        playMode    = false;
     bool        bypassMode  = false;
     bool        listPresets = false;
+    bool        profile     = false;
+    bool        profileHw   = false;
     int         bufferSize  = 256;
+    double      bpm         = 0.0;  // 0 = the preset's tempo
+    std::vector<LooperEvent> looperEvents;
 
     for (int i = 1; i < argc; ++i) {
         if (std::strcmp(argv[i], "--input") == 0 && i + 1 < argc)
@@ -50,6 +86,18 @@ int main(int argc, char* argv[]) {
             bypassMode = true;
         else if (std::strcmp(argv[i], "--buffer") == 0 && i + 1 < argc)
             bufferSize = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--bpm") == 0 && i + 1 < argc)
+            bpm = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--looper") == 0 && i + 1 < argc) {
+            if (!parseLooperEvents(argv[++i], looperEvents)) {
+                std::cerr << "Error: bad --looper list '" << argv[i] << "'\n";
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--profile") == 0)
+            profile = true;
+        else if (std::strcmp(argv[i], "--profile-hw") == 0)
+            profile = profileHw = true;
         else if (std::strcmp(argv[i], "--list-presets") == 0)
             listPresets = true;
         else if (std::strcmp(argv[i], "--help") == 0) {
@@ -89,6 +137,17 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    if (profile && playMode) {
+        std::cerr << "Error: --profile needs a file render (--output)\n";
+        return 1;
+    }
+    if (!looperEvents.empty() && playMode) {
+        std::cerr << "Error: --looper needs a file render (--output)\n";
+        return 1;
+    }
+    if (profile && !ChainProfiler::kCompiledIn)
+        std::cerr << "Warning: built without GEARBOX_PROFILER, --profile has no effect\n";
+
     // Prepare engine with default format (FileAudioIO will update after decoding)
     engine.prepare(48000.0, bufferSize);
 
@@ -98,7 +157,11 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    if (bpm > 0.0)
+        engine.setTempo(bpm);
     engine.setBypass(bypassMode);
+    engine.chain().profiler().setEnabled(profile);
+    engine.chain().profiler().setHardwareCounters(profileHw);
 
     // Configure file-sim
     FileSimConfig cfg;
@@ -113,9 +176,21 @@ int main(int argc, char* argv[]) {
     fmt.bufferSize = static_cast<uint32_t>(bufferSize);
     io.open(fmt);
 
-    // Progress bar (file-to-file only)
+    const auto& nodes = engine.chain().nodes();
+    if (!looperEvents.empty() &&
+        std::none_of(nodes.begin(), nodes.end(), [](const auto& n) { return n->typeId() == "utility.looper"; }))
+        std::cerr << "Warning: --looper given but the preset has no utility.looper\n";
+
+    // Progress bar (file-to-file only). The callback runs between blocks on
+    // the render thread, so it also drains the profiler's ring and sends the
+    // looper commands that are due (they take effect with the next block).
     if (!playMode) {
-        io.setProgressCallback([](float p) {
+        size_t nextEvent = 0;
+        io.setProgressCallback([&engine, &io, &looperEvents, nextEvent](float p) mutable {
+            for (; nextEvent < looperEvents.size() &&
+                   looperEvents[nextEvent].seconds <= io.positionSeconds(); ++nextEvent)
+                engine.looperCommand(looperEvents[nextEvent].cmd);
+            engine.chain().profiler().collect();
             int pct = static_cast<int>(p * 100.0f);
             std::cout << "\rProcessing: " << pct << "%" << std::flush;
         });
@@ -126,6 +201,12 @@ int main(int argc, char* argv[]) {
     if (!playMode)
         std::cout << "\rProcessing: 100%\nDone! Output: " << outputPath << "\n";
 
+    if (profile) {
+        ChainProfiler& prof = engine.chain().profiler();
+        prof.collect();
+        std::cout << "\n" << prof.report(engine.chain()).format();
+    }
+
     io.close();
     return 0;
 }
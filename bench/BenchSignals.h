@@ -0,0 +1,59 @@
+#pragma once
+#include "AudioBuffer.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace gearboxfx {
+namespace bench {
+
+// Deterministic guitar-like test signal: Karplus-Strong plucks of an
+// open-chord arpeggio, re-plucked every 250 ms at varying strength, peaking
+// around -6 dBFS. The same (sampleRate, seconds, seed) always gives the same
+// samples, so runs compare across machines and commits. Both channels of a
+// stereo buffer carry the signal, slightly decorrelated.
+inline AudioBuffer makeGuitarSignal(double sampleRate, double seconds,
+                                    int numChannels, std::uint32_t seed = 1)
+{
+    const int n = static_cast<int>(sampleRate * seconds);
+    AudioBuffer buf(numChannels, n);
+
+    std::uint32_t rng = seed * 747796405u + 2891336453u;
+    auto noise = [&rng]() {
+        rng = rng * 1664525u + 1013904223u;
+        return static_cast<float>(rng >> 8) / 8388608.0f - 1.0f;  // [-1, 1)
+    };
+
+    const float chord[] = { 82.41f, 123.47f, 164.81f, 207.65f, 246.94f, 329.63f };  // E major
+    const int   pluckEvery = static_cast<int>(sampleRate * 0.25);
+
+    std::vector<float> mix(n, 0.0f);
+    for (int k = 0; (k * pluckEvery) < n; ++k) {
+        const float hz    = chord[k % 6];
+        const int   len   = static_cast<int>(sampleRate / hz);
+        const float level = 0.15f + 0.1f * static_cast<float>(k % 3);
+
+        std::vector<float> line(len);
+        for (auto& x : line) x = level * noise();
+
+        // Ring for up to 2 s, averaging filter as the string loss
+        const int start = k * pluckEvery;
+        const int end   = std::min(n, start + static_cast<int>(sampleRate * 2.0));
+        for (int i = start, p = 0; i < end; ++i) {
+            const int q = (p + 1 == len) ? 0 : p + 1;
+            mix[i] += line[p];
+            line[p] = 0.498f * (line[p] + line[q]);
+            p = q;
+        }
+    }
+
+    for (int c = 0; c < numChannels; ++c) {
+        float* out = buf.getWritePointer(c);
+        for (int i = 0; i < n; ++i)
+            out[i] = mix[i] + 1e-4f * noise();  // a little hiss keeps gates honest
+    }
+    return buf;
+}
+
+} // namespace bench
+} // namespace gearboxfx
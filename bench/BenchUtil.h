@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+
+namespace gearboxfx {
+namespace bench {
+
+// Build description stored with every JSON result, so numbers from
+// different compilers or Debug builds are not compared by accident.
+inline std::string compilerId() {
+#if defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#elif defined(__clang__)
+    return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    return std::string("gcc ") + __VERSION__;
+#else
+    return "unknown";
+#endif
+}
+
+inline const char* buildConfig() {
+#ifdef GEARBOX_BENCH_CONFIG
+    return GEARBOX_BENCH_CONFIG;
+#else
+    return "";
+#endif
+}
+
+} // namespace bench
+} // namespace gearboxfx
@@ -0,0 +1,305 @@
+// gearboxfx_bench: per-node microbenchmarks.
+//
+// Every type in EffectNodeRegistry is timed over block sizes 16..4096,
+// sample rates 44.1/48/96 kHz, mono and stereo, and a few representative
+// parameter sets, on a deterministic synthetic guitar signal. Each case runs
+// a warm-up, then several timed passes; the median pass is reported as
+// ns per sample frame and real-time factor (processing time / audio time,
+// so 0.01 means 1% of one core). Results go out as JSON (one object per
+// case, keyed "type|params|rate|block|channels") so two runs diff cleanly,
+// and --compare prints the cases that moved against an earlier run.
+
+#include "BenchSignals.h"
+#include "BenchUtil.h"
+#include "effects/EffectNodeRegistry.h"
+#include "dsp/Denormals.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace gearboxfx;
+using json = nlohmann::json;
+
+namespace {
+
+struct ParamSet {
+    std::string type;
+    std::string name;
+    std::map<std::string, float> values;
+    json        data = nullptr;  // EffectNode::loadData, if set
+};
+
+// Deterministic recurrent amp model ({"model": ...} node data, PyTorch layout,
+// see RecurrentModel.h). The cost depends on the type and hidden size only;
+// the weights are scaled by 1/sqrt(H) so the state stays out of saturation.
+json recurrentModel(const std::string& type, int hidden) {
+    const int   gates = (type == "lstm") ? 4 : 3;
+    const float scale = 1.0f / std::sqrt(static_cast<float>(hidden));
+    auto w = [](int i) { return 0.4f * std::sin(1.7f * static_cast<float>(i) + 0.3f); };
+
+    json wih = json::array(), whh = json::array(), bih = json::array(), bhh = json::array();
+    for (int r = 0; r < gates * hidden; ++r) {
+        wih.push_back({ 2.0f * w(r) });  // input size 1
+        json row = json::array();
+        for (int k = 0; k < hidden; ++k) row.push_back(scale * w(100 + r * hidden + k));
+        whh.push_back(row);
+        bih.push_back(0.5f * w(50000 + r));
+        bhh.push_back(0.5f * w(70000 + r));
+    }
+    json dense = json::array();
+    for (int k = 0; k < hidden; ++k) dense.push_back(scale * w(90000 + k));
+
+    return { {"model", {
+        {"type", type}, {"hidden_size", hidden},
+        {"weight_ih", wih}, {"weight_hh", whh},
+        {"bias_ih", bih}, {"bias_hh", bhh},
+        {"dense_weight", dense}, {"dense_bias", 0.0f}, {"skip", true} }} };
+}
+
+// Settings that change the cost of a node noticeably. Every type is also
+// run at its defaults.
+const std::vector<ParamSet> kParamSets = {
+    { "amp.neural",                "lstm_8",     {}, recurrentModel("lstm", 8) },
+    { "amp.neural",                "lstm_16",    {}, recurrentModel("lstm", 16) },
+    { "amp.neural",                "lstm_32",    {}, recurrentModel("lstm", 32) },
+    { "amp.neural",                "gru_8",      {}, recurrentModel("gru", 8) },
+    { "amp.neural",                "gru_16",     {}, recurrentModel("gru", 16) },
+    { "amp.neural",                "gru_32",     {}, recurrentModel("gru", 32) },
+    { "cab.short_ir",              "taps_1024",  { {"taps", 1024.0f} } },
+    { "dynamics.compressor",       "heavy",      { {"threshold_db", -40.0f}, {"ratio", 20.0f} } },
+    { "gain.distortion",           "antialias",  { {"gain", 1.0f}, {"antialias", 2.0f} } },
+    { "gain.overdrive",            "antialias",  { {"gain", 1.0f}, {"antialias", 2.0f} } },
+    { "modulation.chorus",         "voices_8",   { {"voices", 8.0f} } },
+    { "modulation.pitch_shifter",  "vocoder",    { {"mode", 1.0f}, {"semitones", 7.0f} } },
+    { "modulation.pitch_shifter",  "vocoder_4096", { {"mode", 1.0f}, {"fft_size", 4096.0f}, {"overlap", 8.0f} } },
+    { "modulation.pitch_shifter",  "psola",      { {"mode", 2.0f}, {"semitones", 7.0f} } },
+    { "time.delay",                "long",       { {"time_ms", 2000.0f}, {"feedback", 0.9f} } },
+    { "time.reverb",               "large",      { {"size", 1.0f}, {"decay", 1.0f} } },
+};
+
+struct Options {
+    std::vector<int>    blockSizes  = { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    std::vector<double> sampleRates = { 44100.0, 48000.0, 96000.0 };
+    std::vector<int>    channels    = { 1, 2 };
+    double      passSeconds = 0.2;   // audio per timed pass
+    int         passes      = 5;
+    std::string filter;              // substring of "type|params"
+    std::string outPath;
+    std::string comparePath;
+    double      threshold   = 5.0;   // %, for --compare
+    std::string label;
+};
+
+void printUsage(const char* prog) {
+    std::cout <<
+        "Usage: " << prog << " [options]\n"
+        "\n"
+        "Options:\n"
+        "  --out <path>        Write JSON results to <path> (default: stdout)\n"
+        "  --compare <path>    Compare against an earlier JSON run\n"
+        "  --threshold <pct>   Report changes above this (default: 5)\n"
+        "  --filter <text>     Only cases whose \"type|params\" contains <text>\n"
+        "  --quick             48 kHz stereo, blocks 64/256/1024, 3 passes\n"
+        "  --passes <n>        Timed passes per case (default: 5)\n"
+        "  --seconds <s>       Audio per timed pass (default: 0.2)\n"
+        "  --label <text>      Stored in the JSON (e.g. a commit id)\n"
+        "  --help              Show this help\n";
+}
+
+// Median-of-passes ns per sample frame for one case.
+double timeCase(EffectNode& node, const AudioBuffer& signal, int blockSize,
+                int numChannels, const Options& opt)
+{
+    ScopedFlushDenormals noDenormals;  // as EffectEngine::processBlock runs the nodes
+    AudioBuffer out(numChannels, blockSize);
+    float* inPtrs[2] = {};
+    const int len = signal.numSamples();
+    int pos = 0;
+
+    auto runSamples = [&](long long total) {
+        for (long long done = 0; done < total; done += blockSize) {
+            if (pos + blockSize > len) pos = 0;
+            for (int c = 0; c < numChannels; ++c)
+                inPtrs[c] = const_cast<float*>(signal.getReadPointer(c)) + pos;
+            AudioBufferView in { inPtrs, numChannels, blockSize };
+            node.process(in, out.view(), blockSize);
+            pos += blockSize;
+        }
+    };
+
+    const double sr = len / 2.0;  // signals are 2 s long
+    const long long passSamples =
+        std::max<long long>(blockSize * 4LL, static_cast<long long>(sr * opt.passSeconds));
+
+    runSamples(static_cast<long long>(sr * 0.1));  // warm-up: caches, lazy tables, envelopes
+
+    std::vector<double> nsPerSample;
+    for (int p = 0; p < opt.passes; ++p) {
+        auto t0 = std::chrono::steady_clock::now();
+        runSamples(passSamples);
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        long long blocks = (passSamples + blockSize - 1) / blockSize;
+        nsPerSample.push_back(ns / static_cast<double>(blocks * blockSize));
+    }
+    std::nth_element(nsPerSample.begin(), nsPerSample.begin() + nsPerSample.size() / 2, nsPerSample.end());
+    return nsPerSample[nsPerSample.size() / 2];
+}
+
+int compare(const json& current, const std::string& baselinePath, double threshold) {
+    std::ifstream f(baselinePath);
+    if (!f) {
+        std::cerr << "Cannot open baseline: " << baselinePath << "\n";
+        return 1;
+    }
+    json baseline = json::parse(f, nullptr, false);
+    if (baseline.is_discarded() || !baseline.contains("results")) {
+        std::cerr << "Not a gearboxfx_bench result: " << baselinePath << "\n";
+        return 1;
+    }
+
+    std::map<std::string, double> before;
+    for (const auto& r : baseline["results"])
+        before[r.value("key", "")] = r.value("ns_per_sample", 0.0);
+
+    int slower = 0, faster = 0, matched = 0;
+    for (const auto& r : current["results"]) {
+        auto it = before.find(r["key"].get<std::string>());
+        if (it == before.end() || it->second <= 0.0) continue;
+        ++matched;
+        double now   = r["ns_per_sample"].get<double>();
+        double delta = 100.0 * (now - it->second) / it->second;
+        if (std::abs(delta) < threshold) continue;
+        (delta > 0 ? slower : faster)++;
+        std::fprintf(stderr, "%-60s %9.2f -> %9.2f ns/sample  %+6.1f%%\n",
+                     it->first.c_str(), it->second, now, delta);
+    }
+    std::fprintf(stderr, "%d cases compared: %d slower, %d faster (threshold %.1f%%)\n",
+                 matched, slower, faster, threshold);
+    return 0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            opt.outPath = argv[++i];
+        else if (std::strcmp(argv[i], "--compare") == 0 && i + 1 < argc)
+            opt.comparePath = argv[++i];
+        else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+            opt.threshold = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            opt.filter = argv[++i];
+        else if (std::strcmp(argv[i], "--passes") == 0 && i + 1 < argc)
+            opt.passes = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+            opt.passSeconds = std::max(0.001, std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--label") == 0 && i + 1 < argc)
+            opt.label = argv[++i];
+        else if (std::strcmp(argv[i], "--quick") == 0) {
+            opt.blockSizes  = { 64, 256, 1024 };
+            opt.sampleRates = { 48000.0 };
+            opt.channels    = { 2 };
+            opt.passes      = 3;
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    EffectNodeRegistry registry;
+    std::vector<std::string> types = registry.registeredTypes();
+    std::sort(types.begin(), types.end());
+
+    std::vector<ParamSet> cases;
+    for (const auto& t : types) {
+        cases.push_back({ t, "default", {} });
+        for (const auto& p : kParamSets)
+            if (p.type == t) cases.push_back(p);
+    }
+
+    std::map<double, AudioBuffer> signals;
+    for (double sr : opt.sampleRates)
+        signals.emplace(sr, bench::makeGuitarSignal(sr, 2.0, 2));
+
+    json results = json::array();
+    for (const auto& pc : cases) {
+        const std::string name = pc.type + "|" + pc.name;
+        if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) continue;
+
+        for (double sr : opt.sampleRates)
+        for (int ch : opt.channels)
+        for (int bs : opt.blockSizes) {
+            auto node = registry.create(pc.type);
+            for (const auto& [param, value] : pc.values)
+                node->setParam(param, value);
+            if (!pc.data.is_null())
+                node->loadData(pc.data);
+            node->prepare(sr, bs);
+
+            double ns  = timeCase(*node, signals.at(sr), bs, ch, opt);
+            double rtf = ns * sr * 1e-9;
+
+            char key[160];
+            std::snprintf(key, sizeof(key), "%s|%g|%d|%d", name.c_str(), sr, bs, ch);
+            results.push_back({
+                { "key",           key },
+                { "type",          pc.type },
+                { "params",        pc.name },
+                { "sample_rate",   sr },
+                { "block_size",    bs },
+                { "channels",      ch },
+                { "ns_per_sample", ns },
+                { "rtf",           rtf },
+                { "latency",       node->latencySamples() },
+            });
+            std::fprintf(stderr, "%-60s %9.2f ns/sample  rtf %.5f\n", key, ns, rtf);
+        }
+    }
+
+    char stamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    json doc = {
+        { "schema",    1 },
+        { "tool",      "gearboxfx_bench" },
+        { "label",     opt.label },
+        { "timestamp", stamp },
+        { "compiler",  bench::compilerId() },
+        { "config",    bench::buildConfig() },
+        { "passes",    opt.passes },
+        { "pass_seconds", opt.passSeconds },
+        { "results",   results },
+    };
+
+    if (opt.outPath.empty()) {
+        std::cout << doc.dump(2) << "\n";
+    } else {
+        std::ofstream f(opt.outPath);
+        if (!f) {
+            std::cerr << "Cannot write " << opt.outPath << "\n";
+            return 1;
+        }
+        f << doc.dump(2) << "\n";
+    }
+
+    if (!opt.comparePath.empty())
+        return compare(doc, opt.comparePath, opt.threshold);
+    return 0;
+}
@@ -0,0 +1,361 @@
+// gearboxfx_preset_bench: whole-preset throughput and regression check.
+//
+// Renders every preset in presets/ through a full EffectEngine over the WAV
+// files in test-audio/ and two deterministic synthetic guitar signals
+// (48 and 96 kHz). Per preset it reports the real-time factor (processing
+// time / audio time, median of the passes) and the worst and 99th-percentile
+// block times as a share of the block deadline. The first pass is a warm-up
+// for the block statistics. Worst blocks include any preemption of the
+// render thread, so measure on an otherwise idle machine.
+//
+// With --budgets <file> the run fails (exit code 2) when a preset is over an
+// absolute budget, has no recorded baseline, or is slower than its baseline
+// by more than the allowed regression. --record writes the current real-time
+// factors into that file as the new baselines. Format (all keys optional):
+//   {
+//     "regression_pct": 10,          // allowed slowdown vs. a baseline
+//     "max_rtf": 0.25,               // absolute budgets, every preset
+//     "max_worst_block_pct": 100,    // of the block deadline
+//     "presets": {
+//       "05_delay_reverb": { "rtf": 0.0123, "regression_pct": 15 }
+//     }
+//   }
+// Baselines are machine-specific: record them on the machine that checks them.
+// The shipped file has none, so a check fails until they are recorded.
+
+#define DR_WAV_IMPLEMENTATION
+#include "dr_wav.h"
+
+#include "BenchSignals.h"
+#include "BenchUtil.h"
+#include "EffectEngine.h"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace gearboxfx;
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+namespace {
+
+#ifdef GEARBOX_BENCH_DATA_DIR
+const std::string kDataDir = GEARBOX_BENCH_DATA_DIR;
+#else
+const std::string kDataDir = ".";
+#endif
+
+struct Options {
+    std::string presetsDir = kDataDir + "/presets";
+    std::string audioDir   = kDataDir + "/test-audio";
+    int         blockSize  = 256;
+    double      maxSeconds = 10.0;  // per input
+    int         passes     = 3;
+    std::string filter;
+    std::string outPath;
+    std::string budgetsPath;
+    bool        record     = false;
+};
+
+struct Input {
+    std::string name;
+    double      sampleRate = 48000.0;
+    AudioBuffer audio;  // stereo
+};
+
+struct InputResult {
+    std::string name;
+    double sampleRate = 0.0, seconds = 0.0;
+    double rtf = 0.0;
+    double worstBlockUs = 0.0, worstBlockPct = 0.0;
+    double p99BlockPct = 0.0;
+};
+
+void printUsage(const char* prog) {
+    std::cout <<
+        "Usage: " << prog << " [options]\n"
+        "\n"
+        "Options:\n"
+        "  --presets <dir>     Preset directory (default: <source>/presets)\n"
+        "  --audio <dir>       WAV directory (default: <source>/test-audio)\n"
+        "  --block <size>      Block size in frames (default: 256)\n"
+        "  --seconds <s>       Longest stretch of each input to render (default: 10)\n"
+        "  --passes <n>        Timed passes per input (default: 3)\n"
+        "  --filter <text>     Only presets whose file name contains <text>\n"
+        "  --out <path>        Write JSON results to <path>\n"
+        "  --budgets <path>    Check results against a budget file (exit 2 on failure)\n"
+        "  --record            With --budgets: store this run's RTFs as the baselines\n"
+        "  --help              Show this help\n";
+}
+
+bool loadWav(const fs::path& path, double maxSeconds, Input& out) {
+    unsigned int  channels = 0, sampleRate = 0;
+    drwav_uint64  frames   = 0;
+    float* pcm = drwav_open_file_and_read_pcm_frames_f32(path.string().c_str(),
+                                                         &channels, &sampleRate, &frames, nullptr);
+    if (!pcm) return false;
+
+    const auto n = static_cast<int>(std::min<drwav_uint64>(frames,
+                       static_cast<drwav_uint64>(maxSeconds * sampleRate)));
+    out.name       = path.filename().string();
+    out.sampleRate = static_cast<double>(sampleRate);
+    out.audio.resize(2, n);
+    for (int c = 0; c < 2; ++c) {
+        const unsigned int src = std::min<unsigned int>(c, channels - 1);
+        float* dst = out.audio.getWritePointer(c);
+        for (int i = 0; i < n; ++i)
+            dst[i] = pcm[static_cast<std::size_t>(i) * channels + src];
+    }
+    drwav_free(pcm, nullptr);
+    return true;
+}
+
+InputResult run(EffectEngine& engine, const Input& input, const Options& opt) {
+    const int bs = opt.blockSize;
+    const int n  = input.audio.numSamples();
+    AudioBuffer in(2, bs), out(2, bs);
+
+    InputResult r;
+    r.name       = input.name;
+    r.sampleRate = input.sampleRate;
+    r.seconds    = n / input.sampleRate;
+    const double deadlineUs = bs * 1e6 / input.sampleRate;
+
+    std::vector<double> passSeconds;
+    std::vector<double> blockUs;
+    blockUs.reserve(static_cast<std::size_t>(n / bs + 1) * opt.passes);
+    for (int p = 0; p < opt.passes; ++p) {
+        double total = 0.0;
+        for (int pos = 0; pos < n; pos += bs) {
+            const int len = std::min(bs, n - pos);
+            for (int c = 0; c < 2; ++c)
+                std::memcpy(in.getWritePointer(c), input.audio.getReadPointer(c) + pos, len * sizeof(float));
+            AudioBufferView inView = in.view(), outView = out.view();
+            inView.numSamples = outView.numSamples = len;
+
+            auto t0 = std::chrono::steady_clock::now();
+            engine.processBlock(inView, outView, len);
+            auto t1 = std::chrono::steady_clock::now();
+
+            const double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+            total += us * 1e-6;
+            if (p > 0 || opt.passes == 1)  // first pass doubles as warm-up
+                blockUs.push_back(us);
+        }
+        passSeconds.push_back(total);
+    }
+    std::nth_element(passSeconds.begin(), passSeconds.begin() + passSeconds.size() / 2, passSeconds.end());
+    r.rtf           = passSeconds[passSeconds.size() / 2] / r.seconds;
+
+    auto p99 = blockUs.begin() + static_cast<std::ptrdiff_t>(blockUs.size() * 99 / 100);
+    std::nth_element(blockUs.begin(), p99, blockUs.end());
+    r.p99BlockPct   = 100.0 * *p99 / deadlineUs;
+    r.worstBlockUs  = *std::max_element(blockUs.begin(), blockUs.end());
+    r.worstBlockPct = 100.0 * r.worstBlockUs / deadlineUs;
+    return r;
+}
+
+// Returns the number of budget violations.
+int checkBudgets(json& budgets, const json& results, bool record) {
+    const double defaultPct = budgets.value("regression_pct", 10.0);
+    const double maxRtf     = budgets.value("max_rtf", 0.0);
+    const double maxWorst   = budgets.value("max_worst_block_pct", 0.0);
+    int failures = 0;
+
+    for (const auto& r : results) {
+        const std::string name = r["preset"];
+        const double rtf   = r["rtf"];
+        const double worst = r["worst_block_pct"];
+        json& entry = budgets["presets"][name];
+
+        if (maxRtf > 0.0 && rtf > maxRtf) {
+            std::fprintf(stderr, "FAIL %-28s rtf %.4f over budget %.4f\n", name.c_str(), rtf, maxRtf);
+            ++failures;
+        }
+        if (maxWorst > 0.0 && worst > maxWorst) {
+            std::fprintf(stderr, "FAIL %-28s worst block %.1f%% over budget %.1f%%\n",
+                         name.c_str(), worst, maxWorst);
+            ++failures;
+        }
+        if (!entry.contains("rtf") && !record) {
+            std::fprintf(stderr, "FAIL %-28s no baseline (record one with --record)\n", name.c_str());
+            ++failures;
+        } else if (!record) {
+            const double base = entry["rtf"];
+            const double pct  = entry.value("regression_pct", defaultPct);
+            const double diff = base > 0.0 ? 100.0 * (rtf - base) / base : 0.0;
+            if (diff > pct) {
+                std::fprintf(stderr, "FAIL %-28s rtf %.4f vs baseline %.4f (%+.1f%%, allowed %.1f%%)\n",
+                             name.c_str(), rtf, base, diff, pct);
+                ++failures;
+            }
+        }
+        if (record) entry["rtf"] = rtf;
+    }
+    return failures;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    spdlog::set_level(spdlog::level::warn);  // one engine per preset and input
+
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--presets") == 0 && i + 1 < argc)
+            opt.presetsDir = argv[++i];
+        else if (std::strcmp(argv[i], "--audio") == 0 && i + 1 < argc)
+            opt.audioDir = argv[++i];
+        else if (std::strcmp(argv[i], "--block") == 0 && i + 1 < argc)
+            opt.blockSize = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+            opt.maxSeconds = std::max(0.1, std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--passes") == 0 && i + 1 < argc)
+            opt.passes = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            opt.filter = argv[++i];
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            opt.outPath = argv[++i];
+        else if (std::strcmp(argv[i], "--budgets") == 0 && i + 1 < argc)
+            opt.budgetsPath = argv[++i];
+        else if (std::strcmp(argv[i], "--record") == 0)
+            opt.record = true;
+        else if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // ── Inputs ───────────────────────────────────────────────────────────────
+    std::vector<Input> inputs;
+    if (fs::is_directory(opt.audioDir)) {
+        std::vector<fs::path> wavs;
+        for (const auto& e : fs::directory_iterator(opt.audioDir))
+            if (e.path().extension() == ".wav") wavs.push_back(e.path());
+        std::sort(wavs.begin(), wavs.end());
+        for (const auto& p : wavs) {
+            Input in;
+            if (loadWav(p, opt.maxSeconds, in)) inputs.push_back(std::move(in));
+            else std::cerr << "Skipping unreadable " << p.string() << "\n";
+        }
+    }
+    const double synthSeconds = std::min(opt.maxSeconds, 10.0);
+    for (double sr : { 48000.0, 96000.0 }) {
+        Input in;
+        in.name       = "synthetic_guitar_" + std::to_string(static_cast<int>(sr / 1000)) + "k";
+        in.sampleRate = sr;
+        in.audio      = bench::makeGuitarSignal(sr, synthSeconds, 2);
+        inputs.push_back(std::move(in));
+    }
+
+    std::vector<fs::path> presets;
+    if (fs::is_directory(opt.presetsDir))
+        for (const auto& e : fs::directory_iterator(opt.presetsDir))
+            if (e.path().extension() == ".json") presets.push_back(e.path());
+    std::sort(presets.begin(), presets.end());
+    if (presets.empty()) {
+        std::cerr << "No presets in " << opt.presetsDir << "\n";
+        return 1;
+    }
+
+    // ── Render ───────────────────────────────────────────────────────────────
+    json results = json::array();
+    for (const auto& presetPath : presets) {
+        const std::string name = presetPath.stem().string();
+        if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) continue;
+
+        double totalTime = 0.0, totalAudio = 0.0, worstPct = 0.0, worstUs = 0.0, p99Pct = 0.0;
+        json perInput = json::array();
+        for (const auto& input : inputs) {
+            EffectEngine engine;
+            engine.prepare(input.sampleRate, opt.blockSize);
+            if (!engine.loadPreset(presetPath.string())) {
+                std::cerr << "Cannot load preset " << presetPath.string() << "\n";
+                return 1;
+            }
+            InputResult r = run(engine, input, opt);
+            totalTime  += r.rtf * r.seconds;
+            totalAudio += r.seconds;
+            worstPct = std::max(worstPct, r.worstBlockPct);
+            worstUs  = std::max(worstUs, r.worstBlockUs);
+            p99Pct   = std::max(p99Pct, r.p99BlockPct);
+            perInput.push_back({
+                { "input",           r.name },
+                { "sample_rate",     r.sampleRate },
+                { "seconds",         r.seconds },
+                { "rtf",             r.rtf },
+                { "worst_block_us",  r.worstBlockUs },
+                { "worst_block_pct", r.worstBlockPct },
+                { "p99_block_pct",   r.p99BlockPct },
+            });
+        }
+
+        const double rtf = totalTime / totalAudio;
+        std::fprintf(stderr, "%-28s rtf %.4f  worst block %7.1f us (%5.1f%% of deadline, p99 %4.1f%%)\n",
+                     name.c_str(), rtf, worstUs, worstPct, p99Pct);
+        results.push_back({
+            { "preset",          name },
+            { "rtf",             rtf },
+            { "worst_block_us",  worstUs },
+            { "worst_block_pct", worstPct },
+            { "p99_block_pct",   p99Pct },
+            { "inputs",          perInput },
+        });
+    }
+
+    json doc = {
+        { "schema",     1 },
+        { "tool",       "gearboxfx_preset_bench" },
+        { "compiler",   bench::compilerId() },
+        { "config",     bench::buildConfig() },
+        { "block_size", opt.blockSize },
+        { "passes",     opt.passes },
+        { "results",    results },
+    };
+    if (!opt.outPath.empty()) {
+        std::ofstream f(opt.outPath);
+        if (!f) {
+            std::cerr << "Cannot write " << opt.outPath << "\n";
+            return 1;
+        }
+        f << doc.dump(2) << "\n";
+    }
+
+    // ── Budgets ──────────────────────────────────────────────────────────────
+    if (opt.budgetsPath.empty()) return 0;
+
+    json budgets = json::object();
+    {
+        std::ifstream f(opt.budgetsPath);
+        if (f) budgets = json::parse(f, nullptr, false);
+        if (budgets.is_discarded()) {
+            std::cerr << "Invalid budget file: " << opt.budgetsPath << "\n";
+            return 1;
+        }
+    }
+
+    int failures = checkBudgets(budgets, results, opt.record);
+    if (opt.record) {
+        std::ofstream f(opt.budgetsPath);
+        f << budgets.dump(2) << "\n";
+        std::cerr << "Recorded baselines in " << opt.budgetsPath << "\n";
+    }
+    if (failures > 0) {
+        std::cerr << failures << " budget check(s) failed\n";
+        return 2;
+    }
+    std::cerr << "All presets within budget\n";
+    return 0;
+}
@@ -0,0 +1,196 @@
+// gearboxfx_rt_sim: real-time behaviour without audio hardware.
+//
+// Runs presets through SimulatedAudioIO: a timer thread calls the engine
+// once per block period, optionally with wake-up jitter and CPU-hogging
+// contention threads, and counts deadline misses, underruns, wake-up
+// jitter and round-trip latency. Time here is wall-clock time, so a run
+// of --seconds 5 takes five seconds per preset.
+//
+// With --switch-every, all selected presets play in one run instead, and
+// the main thread loads the next one every S seconds under the chain lock,
+// as the GUI does; the blocks silenced meanwhile show up as lock skips.
+
+#include "BenchSignals.h"
+#include "BenchUtil.h"
+#include "SimulatedAudioIO.h"
+#include "EffectEngine.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gearboxfx;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Options {
+    std::string presetsDir = GEARBOX_BENCH_DATA_DIR "/presets";
+    std::string filter;
+    double      seconds     = 5.0;
+    double      switchEvery = 0.0;
+    int         blockSize   = 256;
+    uint32_t    sampleRate  = 48000;
+    bool        failOnMiss  = false;
+    SimRtConfig sim;
+};
+
+void printUsage(const char* prog) {
+    std::cout <<
+        "Usage: " << prog << " [options]\n"
+        "\n"
+        "Options:\n"
+        "  --presets <dir>       Preset directory (default: <repo>/presets)\n"
+        "  --filter <text>       Only presets whose file name contains <text>\n"
+        "  --seconds <s>         Run time per preset (default: 5)\n"
+        "  --block <size>        Block size in frames (default: 256)\n"
+        "  --rate <hz>           Sample rate (default: 48000)\n"
+        "  --periods <n>         Device buffers, >= 2 (default: 2)\n"
+        "  --jitter-us <us>      Random wake-up delay, up to <us> (default: 0)\n"
+        "  --contention <n>      CPU-hogging threads (default: 0)\n"
+        "  --duty <0..1>         Share of each ms they spin (default: 1)\n"
+        "  --rt                  Run the audio thread SCHED_FIFO (Linux, needs rights)\n"
+        "  --switch-every <s>    One run over all presets, switching every <s> seconds\n"
+        "  --fail-on-miss        Exit 2 if any block missed its deadline\n"
+        "  --help                Show this help\n";
+}
+
+// Loops the synthetic guitar; no allocation on the audio thread.
+SimulatedAudioIO::InputGenerator loopInput(const AudioBuffer& guitar) {
+    return [&guitar](AudioBufferView in, std::uint64_t frame) {
+        const int len = guitar.numSamples();
+        for (int c = 0; c < in.numChannels; ++c) {
+            const float* g = guitar.getReadPointer(std::min(c, guitar.numChannels() - 1));
+            for (int s = 0; s < in.numSamples; ++s)
+                in[c][s] = g[(frame + s) % len];
+        }
+    };
+}
+
+AudioFormat formatFor(const Options& opt) {
+    AudioFormat fmt;
+    fmt.sampleRate  = opt.sampleRate;
+    fmt.numChannels = 2;
+    fmt.bufferSize  = static_cast<uint32_t>(opt.blockSize);
+    return fmt;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    spdlog::set_level(spdlog::level::warn);
+
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--presets") == 0 && i + 1 < argc)
+            opt.presetsDir = argv[++i];
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            opt.filter = argv[++i];
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+            opt.seconds = std::max(0.1, std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--block") == 0 && i + 1 < argc)
+            opt.blockSize = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc)
+            opt.sampleRate = static_cast<uint32_t>(std::max(8000, std::atoi(argv[++i])));
+        else if (std::strcmp(argv[i], "--periods") == 0 && i + 1 < argc)
+            opt.sim.periods = std::max(2, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--jitter-us") == 0 && i + 1 < argc)
+            opt.sim.jitterUs = std::max(0.0, std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--contention") == 0 && i + 1 < argc)
+            opt.sim.contentionThreads = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--duty") == 0 && i + 1 < argc)
+            opt.sim.contentionDuty = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--rt") == 0)
+            opt.sim.realtimePriority = true;
+        else if (std::strcmp(argv[i], "--switch-every") == 0 && i + 1 < argc)
+            opt.switchEvery = std::max(0.05, std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--fail-on-miss") == 0)
+            opt.failOnMiss = true;
+        else if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<fs::path> presets;
+    if (fs::is_directory(opt.presetsDir))
+        for (const auto& e : fs::directory_iterator(opt.presetsDir))
+            if (e.path().extension() == ".json" &&
+                (opt.filter.empty() || e.path().filename().string().find(opt.filter) != std::string::npos))
+                presets.push_back(e.path());
+    std::sort(presets.begin(), presets.end());
+    if (presets.empty()) {
+        std::cerr << "No presets in " << opt.presetsDir << "\n";
+        return 1;
+    }
+
+    const AudioBuffer guitar = bench::makeGuitarSignal(opt.sampleRate, 10.0, 2);
+    std::cout << "gearboxfx_rt_sim  " << bench::compilerId() << ", " << bench::buildConfig()
+              << "  |  " << opt.sampleRate << " Hz, block " << opt.blockSize
+              << ", periods " << opt.sim.periods << ", jitter " << opt.sim.jitterUs << " us, "
+              << opt.sim.contentionThreads << " contention thread(s)\n\n";
+
+    std::uint64_t misses = 0;
+
+    if (opt.switchEvery > 0.0) {
+        EffectEngine engine;
+        SimRtConfig cfg = opt.sim;
+        cfg.durationSeconds = opt.switchEvery * static_cast<double>(presets.size());
+        SimulatedAudioIO io(engine, cfg);
+        if (!io.open(formatFor(opt))) return 1;
+        engine.loadPreset(presets[0].string());
+        io.setInputGenerator(loopInput(guitar));
+
+        std::thread audio([&] { io.start(); });
+        while (!io.isRunning()) std::this_thread::yield();
+        for (size_t p = 1; p < presets.size() && io.isRunning(); ++p) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(opt.switchEvery));
+            auto t0   = std::chrono::steady_clock::now();
+            auto lock = io.lockChain();
+            engine.loadPreset(presets[p].string());
+            auto held = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0);
+            std::cout << "switch to " << presets[p].stem().string() << ": chain locked "
+                      << static_cast<long long>(held.count()) << " us\n";
+        }
+        audio.join();
+
+        SimulatedAudioIO::Report rep = io.report();
+        std::cout << "\n" << rep.format() << "\n";
+        std::cout << "callbacks: " << io.stats().snapshot().format() << "\n";
+        misses = rep.deadlineMisses;
+    } else {
+        for (const auto& path : presets) {
+            EffectEngine engine;
+            SimRtConfig cfg = opt.sim;
+            cfg.durationSeconds = opt.seconds;
+            SimulatedAudioIO io(engine, cfg);
+            if (!io.open(formatFor(opt))) return 1;
+            if (!engine.loadPreset(path.string())) {
+                std::cerr << "Cannot load preset " << path.string() << "\n";
+                return 1;
+            }
+            io.setInputGenerator(loopInput(guitar));
+            io.start();
+
+            SimulatedAudioIO::Report rep = io.report();
+            std::cout << path.stem().string() << "\n  " << rep.format() << "\n";
+            misses += rep.deadlineMisses;
+        }
+    }
+
+    if (opt.failOnMiss && misses > 0) {
+        std::cout << "\nFAIL: " << misses << " deadline miss(es)\n";
+        return 2;
+    }
+    return 0;
+}
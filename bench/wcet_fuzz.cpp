@@ -0,0 +1,348 @@
+// gearboxfx_wcet: worst-case execution time search for the audio path.
+//
+// Each iteration builds a random chain from the registry (1-6 nodes, repeats
+// allowed) with random parameters, a quarter of them pinned to their min or
+// max, and drives EffectEngine::processBlock with one pathological input:
+// silence then a full-scale square, full-scale noise, full-scale DC,
+// subnormal-range noise, a loud burst decaying into silence, or the
+// synthetic guitar. Between blocks, parameters are automated at random
+// through EffectEngine::setParam and nodes are occasionally bypassed.
+//
+// Per-node times come from the chain's profiler (one record per block), the
+// whole-block time from a clock around processBlock. The report lists the
+// worst block per node type and the worst chains, each with what triggered
+// it: iteration, input, block index and the parameter values at that moment.
+// The same --seed always produces the same iterations, and --iteration <k>
+// replays one of them.
+
+#include "BenchSignals.h"
+#include "BenchUtil.h"
+#include "EffectEngine.h"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gearboxfx;
+using json = nlohmann::json;
+
+namespace {
+
+enum class Input { SilenceToFullScale, FullScaleNoise, Dc, Subnormal, BurstToSilence, Guitar, kCount };
+
+const char* inputName(Input i) {
+    switch (i) {
+        case Input::SilenceToFullScale: return "silence_to_fullscale";
+        case Input::FullScaleNoise:     return "fullscale_noise";
+        case Input::Dc:                 return "dc";
+        case Input::Subnormal:          return "subnormal";
+        case Input::BurstToSilence:     return "burst_to_silence";
+        case Input::Guitar:             return "guitar";
+        default:                        return "?";
+    }
+}
+
+struct Options {
+    unsigned    seed       = 1;
+    int         iterations = 200;
+    int         only       = -1;   // --iteration
+    int         blocks     = 300;
+    int         blockSize  = 256;
+    double      sampleRate = 48000.0;
+    int         warmup     = 4;    // blocks after a chain change left out of the maxima
+    int         topChains  = 10;
+    std::string outPath;
+};
+
+struct Trigger {
+    double      ns = 0.0;
+    int         iteration = -1;
+    std::string input;
+    int         block = -1;
+    json        chain;             // [{type, enabled, params}], at that block
+};
+
+void printUsage(const char* prog) {
+    std::cout <<
+        "Usage: " << prog << " [options]\n"
+        "\n"
+        "Options:\n"
+        "  --seed <n>          Random seed (default: 1)\n"
+        "  --iterations <n>    Random chains to try (default: 200)\n"
+        "  --iteration <k>     Replay only iteration k of this seed\n"
+        "  --blocks <n>        Blocks per iteration (default: 300)\n"
+        "  --block <size>      Block size in frames (default: 256)\n"
+        "  --rate <hz>         Sample rate (default: 48000)\n"
+        "  --warmup <n>        Blocks after a chain change excluded (default: 4)\n"
+        "  --out <path>        Write the WCET table as JSON\n"
+        "  --help              Show this help\n";
+}
+
+float randomValue(const ParamDef& def, std::mt19937& rng) {
+    std::uniform_real_distribution<float> u(0.0f, 1.0f);
+    const float r = u(rng);
+    if (r < 0.125f) return def.minValue;
+    if (r < 0.25f)  return def.maxValue;
+    return def.minValue + u(rng) * (def.maxValue - def.minValue);
+}
+
+// Fill one block of the input, channel 0 (copied to channel 1 by the caller).
+void fillInput(Input kind, float* x, int n, int block, int numBlocks, long long& t,
+               const AudioBuffer& guitar, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    switch (kind) {
+        case Input::SilenceToFullScale:
+            for (int i = 0; i < n; ++i, ++t)
+                x[i] = (block < numBlocks / 2) ? 0.0f : (((t / 218) & 1) ? 1.0f : -1.0f);  // ~110 Hz square
+            break;
+        case Input::FullScaleNoise:
+            for (int i = 0; i < n; ++i) x[i] = noise(rng);
+            break;
+        case Input::Dc:
+            std::fill(x, x + n, 1.0f);
+            break;
+        case Input::Subnormal:
+            for (int i = 0; i < n; ++i) x[i] = noise(rng) * 1e-39f;
+            break;
+        case Input::BurstToSilence:
+            for (int i = 0; i < n; ++i) x[i] = (block < 8) ? noise(rng) : 0.0f;
+            break;
+        case Input::Guitar: {
+            const float* g = guitar.getReadPointer(0);
+            for (int i = 0; i < n; ++i, ++t) x[i] = g[t % guitar.numSamples()];
+            break;
+        }
+        default:
+            std::fill(x, x + n, 0.0f);
+    }
+}
+
+json describeChain(const EffectChain& chain) {
+    json out = json::array();
+    for (const auto& node : chain.nodes())
+        out.push_back({ { "type", node->typeId() }, { "enabled", node->isEnabled() },
+                        { "params", node->saveParams() } });
+    return out;
+}
+
+json triggerJson(const Trigger& t, double deadlineNs, int blockSize) {
+    return {
+        { "worst_us",      t.ns * 1e-3 },
+        { "deadline_pct",  100.0 * t.ns / deadlineNs },
+        { "ns_per_sample", t.ns / blockSize },
+        { "iteration",     t.iteration },
+        { "input",         t.input },
+        { "block",         t.block },
+        { "chain",         t.chain },
+    };
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    spdlog::set_level(spdlog::level::warn);
+
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            opt.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            opt.iterations = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--iteration") == 0 && i + 1 < argc)
+            opt.only = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--blocks") == 0 && i + 1 < argc)
+            opt.blocks = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--block") == 0 && i + 1 < argc)
+            opt.blockSize = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc)
+            opt.sampleRate = std::max(8000.0, std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+            opt.warmup = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            opt.outPath = argv[++i];
+        else if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    EffectEngine engine;
+    engine.prepare(opt.sampleRate, opt.blockSize);
+    engine.tuner().setEnabled(false);  // its analysis thread would only add scheduling noise
+    engine.tuner().stop();
+    ChainProfiler& prof = engine.chain().profiler();
+    if (!ChainProfiler::kCompiledIn)
+        std::cerr << "Built without GEARBOX_PROFILER: per-node times unavailable\n";
+    prof.setEnabled(true);
+
+    std::vector<std::string> types = engine.registry().registeredTypes();
+    std::sort(types.begin(), types.end());
+
+    const AudioBuffer guitar = bench::makeGuitarSignal(opt.sampleRate, 4.0, 1);
+    const double deadlineNs  = opt.blockSize * 1e9 / opt.sampleRate;
+    const int bs = opt.blockSize;
+    AudioBuffer in(2, bs), out(2, bs);
+
+    std::map<std::string, Trigger> worstNode;  // by type
+    std::vector<Trigger>           worstChains;
+    long long totalBlocks = 0, missed = 0;
+
+    const int first = opt.only >= 0 ? opt.only : 0;
+    const int last  = opt.only >= 0 ? opt.only + 1 : opt.iterations;
+    for (int it = first; it < last; ++it) {
+        std::mt19937 rng(opt.seed * 1000003u + static_cast<unsigned>(it));
+        std::uniform_int_distribution<int> pickType(0, static_cast<int>(types.size()) - 1);
+        std::uniform_real_distribution<float> u(0.0f, 1.0f);
+
+        // ── Random chain ────────────────────────────────────────────────────
+        engine.chain().clear();
+        const int numNodes = std::uniform_int_distribution<int>(1, 6)(rng);
+        for (int k = 0; k < numNodes; ++k) {
+            auto node = engine.registry().create(types[pickType(rng)]);
+            node->setId("n" + std::to_string(k));
+            std::vector<std::string> names;
+            for (const auto& [name, def] : node->paramDefs()) names.push_back(name);
+            std::sort(names.begin(), names.end());  // map order is not portable
+            for (const auto& name : names)
+                node->setParam(name, randomValue(node->paramDefs().at(name), rng));
+            engine.chain().addNode(std::move(node));
+        }
+        engine.parameterManager().syncFromChain();
+
+        const Input kind = static_cast<Input>(
+            std::uniform_int_distribution<int>(0, static_cast<int>(Input::kCount) - 1)(rng));
+
+        ChainProfiler::BlockRecord rec;
+        while (prof.pop(rec)) {}  // drop anything left from the last chain
+
+        long long t = 0;
+        for (int b = 0; b < opt.blocks; ++b) {
+            // ── Automation ──────────────────────────────────────────────────
+            if (u(rng) < 0.25f) {
+                const auto& nodes = engine.chain().nodes();
+                auto& node = nodes[std::uniform_int_distribution<size_t>(0, nodes.size() - 1)(rng)];
+                std::vector<std::string> names;
+                for (const auto& [name, def] : node->paramDefs()) names.push_back(name);
+                std::sort(names.begin(), names.end());
+                if (!names.empty()) {
+                    const auto& name = names[std::uniform_int_distribution<size_t>(0, names.size() - 1)(rng)];
+                    engine.setParam(node->id() + "." + name, randomValue(node->paramDefs().at(name), rng));
+                }
+            }
+            if (u(rng) < 0.02f) {
+                const auto& nodes = engine.chain().nodes();
+                auto& node = nodes[std::uniform_int_distribution<size_t>(0, nodes.size() - 1)(rng)];
+                node->setEnabled(!node->isEnabled());
+            }
+
+            fillInput(kind, in.getWritePointer(0), bs, b, opt.blocks, t, guitar, rng);
+            std::memcpy(in.getWritePointer(1), in.getReadPointer(0), bs * sizeof(float));
+
+            auto t0 = std::chrono::steady_clock::now();
+            engine.processBlock(in.view(), out.view(), bs);
+            auto t1 = std::chrono::steady_clock::now();
+            const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+
+            const bool haveNodes = prof.pop(rec);
+            if (b < opt.warmup) continue;
+
+            ++totalBlocks;
+            if (ns > deadlineNs) ++missed;
+
+            json chainNow;  // built only when a maximum moves
+            auto snapshot = [&]() -> const json& {
+                if (chainNow.is_null()) chainNow = describeChain(engine.chain());
+                return chainNow;
+            };
+
+            if (haveNodes) {
+                for (int k = 0; k < rec.numNodes; ++k) {
+                    const std::string& type = engine.chain().nodes()[k]->typeId();
+                    Trigger& w = worstNode[type];
+                    if (rec.ns[k] <= w.ns) continue;
+                    w = { static_cast<double>(rec.ns[k]), it, inputName(kind), b, json::array() };
+                    w.chain = snapshot()[k];
+                }
+            }
+
+            if (static_cast<int>(worstChains.size()) < opt.topChains || ns > worstChains.back().ns) {
+                // One entry per iteration: its worst block
+                auto same = std::find_if(worstChains.begin(), worstChains.end(),
+                                         [&](const Trigger& c) { return c.iteration == it; });
+                if (same != worstChains.end()) {
+                    if (ns <= same->ns) continue;
+                    worstChains.erase(same);
+                }
+                worstChains.push_back({ ns, it, inputName(kind), b, snapshot() });
+                std::sort(worstChains.begin(), worstChains.end(),
+                          [](const Trigger& a, const Trigger& c) { return a.ns > c.ns; });
+                if (static_cast<int>(worstChains.size()) > opt.topChains) worstChains.pop_back();
+            }
+        }
+    }
+
+    // ── Report ──────────────────────────────────────────────────────────────
+    std::vector<std::pair<std::string, Trigger>> byNode(worstNode.begin(), worstNode.end());
+    std::sort(byNode.begin(), byNode.end(),
+              [](const auto& a, const auto& b) { return a.second.ns > b.second.ns; });
+
+    std::fprintf(stderr, "\nWCET per node type (%d-frame blocks @ %g Hz, deadline %.0f us)\n",
+                 bs, opt.sampleRate, deadlineNs * 1e-3);
+    std::fprintf(stderr, "%-28s %10s %8s %10s   %s\n", "type", "worst us", "% dl", "ns/sample", "trigger");
+    for (const auto& [type, w] : byNode)
+        std::fprintf(stderr, "%-28s %10.1f %7.1f%% %10.1f   iteration %d, %s, block %d\n",
+                     type.c_str(), w.ns * 1e-3, 100.0 * w.ns / deadlineNs, w.ns / bs,
+                     w.iteration, w.input.c_str(), w.block);
+
+    std::fprintf(stderr, "\nWorst chains\n");
+    for (const auto& c : worstChains) {
+        std::string desc;
+        for (const auto& n : c.chain) desc += (desc.empty() ? "" : " > ") + n["type"].get<std::string>();
+        std::fprintf(stderr, "%10.1f us %7.1f%%   iteration %d, %s, block %d: %s\n",
+                     c.ns * 1e-3, 100.0 * c.ns / deadlineNs, c.iteration, c.input.c_str(), c.block, desc.c_str());
+    }
+    std::fprintf(stderr, "\n%lld blocks, %lld over the deadline\n", totalBlocks, missed);
+
+    if (!opt.outPath.empty()) {
+        json nodes = json::object(), chains = json::array();
+        for (const auto& [type, w] : worstNode) nodes[type] = triggerJson(w, deadlineNs, bs);
+        for (const auto& c : worstChains)       chains.push_back(triggerJson(c, deadlineNs, bs));
+        json doc = {
+            { "schema",      1 },
+            { "tool",        "gearboxfx_wcet" },
+            { "compiler",    bench::compilerId() },
+            { "config",      bench::buildConfig() },
+            { "seed",        opt.seed },
+            { "iterations",  opt.iterations },
+            { "blocks",      opt.blocks },
+            { "block_size",  bs },
+            { "sample_rate", opt.sampleRate },
+            { "deadline_us", deadlineNs * 1e-3 },
+            { "blocks_measured", totalBlocks },
+            { "deadline_misses", missed },
+            { "nodes",       nodes },
+            { "chains",      chains },
+        };
+        std::ofstream f(opt.outPath);
+        if (!f) {
+            std::cerr << "Cannot write " << opt.outPath << "\n";
+            return 1;
+        }
+        f << doc.dump(2) << "\n";
+    }
+    return 0;
+}
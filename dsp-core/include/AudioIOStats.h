@@ -0,0 +1,113 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace gearboxfx {
+
+// Health counters for an audio device callback, to tell a click's cause
+// apart: a DSP overrun (the callback ran past the block period), a block
+// skipped because the chain was locked, or the driver (underflow/overflow
+// flags, late callbacks).
+// Audio side: callbackBegin()/callbackEnd() around the callback plus the
+// note*() calls; every update is one relaxed atomic, no locks, no waits.
+// Reader side: snapshot() from any thread. Two snapshots subtract, which is
+// how periodic dumps report just their interval.
+// Histograms are log-linear in nanoseconds: four buckets per octave from
+// 1 us (bucket 0 also takes anything shorter) to ~1 s (last bucket takes
+// anything longer).
+class AudioIOStats {
+public:
+    static constexpr int    kOctaves          = 20;
+    static constexpr int    kBucketsPerOctave = 4;
+    static constexpr int    kBuckets          = kOctaves * kBucketsPerOctave;
+    static constexpr int    kMinOctave        = 10;   // 2^10 ns ~ 1 us
+    static constexpr double kLateFactor       = 1.5;  // interval over 1.5 periods is late
+
+    struct Histogram {
+        std::uint64_t count[kBuckets] = {};
+        std::uint64_t total() const;
+        // Upper edge of the bucket holding the p-th percentile (0..100), us.
+        double percentileUs(double p) const;
+        static double bucketUpperUs(int bucket);
+    };
+
+    struct Snapshot {
+        std::uint64_t callbacks     = 0;
+        std::uint64_t overruns      = 0;  // callback took longer than the period
+        std::uint64_t late          = 0;  // interval over kLateFactor periods
+        std::uint64_t underflows    = 0;  // driver-reported (input or output)
+        std::uint64_t overflows     = 0;
+        std::uint64_t lockSkips     = 0;  // block output as silence, chain was locked
+        double        periodUs      = 0.0;
+        double        maxDurationUs = 0.0;  // since reset(), not subtracted
+        double        maxIntervalUs = 0.0;
+        Histogram     duration, interval;
+
+        std::uint64_t xruns() const { return overruns + underflows + overflows + lockSkips; }
+        Snapshot operator-(const Snapshot& earlier) const;
+        std::string format() const;  // one line
+    };
+
+    // Before the stream starts (not concurrently with the audio side).
+    void setPeriod(double sampleRate, int blockSize);
+
+    // ── Audio thread ─────────────────────────────────────────────────────────
+    std::int64_t callbackBegin() {
+        const std::int64_t t = now();
+        if (m_lastBegin != 0) {
+            const std::int64_t dt = t - m_lastBegin;
+            add(m_interval, dt);
+            raise(m_maxIntervalNs, dt);
+            if (dt > m_lateNs.load(std::memory_order_relaxed)) bump(m_late);
+        }
+        m_lastBegin = t;
+        return t;
+    }
+    void callbackEnd(std::int64_t beginNs) {
+        const std::int64_t dt = now() - beginNs;
+        add(m_duration, dt);
+        raise(m_maxDurationNs, dt);
+        if (dt > m_periodNs.load(std::memory_order_relaxed)) bump(m_overruns);
+        bump(m_callbacks);
+    }
+    void noteUnderflow() { bump(m_underflows); }
+    void noteOverflow()  { bump(m_overflows); }
+    void noteLockSkip()  { bump(m_lockSkips); }
+
+    // ── Any thread ───────────────────────────────────────────────────────────
+    Snapshot snapshot() const;
+    // Counts landing while this runs may survive or be lost.
+    void     reset();
+
+    static int bucketFor(std::int64_t ns);
+
+private:
+    using Counter = std::atomic<std::uint64_t>;
+
+    static std::int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    // Single writer: load + store instead of a locked read-modify-write.
+    static void bump(Counter& c) {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    static void add(Counter (&h)[kBuckets], std::int64_t ns) { bump(h[bucketFor(ns)]); }
+    static void raise(std::atomic<std::int64_t>& m, std::int64_t v) {
+        if (v > m.load(std::memory_order_relaxed)) m.store(v, std::memory_order_relaxed);
+    }
+
+    std::atomic<std::int64_t> m_periodNs{INT64_MAX};
+    std::atomic<std::int64_t> m_lateNs{INT64_MAX};
+    std::int64_t              m_lastBegin = 0;  // audio thread only
+
+    Counter m_callbacks{0}, m_overruns{0}, m_late{0};
+    Counter m_underflows{0}, m_overflows{0}, m_lockSkips{0};
+    std::atomic<std::int64_t> m_maxDurationNs{0}, m_maxIntervalNs{0};
+    Counter m_duration[kBuckets] = {};
+    Counter m_interval[kBuckets] = {};
+};
+
+} // namespace gearboxfx
@@ -0,0 +1,180 @@
+#pragma once
+#include "PerfCounters.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef GEARBOX_PROFILER
+#define GEARBOX_PROFILER 0
+#endif
+
+namespace gearboxfx {
+
+class EffectChain;
+class EffectNode;
+
+// Per-node timing for EffectChain::process (compiled in with the
+// GEARBOX_PROFILER CMake option).
+// Audio side: the chain timestamps each node with steady_clock and pushes one
+// record per block into an SPSC ring; when disabled, the chain takes a single
+// branch per block and runs its uninstrumented loop.
+// Reader side: collect() drains the ring into rolling windows (last
+// kWindowBlocks blocks) from which report() derives min/mean/p99/max per
+// node, each node's share of the chain time and the DSP load (chain time
+// over the block's real-time deadline). collect() and report() belong to
+// one non-audio thread.
+// Nodes are keyed by address, so the chain calls chainChanged() whenever it
+// drops or replaces nodes: blocks recorded before that are ignored and the
+// per-node windows start over, and a new node that reuses a freed address
+// never inherits another node's history.
+// Hardware counters (Linux): with setHardwareCounters(true) the chain also
+// reads a perf_event group (PerfCounters) after every node, and report()
+// sums them per node type into IPC and misses per sample. The group is
+// opened on the first such block, from the thread running the chain, since
+// perf counts per thread. Each read is a syscall (~1 us), which the wall
+// times then include.
+class ChainProfiler {
+public:
+    static constexpr bool kCompiledIn  = GEARBOX_PROFILER != 0;
+    static constexpr int  kMaxNodes    = 32;
+    static constexpr int  kWindowBlocks = 4096;
+
+    struct Stats {
+        double min = 0.0, mean = 0.0, p99 = 0.0, max = 0.0;  // us, or % for loadPercent
+        int    count = 0;
+    };
+
+    struct NodeReport {
+        std::string id, typeId;
+        Stats       time;
+        double      share = 0.0;  // of the summed node means, 0..1
+    };
+
+    // Hardware counters summed over every node of one type.
+    struct TypeCounters {
+        std::string   typeId;
+        std::uint64_t samples = 0;  // frames processed, over all instances
+        std::uint64_t value[PerfCounters::kNumCounters] = {};
+        double ipc() const;
+        double perSample(PerfCounters::Counter c) const;
+    };
+
+    struct Report {
+        std::vector<NodeReport> nodes;
+        std::vector<TypeCounters> types;  // empty unless counters were read
+        bool        hasCounter[PerfCounters::kNumCounters] = {};
+        std::string counterStatus;        // why there are no counters, if so
+        Stats  chain;             // whole process() call
+        Stats  loadPercent;       // chain time / block deadline * 100
+        double deadlineUs = 0.0;  // last block
+        std::string format() const;
+    };
+
+    // One block as pushed by the audio thread.
+    struct BlockRecord {
+        int                numNodes   = 0;
+        int                numSamples = 0;
+        bool               hasHw      = false;
+        std::uint32_t      generation = 0;      // chainChanged() count at the block
+        std::uint32_t      totalNs    = 0;
+        float              deadlineNs = 0.0f;
+        const EffectNode*  node[kMaxNodes] = {};  // identity only, never dereferenced
+        std::uint32_t      ns[kMaxNodes]   = {};
+        PerfCounters::Values hw[kMaxNodes] = {};  // deltas over each node
+    };
+
+    void setEnabled(bool on) { m_enabled.store(on && kCompiledIn, std::memory_order_relaxed); }
+    bool enabled() const     { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Linux only; takes effect with the next block.
+    void setHardwareCounters(bool on) { m_hwRequested.store(on, std::memory_order_relaxed); }
+
+    // Any thread, with the chain not processing (EffectChain calls it).
+    void chainChanged() { m_generation.fetch_add(1, std::memory_order_release); }
+
+    // ── Audio thread (called by EffectChain) ─────────────────────────────────
+    void beginBlock() {
+        m_record.numNodes   = 0;
+        m_record.generation = m_generation.load(std::memory_order_acquire);
+        m_record.hasHw      = m_hwRequested.load(std::memory_order_relaxed) && beginCounters();
+        m_blockStart = m_last = now();
+    }
+    void nodeDone(const EffectNode* node) {
+        const std::int64_t t = now();
+        if (m_record.numNodes < kMaxNodes) {
+            m_record.node[m_record.numNodes] = node;
+            m_record.ns[m_record.numNodes]   = static_cast<std::uint32_t>(t - m_last);
+            if (m_record.hasHw) readCounters(m_record.hw[m_record.numNodes]);
+            ++m_record.numNodes;
+        }
+        m_last = t;
+    }
+    void endBlock(int numSamples, double sampleRate) {
+        m_record.numSamples = numSamples;
+        m_record.totalNs    = static_cast<std::uint32_t>(now() - m_blockStart);
+        m_record.deadlineNs = static_cast<float>(numSamples * 1e9 / sampleRate);
+        m_ring.push(m_record);  // dropped if the reader is behind
+    }
+
+    // ── Reader thread ────────────────────────────────────────────────────────
+    void   collect();
+    // Raw per-block access for tools that need every block (e.g. worst-case
+    // searches); use instead of collect(), not alongside it.
+    bool   pop(BlockRecord& record) { return m_ring.pop(record); }
+    Report report(const EffectChain& chain) const;
+    void   clear();
+
+    // Most recent block's load, % of its deadline (after collect()).
+    double lastLoadPercent() const { return m_lastLoad; }
+
+private:
+
+    struct NodeCounters {
+        std::uint64_t samples = 0;
+        std::uint64_t value[PerfCounters::kNumCounters] = {};
+    };
+
+    enum class HwState { Closed, Open, Failed };
+
+    bool beginCounters();                         // audio thread
+    void readCounters(PerfCounters::Values& delta);  // audio thread
+
+    struct Window {
+        std::vector<float> values;  // ring of the last kWindowBlocks values
+        int pos = 0, count = 0;
+        void  add(float v);
+        Stats stats(float scale) const;
+    };
+
+    static std::int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::atomic<bool>          m_enabled{false};
+    std::atomic<std::uint32_t> m_generation{0};
+
+    // Audio side
+    BlockRecord  m_record;
+    std::int64_t m_blockStart = 0, m_last = 0;
+    SpscQueue<BlockRecord> m_ring{256};
+
+    std::atomic<bool>    m_hwRequested{false};
+    std::atomic<HwState> m_hwState{HwState::Closed};  // error/has() valid once not Closed
+    PerfCounters         m_perf;
+    PerfCounters::Values m_hwLast = {};
+
+    // Reader side
+    std::unordered_map<const EffectNode*, Window> m_nodes;
+    std::unordered_map<const EffectNode*, NodeCounters> m_counters;
+    Window m_chain, m_load;
+    std::uint32_t m_nodesGeneration = 0;  // generation m_nodes / m_counters belong to
+    double m_deadlineUs = 0.0;
+    double m_lastLoad   = 0.0;
+};
+
+} // namespace gearboxfx
@@ -1,6 +1,7 @@
 #pragma once
 #include "EffectNode.h"
 #include "AudioBuffer.h"
+#include "ChainProfiler.h"
 #include <vector>
 #include <memory>
 #include <string>
@@ -37,7 +38,22 @@ public:
     // numSamples must be ≤ maxBlockSize passed to prepare().
     void process(AudioBufferView input, AudioBufferView output, int numSamples);
 
+    // Total latency of the enabled nodes, in samples.
+    int latencySamples() const;
+
+    // Clock handed to every node in the chain (current and future ones).
+    void setTempoClock(const TempoClock* clock);
+
+    // Per-node timing (disabled by default; see ChainProfiler).
+    ChainProfiler&       profiler()       { return m_profiler; }
+    const ChainProfiler& profiler() const { return m_profiler; }
+
 private:
+    // The node loop, instantiated with and without the profiler hooks so a
+    // disabled profiler costs one branch per block.
+    template <bool Profile>
+    void processNodes(AudioBufferView input, AudioBufferView output, int numSamples);
+
     std::vector<std::shared_ptr<EffectNode>> m_nodes;
 
     // Ping-pong buffers (owned by chain, not by nodes)
@@ -46,6 +62,10 @@ private:
 
     double m_sampleRate   = 48000.0;
     int    m_maxBlockSize = 256;
+
+    const TempoClock* m_clock = nullptr;
+
+    ChainProfiler m_profiler;
 };
 
 } // namespace gearboxfx
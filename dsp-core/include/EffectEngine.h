@@ -2,8 +2,10 @@
 #include "EffectChain.h"
 #include "ParameterManager.h"
 #include "PresetStore.h"
+#include "Tuner.h"
 #include "AudioBuffer.h"
 #include "effects/EffectNodeRegistry.h"
+#include "effects/utility/LooperNode.h"
 #include <string>
 #include <memory>
 
@@ -38,9 +40,29 @@ public:
     void               setPresetName(const std::string& n) { m_currentPreset.name = n; }
     const std::string& presetName()                  const { return m_currentPreset.name; }
 
+    // Tempo for synced modulation, clamped to [20, 300] bpm. Loaded with the
+    // preset and saved with it (GUI thread only, like the output volume).
+    void   setTempo(double bpm) {
+        m_currentPreset.bpm = TempoClock::clampBpm(bpm);
+        m_clock.bpm.store(m_currentPreset.bpm, std::memory_order_relaxed);
+    }
+    double tempo() const { return m_clock.bpm.load(std::memory_order_relaxed); }
+    const TempoClock& tempoClock() const { return m_clock; }
+
+    // Chromatic tuner on the engine input (runs on its own thread; poll from the GUI).
+    Tuner&       tuner()       { return m_tuner; }
+    const Tuner& tuner() const { return m_tuner; }
+
+    // Current chain latency in samples (oversampling filters, lookahead, ...).
+    int latencySamples() const { return m_chain.latencySamples(); }
+
     // Thread-safe parameter update (can be called from any thread).
     bool setParam(const std::string& effectId_paramName, float value);
 
+    // Transport command for every looper in the chain (one control thread).
+    // Returns false when the chain has no looper.
+    bool looperCommand(LooperCommand cmd);
+
     EffectChain&      chain()            { return m_chain; }
     ParameterManager& parameterManager() { return m_paramManager; }
     EffectNodeRegistry& registry()       { return m_registry; }
@@ -52,6 +74,8 @@ private:
     ParameterManager   m_paramManager;
     EffectNodeRegistry m_registry;
     Preset             m_currentPreset;
+    TempoClock         m_clock;
+    Tuner              m_tuner;
 
     double m_sampleRate   = 48000.0;
     int    m_maxBlockSize = 256;
@@ -1,6 +1,8 @@
 #pragma once
 #include "AudioBuffer.h"
+#include "TempoClock.h"
 #include <nlohmann/json.hpp>
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <functional>
@@ -8,6 +10,8 @@
 
 namespace gearboxfx {
 
+struct TelemetryTaps;
+
 struct ParamDef {
     float defaultValue;
     float minValue;
@@ -33,11 +37,24 @@ public:
     // Process audio. Input and output may be the same buffer (in-place).
     virtual void process(AudioBufferView input, AudioBufferView output, int numSamples) = 0;
 
+    // Processing delay introduced by this node, in samples at the chain rate.
+    virtual int latencySamples() const { return 0; }
+
+    // Shared tempo clock for synced modulation (set by the chain; may be null).
+    virtual void setTempoClock(const TempoClock* clock) { m_clock = clock; }
+
+    // Current gain reduction in dB (<= 0) for metering; any thread may read it.
+    virtual float gainReductionDb() const { return 0.0f; }
+
+    // Metering taps written around process() by the chain (see Telemetry).
+    void           setTelemetryTaps(TelemetryTaps* taps) { m_taps.store(taps, std::memory_order_release); }
+    TelemetryTaps* telemetryTaps() const                 { return m_taps.load(std::memory_order_acquire); }
+
     // ── Parameter API ────────────────────────────────────────────────────────
 
     void registerParam(const std::string& name, const ParamDef& def) {
-        m_paramDefs[name]   = def;
-        m_paramValues[name] = def.defaultValue;
+        m_paramDefs[name] = def;
+        m_paramValues[name].store(def.defaultValue, std::memory_order_relaxed);
     }
 
     // Returns false if name not found or value out of range (clamped).
@@ -45,7 +62,7 @@ public:
         auto it = m_paramDefs.find(name);
         if (it == m_paramDefs.end()) return false;
         value = std::max(it->second.minValue, std::min(it->second.maxValue, value));
-        m_paramValues[name] = value;
+        m_paramValues[name].store(value, std::memory_order_relaxed);
         onParamChanged(name, value);
         return true;
     }
@@ -53,15 +70,22 @@ public:
     float getParam(const std::string& name) const {
         auto it = m_paramValues.find(name);
         if (it == m_paramValues.end()) throw std::runtime_error("Unknown param: " + name);
-        return it->second;
+        return it->second.load(std::memory_order_relaxed);
     }
 
     bool hasParam(const std::string& name) const {
         return m_paramDefs.count(name) > 0;
     }
 
-    const std::unordered_map<std::string, ParamDef>&   paramDefs()   const { return m_paramDefs; }
-    const std::unordered_map<std::string, float>&       paramValues() const { return m_paramValues; }
+    const std::unordered_map<std::string, ParamDef>& paramDefs() const { return m_paramDefs; }
+
+    // Snapshot of every value (the live values are read by process()).
+    std::unordered_map<std::string, float> paramValues() const {
+        std::unordered_map<std::string, float> values;
+        for (const auto& [name, val] : m_paramValues)
+            values.emplace(name, val.load(std::memory_order_relaxed));
+        return values;
+    }
 
     // ── JSON round-trip ──────────────────────────────────────────────────────
 
@@ -73,10 +97,20 @@ public:
     nlohmann::json saveParams() const {
         nlohmann::json j;
         for (auto& [name, val] : m_paramValues)
-            j[name] = val;
+            j[name] = val.load(std::memory_order_relaxed);
         return j;
     }
 
+    // Non-float node data (impulse responses, model weights, ...), stored under
+    // "data" in the preset's node object. Nodes without such data ignore it.
+    virtual void loadData(const nlohmann::json& /*j*/) {}
+    virtual nlohmann::json saveData() const { return nullptr; }
+
+    // Directory that relative file paths in the data are resolved against:
+    // the preset's folder when loaded from a file, else the working directory.
+    void setDataDir(const std::string& dir) { m_dataDir = dir; }
+    const std::string& dataDir() const      { return m_dataDir; }
+
     // ── Identity ─────────────────────────────────────────────────────────────
 
     void setId(const std::string& id)     { m_id = id; }
@@ -95,12 +129,18 @@ protected:
     double m_sampleRate   = 48000.0;
     int    m_maxBlockSize = 256;
 
+    const TempoClock* m_clock = nullptr;
+
 private:
     std::string  m_id;
     std::string  m_typeId;
+    std::string  m_dataDir;
     bool         m_enabled = true;
+    std::atomic<TelemetryTaps*> m_taps{nullptr};
     std::unordered_map<std::string, ParamDef> m_paramDefs;
-    std::unordered_map<std::string, float>    m_paramValues;
+    // Set on the control thread while process() reads them; the map itself
+    // only changes in registerParam() (constructors).
+    std::unordered_map<std::string, std::atomic<float>> m_paramValues;
 };
 
 } // namespace gearboxfx
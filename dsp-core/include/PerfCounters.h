@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace gearboxfx {
+
+// Hardware performance counters for the calling thread (Linux
+// perf_event_open; elsewhere open() always fails).
+// The counters form one perf group led by cycles, so a single read() returns
+// a consistent snapshot. Events the CPU or kernel does not offer are left out
+// of the group and read as zero (see has()). Opening needs
+// /proc/sys/kernel/perf_event_paranoid <= 2 or CAP_PERFMON.
+class PerfCounters {
+public:
+    enum Counter { Cycles, Instructions, L1dMisses, LlcMisses, BranchMisses, kNumCounters };
+
+    using Values = std::uint64_t[kNumCounters];
+
+    PerfCounters() = default;
+    ~PerfCounters() { close(); }
+    PerfCounters(const PerfCounters&)            = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Counts the calling thread from now on. Returns false (see error())
+    // when not even the cycle counter can be opened.
+    bool open();
+    void close();
+
+    bool isOpen() const          { return m_leader >= 0; }
+    bool has(Counter c) const    { return m_slot[c] >= 0; }
+    const std::string& error() const { return m_error; }
+
+    // Current totals since open(). One syscall; false if the read failed.
+    bool read(Values& out) const;
+
+    static const char* name(Counter c);
+
+private:
+    int m_fd[kNumCounters]   = {-1, -1, -1, -1, -1};
+    int m_slot[kNumCounters] = {-1, -1, -1, -1, -1};  // position in the group read
+    int m_leader = -1;
+    int m_numOpen = 0;
+    std::string m_error;
+};
+
+} // namespace gearboxfx
@@ -1,5 +1,6 @@
 #pragma once
 #include "EffectChain.h"
+#include "TempoClock.h"
 #include <nlohmann/json.hpp>
 #include <string>
 #include <optional>
@@ -19,6 +20,9 @@ struct Preset {
     float midDb     = 0.0f;
     float trebleDb  = 0.0f;
     float outputVolume = 0.85f;
+
+    // Tempo for synced modulation ("bpm", [20, 300])
+    double bpm = TempoClock::kDefaultBpm;
 };
 
 class EffectNodeRegistry;
@@ -26,6 +30,7 @@ class EffectNodeRegistry;
 class PresetStore {
 public:
     // Load a preset JSON file and build the EffectChain via the registry.
+    // Relative file paths in node data resolve against the preset's folder.
     // Returns nullopt on parse error or missing required fields.
     static std::optional<Preset> loadFromFile(
         const std::string&   path,
@@ -43,6 +48,7 @@ public:
     );
 
     // Parse raw JSON string (useful for unit tests / BLE transfer).
+    // Relative file paths in node data resolve against the working directory.
     static std::optional<Preset> loadFromJson(
         const nlohmann::json& j,
         EffectChain&          chain,
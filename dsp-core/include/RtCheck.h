@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace gearboxfx {
+namespace rtcheck {
+
+// Real-time safety checker.
+// EffectEngine::processBlock marks its thread as real-time for the duration
+// of the call (RealtimeScope, a thread-local counter). When the GearBoxRtCheck
+// object library is linked into an executable, it interposes malloc/free,
+// operator new/delete, pthread mutex/rwlock/condvar waits, semaphores and
+// blocking I/O and sleep calls, and reports any of them made from a marked
+// thread. Without the hooks, marking costs two thread-local increments and
+// nothing is checked.
+//
+// The audio callbacks (FileAudioIO, GuiAudioIO) open a scope of their own
+// so the code around processBlock is covered too.
+//
+// Parameter changes are out of scope: EffectNode::setParam, and the key
+// parsing in ParameterManager, run on the control thread that calls them.
+// onParamChanged is where nodes do the allocating work a change needs
+// (ShortIRCabNode builds its kernel there and hands it over through
+// RtHandoff), so moving it to the audio thread would add violations, not
+// remove them. What onParamChanged must not do is reallocate or free
+// anything process() reads; test_rt_safety moves parameters between blocks
+// so the work they leave for the audio thread is checked.
+//
+// Mode (setMode, or the GEARBOX_RTCHECK environment variable when the hooks
+// start: "off", "count", "abort"; default count):
+//   Count — tally violations per kind and keep the first one's backtrace
+//   Abort — print the call and a backtrace to stderr, then abort()
+
+enum class Mode { Off, Count, Abort };
+enum Kind { Allocation, Deallocation, Lock, Syscall, kNumKinds };
+
+class RealtimeScope {
+public:
+    RealtimeScope();
+    ~RealtimeScope();
+    RealtimeScope(const RealtimeScope&)            = delete;
+    RealtimeScope& operator=(const RealtimeScope&) = delete;
+};
+
+bool isRealtimeThread();
+
+void setMode(Mode mode);
+Mode mode();
+
+// True when the interposers are linked in (nothing is checked otherwise).
+bool hooksInstalled();
+
+std::uint64_t violations(Kind kind);
+std::uint64_t totalViolations();
+void          resetViolations();
+
+// "malloc" etc. plus a symbolized backtrace of the first violation since the
+// last reset; empty if none. Allocates: call it outside real-time code.
+std::string firstViolation();
+
+const char* kindName(Kind kind);
+
+// ── For the hooks ────────────────────────────────────────────────────────────
+namespace detail {
+void markInstalled(Mode initialMode);
+// Records (or aborts on) `call` if this is a real-time thread in a checking
+// mode. Never allocates, and ignores calls made while reporting.
+void check(Kind kind, const char* call);
+} // namespace detail
+
+} // namespace rtcheck
+} // namespace gearboxfx
@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <memory>
+
+namespace gearboxfx {
+
+// Hands fully built objects (FIR kernels, models, ...) from a loader or GUI
+// thread to the audio thread. The producer builds the object aside and
+// publish()es it; the audio thread calls acquire() at the top of process()
+// and uses current() until the next acquire(). Neither side locks, and the
+// audio thread never frees: objects it lets go of are deleted by the next
+// publish() or the destructor. One thread publishes, one thread acquires.
+template <typename T>
+class RtHandoff {
+public:
+    RtHandoff() = default;
+    RtHandoff(const RtHandoff&)            = delete;
+    RtHandoff& operator=(const RtHandoff&) = delete;
+
+    ~RtHandoff() {
+        delete m_pending.load(std::memory_order_acquire);
+        freeList(m_retired.load(std::memory_order_acquire));
+        delete m_current;
+    }
+
+    // Producer side (allocates and frees). A publish() the audio thread has
+    // not picked up yet is replaced.
+    void publish(std::unique_ptr<T> value) {
+        freeList(m_retired.exchange(nullptr, std::memory_order_acquire));
+        Node* node = new Node{std::move(value), nullptr};
+        delete m_pending.exchange(node, std::memory_order_acq_rel);
+    }
+
+    // Audio thread: adopt the newest published object, if any.
+    // Returns true when current() changed.
+    bool acquire() {
+        Node* node = m_pending.exchange(nullptr, std::memory_order_acq_rel);
+        if (!node) return false;
+        if (m_current) {
+            m_current->next = m_retired.load(std::memory_order_relaxed);
+            while (!m_retired.compare_exchange_weak(m_current->next, m_current,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed)) {}
+        }
+        m_current = node;
+        return true;
+    }
+
+    // Audio thread: the object adopted by the last acquire() (null before one).
+    T*       current()       { return m_current ? m_current->value.get() : nullptr; }
+    const T* current() const { return m_current ? m_current->value.get() : nullptr; }
+
+private:
+    struct Node {
+        std::unique_ptr<T> value;
+        Node*              next;
+    };
+
+    static void freeList(Node* node) {
+        while (node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    std::atomic<Node*> m_pending{nullptr};  // producer -> audio thread
+    std::atomic<Node*> m_retired{nullptr};  // audio thread -> producer (to free)
+    Node*              m_current = nullptr; // audio thread only
+};
+
+} // namespace gearboxfx
@@ -0,0 +1,79 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace gearboxfx {
+
+// Bounded lock-free single-producer / single-consumer queue.
+// Storage is allocated once in the constructor (capacity rounded up to a
+// power of two); push() and pop() never allocate or block, so either end
+// may be the audio thread. One thread pushes, one thread pops.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity + 1) size <<= 1;
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    // Producer side. Returns false when full.
+    bool push(const T& value) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        const std::size_t next = (head + 1) & m_mask;
+        if (next == m_tail.load(std::memory_order_acquire)) return false;
+        m_slots[head] = value;
+        m_head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when empty.
+    bool pop(T& value) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) return false;
+        value = m_slots[tail];
+        m_tail.store((tail + 1) & m_mask, std::memory_order_release);
+        return true;
+    }
+
+    // Bulk variants: copy as many of n items as fit / are available
+    // (at most two contiguous runs each way).
+    std::size_t push(const T* data, std::size_t n) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        const std::size_t tail = m_tail.load(std::memory_order_acquire);
+        n = std::min(n, (tail - head - 1) & m_mask);
+        const std::size_t first = std::min(n, m_slots.size() - head);
+        std::copy(data, data + first, m_slots.data() + head);
+        std::copy(data + first, data + n, m_slots.data());
+        m_head.store((head + n) & m_mask, std::memory_order_release);
+        return n;
+    }
+
+    std::size_t pop(T* data, std::size_t n) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        n = std::min(n, (head - tail) & m_mask);
+        const std::size_t first = std::min(n, m_slots.size() - tail);
+        std::copy(m_slots.data() + tail, m_slots.data() + tail + first, data);
+        std::copy(m_slots.data(), m_slots.data() + (n - first), data + first);
+        m_tail.store((tail + n) & m_mask, std::memory_order_release);
+        return n;
+    }
+
+    bool empty() const {
+        return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return m_mask; }
+
+private:
+    std::vector<T> m_slots;
+    std::size_t    m_mask = 0;
+    alignas(64) std::atomic<std::size_t> m_head{0};  // written by the producer
+    alignas(64) std::atomic<std::size_t> m_tail{0};  // written by the consumer
+};
+
+} // namespace gearboxfx
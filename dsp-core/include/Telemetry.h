@@ -0,0 +1,100 @@
+#pragma once
+#include "EffectChain.h"
+#include "SpscQueue.h"
+#include "dsp/Fft.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gearboxfx {
+
+// One metering point. The audio thread copies channel 0 of each block into
+// an SPSC ring (two contiguous copies at most); analysis happens elsewhere.
+// The copy is full rate: the spectrum runs up to Nyquist and the peak meter
+// needs every sample, and a decimating filter here would cost more than the copy.
+class TelemetryTap {
+public:
+    void write(const float* x, int n) { m_ring.push(x, static_cast<std::size_t>(n)); }
+    std::size_t read(float* dst, std::size_t max) { return m_ring.pop(dst, max); }
+
+private:
+    SpscQueue<float> m_ring{8192};
+};
+
+struct TelemetryTaps {
+    TelemetryTap input;
+    TelemetryTap output;
+};
+
+// GUI-side metering for every node in a chain.
+// sync() gives each node a pair of taps (EffectChain writes them around
+// node->process()); a worker thread drains the taps every ~20 ms and
+// computes RMS, peak, a decimated scope and a log-band FFT spectrum of the
+// node output, plus the node's gain reduction. The audio thread never waits:
+// the mutex here is only shared by the worker and the GUI.
+class Telemetry {
+public:
+    static constexpr float kFloorDb   = -120.0f;
+    static constexpr int   kFftSize   = 2048;
+    static constexpr int   kBands     = 48;    // log spaced, 30 Hz .. Nyquist
+    static constexpr int   kScopeSize = 256;
+    static constexpr int   kScopeDecimation = 4;
+
+    struct Meter {
+        float rmsDb  = kFloorDb;
+        float peakDb = kFloorDb;  // falls back at 20 dB/s
+    };
+
+    struct NodeMeters {
+        Meter input, output;
+        float gainReductionDb = 0.0f;
+        std::array<float, kBands>     spectrumDb{};
+        std::array<float, kScopeSize> scope{};  // output, every kScopeDecimation-th sample
+    };
+
+    ~Telemetry() { stop(); }
+
+    void start(double sampleRate);
+    void stop();
+
+    // GUI thread, after any change to the chain. Attaching and detaching taps
+    // is a pointer store, so the chain lock is not needed.
+    void sync(const EffectChain& chain);
+
+    // Latest readings for a node; false if it has no taps.
+    bool meters(const EffectNode* node, NodeMeters& out) const;
+
+    // Band centre frequency (for axis labels).
+    float bandHz(int band) const;
+
+private:
+    struct Analysis {
+        std::weak_ptr<EffectNode>      node;
+        std::unique_ptr<TelemetryTaps> taps;
+        std::vector<float>             history;  // last kFftSize output samples, ring
+        int                            historyPos = 0;
+        NodeMeters                     meters;
+    };
+
+    double m_sampleRate = 48000.0;
+
+    mutable std::mutex     m_mutex;   // worker <-> GUI only
+    std::vector<Analysis>  m_nodes;
+
+    std::thread       m_worker;
+    std::atomic<bool> m_running{false};
+
+    // Worker scratch
+    Fft                m_fft;
+    std::vector<float> m_window, m_re, m_im, m_block;
+    int                m_bandLo[kBands] = {}, m_bandHi[kBands] = {};
+
+    void workerLoop();
+    void analyse(Analysis& a, float dt);
+    static void meter(const float* x, std::size_t n, Meter& m, float dt);
+};
+
+} // namespace gearboxfx
@@ -0,0 +1,38 @@
+#pragma once
+#include <atomic>
+
+namespace gearboxfx {
+
+// Shared musical time for tempo-synced nodes (LFOs, later delays).
+// EffectEngine owns one and advances it after every block, so while a node
+// runs, `beat` is the position of the block's first sample.
+// Both fields are atomics: the control thread sets the tempo (and the GUI
+// reads the position) while the audio thread advances and reads them.
+struct TempoClock {
+    static constexpr double kDefaultBpm = 120.0;
+    static constexpr double kMinBpm     = 20.0;
+    static constexpr double kMaxBpm     = 300.0;
+
+    std::atomic<double> bpm{kDefaultBpm};
+    std::atomic<double> beat{0.0};   // written by the audio thread only
+
+    static double clampBpm(double v) { return v < kMinBpm ? kMinBpm : (v > kMaxBpm ? kMaxBpm : v); }
+
+    void advance(int numSamples, double sampleRate) {
+        const double b = beat.load(std::memory_order_relaxed);
+        beat.store(b + numSamples * bpm.load(std::memory_order_relaxed) / (60.0 * sampleRate),
+                   std::memory_order_relaxed);
+    }
+
+    // Length in beats of the synced-LFO divisions (1/1, 1/2, 1/4, 1/8, 1/8T, 1/16).
+    // Index 0 is "free running" and has no length.
+    static constexpr int kNumDivisions = 7;
+    static double divisionBeats(int index) {
+        static constexpr double kBeats[kNumDivisions] = {
+            0.0, 4.0, 2.0, 1.0, 0.5, 1.0 / 3.0, 0.25
+        };
+        return (index > 0 && index < kNumDivisions) ? kBeats[index] : 0.0;
+    }
+};
+
+} // namespace gearboxfx
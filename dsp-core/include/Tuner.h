@@ -0,0 +1,65 @@
+#pragma once
+#include "SpscQueue.h"
+#include "dsp/PitchDetector.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace gearboxfx {
+
+// Always-on chromatic tuner tap.
+// The audio callback only copies input samples into a lock-free ring
+// (push(), no allocation or locking). A background thread drains the ring
+// through the incremental YIN detector, which low-passes and decimates to
+// ~6 kHz, and publishes the result as atomics for the GUI to poll.
+class Tuner {
+public:
+    static constexpr float kMinHz = 40.0f;    // bass low E is 41.2 Hz
+    static constexpr float kMaxHz = 1200.0f;
+
+    ~Tuner() { stop(); }
+
+    // (Re)starts the analysis thread.
+    void prepare(double sampleRate);
+    void stop();
+
+    // Audio thread. Samples are dropped if the analysis thread falls behind.
+    void push(const float* x, int n) { m_ring.push(x, static_cast<std::size_t>(n)); }
+
+    void setEnabled(bool on) { m_enabled.store(on, std::memory_order_relaxed); }
+    bool enabled() const     { return m_enabled.load(std::memory_order_relaxed); }
+
+    void  setReference(float a4Hz) { m_reference.store(a4Hz, std::memory_order_relaxed); }
+    float reference() const        { return m_reference.load(std::memory_order_relaxed); }
+
+    // Latest reading. frequency() is 0 and note() is -1 when there is no pitch.
+    float frequency()  const { return m_frequency.load(std::memory_order_relaxed); }
+    int   note()       const { return m_note.load(std::memory_order_relaxed); }   // MIDI note
+    float cents()      const { return m_cents.load(std::memory_order_relaxed); }  // [-50, 50]
+    float confidence() const { return m_confidence.load(std::memory_order_relaxed); }
+
+    // "C", "C#", ... for a MIDI note (empty for -1).
+    static const char* noteName(int midiNote);
+
+private:
+    static constexpr float kGateRms = 1e-3f;  // -60 dBFS: quieter input reads as no pitch
+
+    SpscQueue<float>   m_ring{16384};
+    PitchDetector      m_detector;
+    std::vector<float> m_scratch;
+
+    std::thread       m_worker;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_enabled{true};
+
+    std::atomic<float> m_reference{440.0f};
+    std::atomic<float> m_frequency{0.0f};
+    std::atomic<int>   m_note{-1};
+    std::atomic<float> m_cents{0.0f};
+    std::atomic<float> m_confidence{0.0f};
+
+    void workerLoop();
+    void publish(float rms);
+};
+
+} // namespace gearboxfx
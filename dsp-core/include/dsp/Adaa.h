@@ -0,0 +1,262 @@
+#pragma once
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace gearboxfx {
+
+// A shaper input with its per-sample terms; what t0 / t1 hold is up to the shaper.
+struct AdaaPoint {
+    float x;
+    float t0 = 0.0f;
+    float t1 = 0.0f;
+};
+
+// Antiderivative anti-aliasing (Parker et al. 2016, Bilbao et al. 2017) for
+// memoryless waveshapers. Instead of f(x[n]) the shaper outputs the average
+// of f over the segment between consecutive inputs:
+//   1st order: y[n] = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1])
+//   2nd order: y[n] = 2 / (x[n] - x[n-2]) * (D1[n] - D1[n-1]),
+//              D1[n] = (F2(x[n]) - F2(x[n-1])) / (x[n] - x[n-1])
+// where F1, F2 are the first and second antiderivatives of f. Latency is half
+// a sample (1st order) or one sample (2nd order).
+//
+// Shaper concept:
+//   AdaaPoint point(x)  per-sample terms (atan x, ...), computed once for the
+//                       two segments that share the sample
+//   float mean0(a, b)   average of f  over [b, a], i.e. (F1(a) - F1(b)) / (a - b)
+//   float mean1(a, b)   average of F1 over [b, a], i.e. (F2(a) - F2(b)) / (a - b)
+//   double f, F1, F2    reference forms, for the 2nd-order fallback
+// mean0 / mean1 take two AdaaPoints and are rearranged so that nothing cancels
+// as a -> b (they return f(a) / F1(a) at a == b), which keeps them accurate in
+// float with fastmath closed forms and removes the 1st-order near-equal-input
+// fallback. All of it is branch-free, so the block loops vectorize.
+//
+// Second order still divides by x[n] - x[n-2]. Where that is small next to
+// the float rounding of D1, the sample is redone afterwards in double with
+// Chowdhury's midpoint form (Chowdhury 2020); only those samples pay for it.
+class Adaa {
+public:
+    // |x[n] - x[n-2]| below kRelTol * (|D1[n]| + |D1[n-1]|) + kAbsTol takes the fallback.
+    static constexpr float  kRelTol = 2e-3f;
+    static constexpr float  kAbsTol = 1e-6f;
+    static constexpr double kEps    = 1e-5;   // double fallback's own threshold
+
+    void prepare(int maxBlockSize) {
+        m_x .assign(maxBlockSize + 2, 0.0f);
+        m_t0.assign(maxBlockSize + 2, 0.0f);
+        m_t1.assign(maxBlockSize + 2, 0.0f);
+        m_D1.assign(maxBlockSize + 2, 0.0f);
+    }
+
+    void reset() {
+        std::fill(m_x.begin(), m_x.end(), 0.0f);
+    }
+
+    // In-place. order 0 = plain f(x), 1 or 2 = ADAA of that order.
+    template <typename Shaper>
+    void process(float* buf, int n, int order, const Shaper& sh) {
+        if (order <= 0) {
+            for (int i = 0; i < n; ++i)
+                buf[i] = static_cast<float>(sh.f(buf[i]));
+            return;
+        }
+
+        // m_x = [x[-2], x[-1], x[0] .. x[n-1]]
+        float* x = m_x.data();
+        std::copy(buf, buf + n, x + 2);
+        for (int k = 0; k < n + 2; ++k) {
+            const AdaaPoint pt = sh.point(x[k]);
+            m_t0[k] = pt.t0;
+            m_t1[k] = pt.t1;
+        }
+
+        if (order == 1) processFirst (buf, n, sh);
+        else            processSecond(buf, n, sh);
+
+        x[0] = x[n];
+        x[1] = x[n + 1];
+    }
+
+private:
+    std::vector<float> m_x;
+    std::vector<float> m_t0, m_t1;  // Shaper::point terms of m_x
+    std::vector<float> m_D1;
+
+    AdaaPoint at(int k) const { return {m_x[k], m_t0[k], m_t1[k]}; }
+
+    template <typename Shaper>
+    void processFirst(float* y, int n, const Shaper& sh) {
+        for (int i = 0; i < n; ++i)
+            y[i] = sh.mean0(at(i + 2), at(i + 1));
+    }
+
+    template <typename Shaper>
+    void processSecond(float* y, int n, const Shaper& sh) {
+        const float* x  = m_x.data();
+        float*       D1 = m_D1.data();
+
+        for (int k = 1; k < n + 2; ++k)
+            D1[k] = sh.mean1(at(k), at(k - 1));
+
+        int numIll = 0;
+        for (int i = 0; i < n; ++i) {
+            const int   k   = i + 2;
+            const float d2  = x[k] - x[k - 2];
+            const float tol = kRelTol * (std::fabs(D1[k]) + std::fabs(D1[k - 1])) + kAbsTol;
+            const bool  ill = std::fabs(d2) < tol;
+            y[i] = 2.0f * (D1[k] - D1[k - 1]) / (ill ? 1.0f : d2);
+            numIll += ill;
+        }
+        if (numIll == 0) return;
+
+        for (int i = 0; i < n; ++i) {
+            const int   k   = i + 2;
+            const float tol = kRelTol * (std::fabs(D1[k]) + std::fabs(D1[k - 1])) + kAbsTol;
+            if (std::fabs(x[k] - x[k - 2]) < tol)
+                y[i] = static_cast<float>(fallback(x[k], x[k - 1], x[k - 2], sh));
+        }
+    }
+
+    // x[n] ≈ x[n-2]: integrate around the midpoint instead.
+    template <typename Shaper>
+    static double fallback(double x0, double x1, double x2, const Shaper& sh) {
+        const double xbar  = 0.5 * (x0 + x2);
+        const double delta = xbar - x1;
+        if (std::abs(delta) < kEps)
+            return sh.f(0.5 * (xbar + x1));
+        return 2.0 / delta * (sh.F1(xbar) + (sh.F2(x1) - sh.F2(xbar)) / delta);
+    }
+};
+
+// 2/pi * atan(x), output in (-1, 1).
+//   F1 = x atan x - ln(1 + x^2) / 2
+//   F2 = (x^2 - 1) atan x / 2 + x / 2 - x ln(1 + x^2) / 2
+// The segment averages use atan a - atan b = atan((a - b) / (1 + ab)) and
+// ln((1 + a^2) / (1 + b^2)) = ln(1 + (a - b)(a + b) / (1 + b^2)), whose
+// ratios to (a - b) are smooth at a == b.
+struct AtanShaper {
+    static constexpr double k2OverPi = 0.63661977236758134;
+
+    double f(double x) const { return k2OverPi * std::atan(x); }
+
+    double F1(double x) const {
+        return k2OverPi * (x * std::atan(x) - 0.5 * std::log1p(x * x));
+    }
+
+    double F2(double x) const {
+        return k2OverPi * (0.5 * (x * x - 1.0) * std::atan(x) + 0.5 * x
+                           - 0.5 * x * std::log1p(x * x));
+    }
+
+    // t0 = atan x, t1 = ln(1 + x^2)
+    AdaaPoint point(float x) const {
+        return {x, fastmath::atan(x), lnRatio(1.0f + x * x) * x * x};
+    }
+
+    float mean0(AdaaPoint a, AdaaPoint b) const {
+        const Segment s(a, b);
+        return static_cast<float>(k2OverPi) * (b.t0 + a.x * s.q - 0.5f * s.r);
+    }
+
+    float mean1(AdaaPoint a, AdaaPoint b) const {
+        const Segment s(a, b);
+        return static_cast<float>(k2OverPi) * 0.5f
+             * (s.qa + (a.x + b.x) * b.t0 - a.x * s.r - b.t1);
+    }
+
+private:
+    // ln(w) / (w - 1), 1 at w == 1. ln(1 + v) = v * lnRatio(1 + v): the ratio
+    // is evaluated at the rounded 1 + v, which it tolerates, instead of
+    // rounding v away.
+    static float lnRatio(float w) {
+        const float wm1 = w - 1.0f;
+        return (wm1 == 0.0f) ? 1.0f : fastmath::kLn2 * fastmath::log2(w) / (wm1 == 0.0f ? 1.0f : wm1);
+    }
+
+    // Quantities shared by both averages; all finite at a == b.
+    struct Segment {
+        float q;   // (atan a - atan b) / (a - b)
+        float qa;  // (a^2 - 1) q + 1
+        float r;   // ln((1 + a^2) / (1 + b^2)) / (a - b)
+
+        Segment(AdaaPoint pa, AdaaPoint pb) {
+            const float a  = pa.x, b = pb.x;
+            const float d  = a - b;
+            const float p  = 1.0f + a * b;
+            const float sb = 1.0f + b * b;
+
+            // |a - b| <= 1 + ab: atan a - atan b = atan(u) with u = d / p in
+            // [-1, 1], and atan(u) / u - 1 comes straight from the polynomial
+            // tail, so both q and qa = (a^2 (1 + tail) + ab - tail) / p keep
+            // their precision for close and for small inputs. Otherwise the
+            // direct differences are well conditioned (|a - b| > 1 + ab).
+            const bool  near = std::fabs(d) <= p;
+            const float pn   = near ? p : 1.0f;
+            const float u    = near ? d / pn : 0.0f;
+            const float tail = u * u * fastmath::atanUnitTail(u * u);
+            const float qd   = (pa.t0 - pb.t0) / (d == 0.0f ? 1.0f : d);
+            q  = near ? (1.0f + tail) / pn                        : qd;
+            qa = near ? (a * a * (1.0f + tail) + a * b - tail) / pn : (a * a - 1.0f) * qd + 1.0f;
+
+            const float w = (a + b) / sb;
+            r = lnRatio(1.0f + d * w) * w;
+        }
+    };
+};
+
+// Hard clipper with separate thresholds: f(x) = clamp(x, -neg, pos).
+// The segment averages integrate each region the segment covers: lengths of
+// the clipped parts and the clamped end points are exact where the ends
+// share a region, so nothing cancels.
+struct AsymClipShaper {
+    double pos = 1.0;
+    double neg = 1.0;
+
+    double f(double x) const { return std::min(pos, std::max(-neg, x)); }
+
+    double F1(double x) const {
+        double c = f(x), r = x - c;
+        return 0.5 * c * c + c * r;
+    }
+
+    double F2(double x) const {
+        double c = f(x), r = x - c;
+        return c * c * c / 6.0 + 0.5 * c * c * r + 0.5 * c * r * r;
+    }
+
+    AdaaPoint point(float x) const { return {x}; }
+
+    float mean0(AdaaPoint a, AdaaPoint b) const {
+        const Segment s(a.x, b.x, static_cast<float>(pos), static_cast<float>(neg));
+        const float sum = -s.n * s.below + 0.5f * (s.ch - s.cl) * (s.ch + s.cl) + s.p * s.above;
+        return (s.len == 0.0f) ? s.ch : sum / (s.len == 0.0f ? 1.0f : s.len);
+    }
+
+    float mean1(AdaaPoint a, AdaaPoint b) const {
+        const Segment s(a.x, b.x, static_cast<float>(pos), static_cast<float>(neg));
+        const float mid   = (s.ch - s.cl) * (s.ch * s.ch + s.ch * s.cl + s.cl * s.cl) * (1.0f / 6.0f);
+        const float above = s.above * (s.p * 0.5f * (std::max(s.lo, s.p) + s.hi) - 0.5f * s.p * s.p);
+        const float below = s.below * (-s.n * 0.5f * (s.lo + std::min(s.hi, -s.n)) - 0.5f * s.n * s.n);
+        const float atEnd = 0.5f * s.ch * s.ch + s.ch * (s.hi - s.ch);  // F1(hi)
+        return (s.len == 0.0f) ? atEnd : (mid + above + below) / (s.len == 0.0f ? 1.0f : s.len);
+    }
+
+private:
+    struct Segment {
+        float p, n, lo, hi, len, cl, ch, below, above;
+
+        Segment(float a, float b, float pos_, float neg_) : p(pos_), n(neg_) {
+            lo    = std::min(a, b);
+            hi    = std::max(a, b);
+            len   = hi - lo;
+            cl    = std::min(p, std::max(-n, lo));
+            ch    = std::min(p, std::max(-n, hi));
+            below = std::max(0.0f, std::min(hi, -n) - lo);
+            above = std::max(0.0f, hi - std::max(lo, p));
+        }
+    };
+};
+
+} // namespace gearboxfx
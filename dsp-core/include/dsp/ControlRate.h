@@ -0,0 +1,10 @@
+#pragma once
+
+namespace gearboxfx {
+
+// Time-varying DSP in dsp-core (LFO shapes, swept filter coefficients,
+// smoothed parameters) is evaluated once per control interval and
+// interpolated linearly in between.
+constexpr int kDefaultControlInterval = 16;
+
+} // namespace gearboxfx
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define GEARBOX_DENORMALS_SSE 1
+#endif
+
+namespace gearboxfx {
+
+// Flushes subnormal floats to zero on this thread for the guard's lifetime:
+// FTZ + DAZ in MXCSR on x86, FZ in FPCR / FPSCR on ARM. Decaying filter and
+// reverb states and near-silent input otherwise run the FP units' slow path
+// (tens of cycles per operation). The previous mode is restored on exit, so
+// guards nest. Elsewhere this is a no-op.
+class ScopedFlushDenormals {
+public:
+    ScopedFlushDenormals() : m_saved(read()) { write(m_saved | kFlushBits); }
+    ~ScopedFlushDenormals() { write(m_saved); }
+    ScopedFlushDenormals(const ScopedFlushDenormals&)            = delete;
+    ScopedFlushDenormals& operator=(const ScopedFlushDenormals&) = delete;
+
+    // False where the guard is a no-op.
+    static constexpr bool supported() { return kFlushBits != 0; }
+
+private:
+#if defined(GEARBOX_DENORMALS_SSE)
+    static constexpr std::uint64_t kFlushBits = 0x8040;       // FTZ | DAZ
+    static std::uint64_t read()                { return _mm_getcsr(); }
+    static void          write(std::uint64_t v) { _mm_setcsr(static_cast<unsigned>(v)); }
+#elif defined(__aarch64__)
+    static constexpr std::uint64_t kFlushBits = 1ull << 24;   // FPCR.FZ
+    static std::uint64_t read()                { std::uint64_t v; __asm__ __volatile__("mrs %0, fpcr" : "=r"(v)); return v; }
+    static void          write(std::uint64_t v) { __asm__ __volatile__("msr fpcr, %0" : : "r"(v)); }
+#elif defined(__arm__) && defined(__ARM_FP)
+    static constexpr std::uint64_t kFlushBits = 1u << 24;     // FPSCR.FZ
+    static std::uint64_t read()                { std::uint32_t v; __asm__ __volatile__("vmrs %0, fpscr" : "=r"(v)); return v; }
+    static void          write(std::uint64_t v) { __asm__ __volatile__("vmsr fpscr, %0" : : "r"(static_cast<std::uint32_t>(v))); }
+#else
+    static constexpr std::uint64_t kFlushBits = 0;
+    static std::uint64_t read()                { return 0; }
+    static void          write(std::uint64_t)  {}
+#endif
+
+    std::uint64_t m_saved;
+};
+
+} // namespace gearboxfx
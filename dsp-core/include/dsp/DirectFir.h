@@ -0,0 +1,97 @@
+#pragma once
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define GEARBOX_FIR_SSE 1
+#endif
+
+namespace gearboxfx {
+
+// Inner FIR kernel shared by the direct-form filters in dsp-core.
+// Computes y[n] = sum_k hRev[k] * x[n + k] for n in [0, numOut), where x is a
+// contiguous buffer holding (numTaps - 1) history samples followed by the input
+// block and hRev is the time-reversed kernel.
+// Outputs are produced kFirLanes at a time with the taps in the outer loop.
+// On SSE the lanes are four explicit __m128 accumulators that stay in
+// registers across the whole tap loop; left to itself, GCC -O3 vectorises
+// the tap loop instead and runs about 2x slower. Elsewhere the lane loop is
+// plain C++ for the compiler to map onto its own vector unit.
+constexpr int kFirLanes = 16;
+
+inline void firBlockScalar(const float* x, const float* hRev, int numTaps, float* y, int numOut) {
+    for (int n = 0; n < numOut; ++n) {
+        float acc = 0.0f;
+        for (int k = 0; k < numTaps; ++k)
+            acc += hRev[k] * x[n + k];
+        y[n] = acc;
+    }
+}
+
+inline void firBlock(const float* x, const float* hRev, int numTaps, float* y, int numOut) {
+    int n = 0;
+#if defined(GEARBOX_FIR_SSE)
+    for (; n + kFirLanes <= numOut; n += kFirLanes) {
+        __m128 a0 = _mm_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+        const float* xp = x + n;
+        for (int k = 0; k < numTaps; ++k) {
+            const __m128 h = _mm_set1_ps(hRev[k]);
+            a0 = _mm_add_ps(a0, _mm_mul_ps(h, _mm_loadu_ps(xp + k)));
+            a1 = _mm_add_ps(a1, _mm_mul_ps(h, _mm_loadu_ps(xp + k + 4)));
+            a2 = _mm_add_ps(a2, _mm_mul_ps(h, _mm_loadu_ps(xp + k + 8)));
+            a3 = _mm_add_ps(a3, _mm_mul_ps(h, _mm_loadu_ps(xp + k + 12)));
+        }
+        _mm_storeu_ps(y + n,      a0);
+        _mm_storeu_ps(y + n + 4,  a1);
+        _mm_storeu_ps(y + n + 8,  a2);
+        _mm_storeu_ps(y + n + 12, a3);
+    }
+#else
+    for (; n + kFirLanes <= numOut; n += kFirLanes) {
+        float acc[kFirLanes] = {};
+        for (int k = 0; k < numTaps; ++k) {
+            const float  h  = hRev[k];
+            const float* xp = x + n + k;
+            for (int j = 0; j < kFirLanes; ++j)
+                acc[j] += h * xp[j];
+        }
+        for (int j = 0; j < kFirLanes; ++j)
+            y[n + j] = acc[j];
+    }
+#endif
+    firBlockScalar(x + n, hRev, numTaps, y + n, numOut - n);
+}
+
+// Single-channel direct-form FIR filter with block processing.
+// All storage is sized in prepare(); setKernel() and process() never allocate.
+class DirectFir {
+public:
+    void prepare(int maxTaps, int maxBlockSize);
+
+    // Load a kernel (natural time order). numTaps is clamped to maxTaps.
+    // Only numTaps - 1 samples of history are kept, so a longer kernel starts
+    // with the extra (older) part of its history silent.
+    void setKernel(const float* h, int numTaps);
+
+    void reset();
+
+    // in and out may alias.
+    void process(const float* in, float* out, int numSamples);
+
+    // Advance the history by numSamples without computing output
+    // (keeps the filter state coherent when a channel's output is skipped).
+    void pushHistory(const float* in, int numSamples);
+
+    int numTaps() const { return m_numTaps; }
+
+private:
+    int m_maxTaps      = 0;
+    int m_maxBlockSize = 0;
+    int m_numTaps      = 0;
+
+    std::vector<float> m_kernelRev;  // time-reversed kernel
+    std::vector<float> m_buf;        // [maxTaps - 1 history | maxBlockSize input];
+                                     // the active numTaps - 1 sit just before the input
+};
+
+} // namespace gearboxfx
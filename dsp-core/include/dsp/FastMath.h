@@ -0,0 +1,179 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace gearboxfx {
+namespace fastmath {
+
+// Polynomial approximations for the per-sample loops. All functions are
+// branch-free (selects only) and inline, so a loop over them vectorizes.
+// The block variants at the bottom are plain loops for that purpose.
+//
+// Error bounds (measured over the stated domain, asserted in test_fast_math;
+// "mixed" = abs err / max(1, |result|), i.e. relative for large results):
+//   sin2pi / cos2pi   |phase| <= 1       abs err < 3e-7
+//   sin / cos         |x| <= 2*pi        abs err < 1e-6
+//   tan               |x| <= 0.49*pi     rel err < 1e-5  (< 1e-6 below 0.25*pi)
+//   atan              all x              abs err < 2e-7
+//   atan2             all (y, x)         abs err < 3e-7  (atan2(0, 0) = 0)
+//   exp2              [-126, 126]        rel err < 3e-7
+//   log2              normal floats      mixed err < 3e-7
+//   tanh, sigmoid     all x              abs err < 5e-7
+//   dbToLinear        [-120, 40] dB      rel err < 1e-6
+//   linearToDb        [1e-6, 100]        abs err < 1e-5 dB
+// Outside those ranges the error grows with the float rounding of the argument.
+
+constexpr float kPi      = 3.14159265358979f;
+constexpr float kHalfPi  = 1.57079632679490f;
+constexpr float kTwoPi   = 6.28318530717959f;
+constexpr float kInvTwoPi = 0.159154943091895f;
+constexpr float kLog2e   = 1.44269504088896f;
+constexpr float kLn2     = 0.693147180559945f;
+constexpr float kDbToLog2 = 0.166096404744368f;  // log2(10) / 20
+constexpr float kLog2ToDb = 6.02059991327962f;   // 20 / log2(10)
+
+inline float bitsToFloat(std::uint32_t u) { float f; std::memcpy(&f, &u, 4); return f; }
+inline std::uint32_t floatToBits(float f) { std::uint32_t u; std::memcpy(&u, &f, 4); return u; }
+
+// sin(2*pi*phase). Reduce to [-0.5, 0.5], fold onto [-0.25, 0.25] using
+// sin(pi - x) = sin(x), then a degree-11 odd polynomial on [-pi/2, pi/2].
+inline float sin2pi(float phase) {
+    float r = phase - std::floor(phase + 0.5f);
+    r = (r >  0.25f) ?  0.5f - r : r;
+    r = (r < -0.25f) ? -0.5f - r : r;
+    const float x  = r * kTwoPi;
+    const float x2 = x * x;
+    float p = -2.5052108e-8f;
+    p = p * x2 + 2.7557319e-6f;
+    p = p * x2 - 1.9841270e-4f;
+    p = p * x2 + 8.3333333e-3f;
+    p = p * x2 - 1.6666667e-1f;
+    return x + x * x2 * p;
+}
+
+// cos(2*pi*phase) = sin(2*pi*(1/4 - |r|)) with r the phase reduced to [-0.5, 0.5].
+inline float cos2pi(float phase) {
+    const float r = phase - std::floor(phase + 0.5f);
+    return sin2pi(0.25f - std::fabs(r));
+}
+
+inline float sin(float x) { return sin2pi(x * kInvTwoPi); }
+inline float cos(float x) { return cos2pi(x * kInvTwoPi); }
+
+// For the bilinear-transform prewarp tan(pi * fc / sr), fc < sr/2.
+inline float tan(float x) {
+    const float p = x * kInvTwoPi;
+    return sin2pi(p) / cos2pi(p);
+}
+
+// Abramowitz & Stegun 4.4.49: atan(t) = t + t^3 * atanUnitTail(t^2) for t in [0, 1].
+inline float atanUnitTail(float t2) {
+    float p = 0.0028662257f;
+    p = p * t2 - 0.0161657367f;
+    p = p * t2 + 0.0429096138f;
+    p = p * t2 - 0.0752896400f;
+    p = p * t2 + 0.1065626393f;
+    p = p * t2 - 0.1420889944f;
+    p = p * t2 + 0.1999355085f;
+    p = p * t2 - 0.3333314528f;
+    return p;
+}
+
+inline float atanUnit(float t) {
+    const float t2 = t * t;
+    return t + t * t2 * atanUnitTail(t2);
+}
+
+// atan(x) = pi/2 - atan(1/x) above 1.
+inline float atan(float x) {
+    const float ax  = std::fabs(x);
+    const bool  inv = ax > 1.0f;
+    float r = atanUnit(inv ? 1.0f / ax : ax);
+    r = inv ? kHalfPi - r : r;
+    return std::copysign(r, x);
+}
+
+// Full-circle angle of (x, y): the smaller of |x|, |y| over the larger goes
+// through atanUnit, then the octant is restored with selects.
+inline float atan2(float y, float x) {
+    const float ax = std::fabs(x), ay = std::fabs(y);
+    const float mx = (ax > ay) ? ax : ay;
+    const float mn = (ax > ay) ? ay : ax;
+    float r = atanUnit((mx > 0.0f) ? mn / mx : 0.0f);
+    r = (ay > ax)   ? kHalfPi - r : r;
+    r = (x < 0.0f)  ? kPi - r     : r;
+    return std::copysign(r, y);
+}
+
+// 2^x: split into round(x) (exponent bits) and f in [-0.5, 0.5]
+// (degree-6 Taylor of e^(f ln2)).
+inline float exp2(float x) {
+    x = (x < -126.0f) ? -126.0f : x;
+    x = (x >  126.0f) ?  126.0f : x;
+    const float xi = std::floor(x + 0.5f);
+    const float f  = (x - xi) * kLn2;
+    float p = 1.3888889e-3f;
+    p = p * f + 8.3333333e-3f;
+    p = p * f + 4.1666667e-2f;
+    p = p * f + 1.6666667e-1f;
+    p = p * f + 0.5f;
+    p = p * f + 1.0f;
+    p = p * f + 1.0f;
+    const auto e = static_cast<std::uint32_t>(static_cast<std::int32_t>(xi) + 127) << 23;
+    return p * bitsToFloat(e);
+}
+
+inline float exp(float x) { return exp2(x * kLog2e); }
+
+// log2(x) for x > 0 (normal floats): exponent from the bits, mantissa folded
+// into [sqrt(1/2), sqrt(2)), then log2(m) = 2/ln2 * atanh((m-1)/(m+1)).
+inline float log2(float x) {
+    const std::uint32_t u = floatToBits(x);
+    float e = static_cast<float>(static_cast<std::int32_t>((u >> 23) & 0xFF) - 127);
+    float m = bitsToFloat((u & 0x007FFFFFu) | 0x3F800000u);  // [1, 2)
+    const bool big = m > 1.41421356f;
+    m = big ? 0.5f * m : m;
+    e = big ? e + 1.0f : e;
+    const float s  = (m - 1.0f) / (m + 1.0f);
+    const float s2 = s * s;
+    float p = 1.0f / 9.0f;
+    p = p * s2 + 1.0f / 7.0f;
+    p = p * s2 + 1.0f / 5.0f;
+    p = p * s2 + 1.0f / 3.0f;
+    p = p * s2 + 1.0f;
+    return e + 2.88539008f * s * p;  // 2 / ln2
+}
+
+inline float tanh(float x) {
+    x = (x < -9.0f) ? -9.0f : x;
+    x = (x >  9.0f) ?  9.0f : x;
+    const float e = exp2(2.0f * kLog2e * x);
+    return (e - 1.0f) / (e + 1.0f);
+}
+
+inline float sigmoid(float x) { return 0.5f + 0.5f * tanh(0.5f * x); }
+
+inline float dbToLinear(float db)  { return exp2(db * kDbToLog2); }
+inline float linearToDb(float lin) { return kLog2ToDb * log2(lin); }
+
+// ── Block variants (in and out may alias) ───────────────────────────────────
+
+inline void sin2piBlock(const float* phase, float* out, int n) {
+    for (int i = 0; i < n; ++i) out[i] = sin2pi(phase[i]);
+}
+
+inline void tanhBlock(const float* in, float* out, int n) {
+    for (int i = 0; i < n; ++i) out[i] = tanh(in[i]);
+}
+
+inline void dbToLinearBlock(const float* db, float* out, int n) {
+    for (int i = 0; i < n; ++i) out[i] = dbToLinear(db[i]);
+}
+
+inline void linearToDbBlock(const float* lin, float* out, int n) {
+    for (int i = 0; i < n; ++i) out[i] = linearToDb(lin[i]);
+}
+
+} // namespace fastmath
+} // namespace gearboxfx
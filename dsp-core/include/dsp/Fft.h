@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+
+namespace gearboxfx {
+
+// Iterative radix-2 complex FFT operating on split real/imaginary arrays.
+// Twiddle and bit-reversal tables are built in prepare(); forward() and
+// inverse() never allocate and are safe to call from the audio thread.
+class Fft {
+public:
+    // size must be a power of two (>= 2).
+    void prepare(int size);
+
+    int size() const { return m_size; }
+
+    // In-place forward transform (no scaling).
+    void forward(float* re, float* im) const;
+
+    // In-place inverse transform, scaled by 1/N so inverse(forward(x)) == x.
+    void inverse(float* re, float* im) const;
+
+    static bool isPowerOfTwo(int n) { return n > 0 && (n & (n - 1)) == 0; }
+    static int  nextPowerOfTwo(int n);
+
+private:
+    void transform(float* re, float* im, float sign) const;
+
+    int                m_size = 0;
+    std::vector<float> m_cos;     // N/2 twiddles
+    std::vector<float> m_sin;
+    std::vector<int>   m_bitRev;  // bit-reversed index for each position
+};
+
+} // namespace gearboxfx
@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+
+namespace gearboxfx {
+
+// One 2x stage of a polyphase half-band resampler (Kaiser-windowed, ~80 dB).
+// A half-band filter has every second tap equal to zero except the centre
+// (0.5), so each polyphase branch is either a short FIR or a pure delay:
+//   upsample:   y[2m] = FIR(x)[m]          y[2m+1] = x[m - D]
+//   downsample: y[m]  = FIR(v_even)[m]  +  0.5 * v_odd[m - D - 1]
+// Only numTaps/2 + 1 multiplies per input sample, and none on zero-stuffed samples.
+// numTaps must be 4k + 3 (e.g. 19, 47). Up and down sides keep separate state.
+class HalfBandStage {
+public:
+    void prepare(int numTaps, int maxInputSize);
+    void reset();
+
+    // in: n samples → out: 2n samples
+    void upsample(const float* in, float* out, int n);
+
+    // in: 2n samples → out: n samples
+    void downsample(const float* in, float* out, int n);
+
+    // Group delay of one filter pass, in samples at the higher rate.
+    int delay() const { return m_center; }
+
+private:
+    int m_numTaps    = 0;
+    int m_center     = 0;   // (numTaps - 1) / 2, odd
+    int m_branchTaps = 0;   // non-zero taps excluding the centre
+    int m_maxInput   = 0;
+
+    std::vector<float> m_branchRev;    // time-reversed branch taps
+    std::vector<float> m_branchRevX2;  // same, x2 to restore gain after zero-stuffing
+
+    std::vector<float> m_upBuf;        // [branchTaps - 1 history | n input]
+    std::vector<float> m_downEven;     // [branchTaps - 1 history | n even inputs]
+    std::vector<float> m_downOdd;      // [delayOdd history       | n odd inputs]
+    std::vector<float> m_tmp;
+};
+
+} // namespace gearboxfx
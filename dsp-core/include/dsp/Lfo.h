@@ -0,0 +1,69 @@
+#pragma once
+#include "ControlRate.h"
+#include <cstdint>
+
+namespace gearboxfx {
+
+enum class LfoShape { Sine, Triangle, Square, SampleHold, Random };
+
+// Wavetable LFO shared by the modulation nodes. Output is in [-1, 1].
+//
+// Sine, triangle and square come from 256-point tables (plus a guard point)
+// with linear interpolation; triangle and square are band-limited to 15
+// harmonics so they don't click. Sample & hold draws a new value every cycle,
+// random glides between those values (smoothstep).
+// Phase conventions follow the old per-node LFOs: sine starts at 0 rising,
+// triangle starts at -1, square is +1 for the first half cycle.
+//
+// process() evaluates the shape only every controlInterval samples and fills
+// the samples in between by linear interpolation (a straight vector loop);
+// tick() returns one value per call for nodes that derive their own
+// coefficients at control rate.
+class Lfo {
+public:
+    static constexpr int kTableSize              = 256;
+    static constexpr int kDefaultControlInterval = gearboxfx::kDefaultControlInterval;
+
+    void prepare(double sampleRate);
+    void reset(float phase = 0.0f);
+
+    void setShape(LfoShape shape)   { m_shape = shape; }
+    void setRate(float hz);
+    void setControlInterval(int samples);
+    void setPhase(float phase);
+    float phase() const { return m_phase; }
+
+    // Lock phase and rate to a tempo clock: one cycle every beatsPerCycle beats.
+    void syncTo(double beat, double beatsPerCycle, double bpm);
+
+    // Fill out[0..n) with modulation values.
+    void process(float* out, int numSamples);
+
+    // Value at the current phase, then advance by numSamples.
+    float tick(int numSamples);
+
+private:
+    double   m_sampleRate = 48000.0;
+    LfoShape m_shape      = LfoShape::Sine;
+    float    m_rate       = 1.0f;
+    float    m_increment  = 0.0f;   // cycles per sample
+    float    m_phase      = 0.0f;   // phase of the next control point
+    int      m_interval   = kDefaultControlInterval;
+
+    // Control-rate interpolation state
+    int   m_countdown = 0;
+    float m_value     = 0.0f;
+    float m_target    = 0.0f;
+    float m_step      = 0.0f;
+
+    // Sample & hold / random
+    std::uint32_t m_seed     = 0x9E3779B9u;
+    float         m_randPrev = 0.0f;
+    float         m_randNext = 0.0f;
+
+    float valueAt(float phase) const;
+    void  advance(float cycles);
+    void  newCycle();
+};
+
+} // namespace gearboxfx
@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace gearboxfx {
+
+// Stereo-linked lookahead brickwall limiter with true-peak detection.
+//
+//   detect:  4x polyphase interpolation (12 taps per phase) estimates the
+//            inter-sample peak p[n]; required gain r[n] = min(1, thresh / p[n])
+//   window:  m[n] = min(r[n-L+1 .. n])   monotonic deque, O(1) amortised
+//   smooth:  g[n] = mean(m[n-L+1 .. n])  box filter, still <= r[n-L+1]
+//   release: gains may rise no faster than the release time constant
+//   audio:   delayed by L - 1 (+ interpolator delay) so g[n] meets the sample
+//            whose peak it was computed for; a final clamp guarantees |y| <= thresh
+//
+// Each term of the box filter is a window minimum that contains r[n-L+1],
+// so the gain is at or below the required gain when that sample comes out,
+// and it ramps down over L samples instead of jumping.
+//
+// setThreshold() and setLookahead() may be called from the control thread
+// while process() runs: both only store an atomic. A new lookahead is picked
+// up at the top of the next block, where the window restarts from the
+// current gain and the output crossfades from the old delay tap to the new
+// one, so changing it does not click.
+class LookaheadLimiter {
+public:
+    static constexpr int kTruePeakTaps  = 12;
+    static constexpr int kTruePeakDelay = kTruePeakTaps / 2 - 1;
+
+    static constexpr int kLookaheadFade = 64;  // crossfade after a lookahead change
+
+    void prepare(double sampleRate, int maxLookahead);
+    void reset();  // not concurrently with process()
+
+    void setThreshold(float linear)   { m_thresh.store(linear, std::memory_order_relaxed); }
+    void setLookahead(int samples);   // applied at the start of the next block
+    void setReleaseMs(float ms);
+
+    int latencySamples() const {
+        return m_requestedLookahead.load(std::memory_order_relaxed) - 1 + kTruePeakDelay;
+    }
+
+    // In-place on up to 2 channels (gain is linked across them).
+    void process(float* const* channels, int numChannels, int numSamples);
+
+private:
+    double m_sampleRate   = 48000.0;
+    int    m_maxLookahead = 1;
+    int    m_lookahead    = 1;          // audio thread
+    std::atomic<int>   m_requestedLookahead{1};
+    std::atomic<float> m_thresh{1.0f};
+    float  m_releaseCoeff = 0.9998f;
+    float  m_gain         = 1.0f;       // smoothed output gain
+
+    float m_phase[3][kTruePeakTaps] = {};  // fractional phases 1/4, 2/4, 3/4
+    float m_hist[2][2 * kTruePeakTaps] = {};  // doubled ring: contiguous window at m_histPos
+    int   m_histPos = 0;
+
+    std::vector<float> m_delay[2];
+    int                m_delayLen = 1;
+    int                m_delayPos = 0;
+    int                m_fadeFromLag = 0;   // previous read lag while crossfading
+    int                m_fadeLeft    = 0;
+
+    // Monotonic deque of (sample index, required gain), increasing values
+    std::vector<std::uint32_t> m_dqIndex;
+    std::vector<float>         m_dqValue;
+    int           m_dqHead  = 0;
+    int           m_dqCount = 0;
+    std::uint32_t m_counter = 0;
+
+    // Box filter over window minima
+    std::vector<float> m_box;
+    int    m_boxPos = 0;
+    double m_boxSum = 0.0;
+
+    void applyLookahead(int samples);
+};
+
+} // namespace gearboxfx
@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+
+namespace gearboxfx {
+
+// Stereo delay line for the modulated effects (chorus, flanger).
+// The buffer length is a power of two, so wrapping a read position is a mask
+// instead of a modulo. tapSum() reads kLanes linearly interpolated taps at
+// once: delays, indices and weights are computed across fixed-width lanes
+// (one SIMD register's worth of voices), so the cost is the same for one
+// voice or eight; unused lanes simply carry weight 0.
+//
+// Per sample: push() each channel, read taps (delay 0 = the sample just
+// pushed), then advance(). A feedback path reads before it pushes.
+class ModulatedDelay {
+public:
+    static constexpr int kLanes = 8;
+
+    void prepare(int maxDelaySamples);
+    void reset();
+
+    void push(int ch, float x) { m_buf[ch][m_writePos] = x; }
+    void advance()             { m_writePos = (m_writePos + 1) & m_mask; }
+
+    // Largest delay a read may ask for (one sample is kept for interpolation).
+    float maxDelay() const { return static_cast<float>(m_mask - 1); }
+
+    // Single linearly interpolated tap at a fractional delay in [0, maxDelay].
+    float read(int ch, float delaySamples) const;
+
+    // sum_j weights[j] * x[n - delays[j]] over kLanes taps.
+    float tapSum(int ch, const float* delays, const float* weights) const;
+
+private:
+    std::vector<float> m_buf[2];
+    int m_mask     = 0;
+    int m_writePos = 0;
+};
+
+} // namespace gearboxfx
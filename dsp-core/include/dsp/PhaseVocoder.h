@@ -0,0 +1,66 @@
+#pragma once
+#include "Fft.h"
+#include <vector>
+
+namespace gearboxfx {
+
+// Streaming phase-vocoder pitch shifter with identity phase locking
+// (Laroche & Dolson). Each frame:
+//   1. sqrt-Hann analysis window, FFT, magnitude/phase per bin (block loops)
+//   2. instantaneous frequency of each bin from the phase advance
+//   3. spectral peaks are moved to freq * ratio; the bins around each peak
+//      (its region, split halfway to the next peak) move with it and keep
+//      their phase relative to the peak, which keeps partials coherent
+//   4. inverse FFT, sqrt-Hann synthesis window, overlap-add
+// Latency is fftSize samples. All buffers are allocated in prepare()
+// for the largest size; configure() only switches sizes (no allocation).
+class PhaseVocoder {
+public:
+    static constexpr int kMinFftSize = 512;
+    static constexpr int kMaxFftSize = 4096;
+    static constexpr int kMaxOverlap = 8;
+    static constexpr int kChannels   = 2;
+
+    void prepare();
+    void configure(int fftSize, int overlap);  // resets state
+    void reset();
+
+    void setPitchRatio(float ratio) { m_ratio = ratio; }
+
+    int fftSize()        const { return m_size; }
+    int overlap()        const { return m_size / m_hop; }
+    int latencySamples() const { return m_size; }  // whole frame, whatever the overlap
+
+    // Process n samples of one channel (in and out may alias).
+    void process(int ch, const float* in, float* out, int n);
+
+    // Make channel `to` continue exactly like channel `from` (dual-mono shortcut).
+    void copyChannelState(int from, int to);
+
+private:
+    struct Channel {
+        std::vector<float> inFifo, outFifo, accum;
+        std::vector<float> lastPhase, synthPhase;  // cycles, per bin
+        int rover = 0;
+    };
+
+    static constexpr int kNumSizes = 4;  // 512, 1024, 2048, 4096
+    Fft m_fft[kNumSizes];
+
+    int   m_size  = 2048;
+    int   m_hop   = 512;
+    float m_ratio = 1.0f;
+
+    std::vector<float> m_window;    // sqrt-Hann, analysis and synthesis
+    std::vector<float> m_re, m_im;  // FFT work buffers
+    std::vector<float> m_mag, m_phase, m_freq;    // analysis, per bin
+    std::vector<float> m_outMag, m_outPhase;      // shifted spectrum
+    std::vector<int>   m_peaks;
+
+    Channel m_ch[kChannels];
+
+    const Fft& fft() const;
+    void processFrame(Channel& ch);
+};
+
+} // namespace gearboxfx
@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+
+namespace gearboxfx {
+
+// Incremental YIN pitch detector for monophonic input.
+// The input is low-passed and decimated to about 6 kHz, which is plenty for
+// fundamentals up to ~1.2 kHz. The YIN difference function d(tau) is kept
+// as running sums that are updated with one add and one subtract per lag
+// for each decimated sample, instead of being recomputed from the window.
+// Every few milliseconds the cumulative-mean-normalised d'(tau) is scanned
+// for the first dip below the threshold and refined by parabolic interpolation.
+class PitchDetector {
+public:
+    // The default range reaches the low E of a guitar in standard tuning
+    // (82.4 Hz) with some margin.
+    void prepare(double sampleRate, float minHz = 75.0f, float maxHz = 1200.0f);
+    void reset();
+
+    // Feed input-rate samples.
+    void push(const float* x, int n);
+
+    // Latest estimate; period() is 0 while unvoiced.
+    float period()     const { return m_period; }    // input samples
+    float frequency()  const { return m_period > 0.0f ? static_cast<float>(m_sampleRate) / m_period : 0.0f; }
+    float confidence() const { return m_confidence; } // 1 - d'(tau), 0..1
+
+    // Longest period prepare() can report, in input samples.
+    int maxPeriod() const { return (m_maxLag + 1) * m_decim; }
+
+private:
+    static constexpr double kTargetRate = 6000.0;
+    static constexpr float  kThreshold  = 0.15f;
+    static constexpr int    kHop        = 16;   // decimated samples between estimates
+
+    double m_sampleRate = 48000.0;
+    int    m_decim      = 8;
+    int    m_minLag     = 5;
+    int    m_maxLag     = 60;
+    int    m_window     = 60;
+
+    // Anti-alias: two one-pole low-passes, then keep every m_decim-th sample
+    float m_lpCoeff = 0.0f;
+    float m_lp1 = 0.0f, m_lp2 = 0.0f;
+    int   m_decimCount = 0;
+
+    std::vector<float>  m_ring;   // decimated history, power-of-two length, stored twice
+    int                 m_mask = 0;
+    int                 m_pos  = 0;
+    std::vector<double> m_diff;   // running d(tau), tau = 0..m_maxLag + 1
+    std::vector<float>  m_cmnd;
+    int                 m_filled   = 0;
+    int                 m_hopCount = 0;
+
+    float m_period     = 0.0f;
+    float m_confidence = 0.0f;
+
+    void pushDecimated(float z);
+    void estimate();
+};
+
+} // namespace gearboxfx
@@ -0,0 +1,65 @@
+#pragma once
+#include "PitchDetector.h"
+#include <vector>
+
+namespace gearboxfx {
+
+// Time-domain pitch-synchronous overlap-add (TD-PSOLA) shifter for
+// monophonic input. Per block:
+//   1. the incremental pitch detector updates the period T
+//   2. analysis marks are placed one period apart, each snapped to the
+//      waveform peak within +-T/4 of its predicted position
+//   3. synthesis marks advance by T / ratio; each takes the nearest analysis
+//      mark's grain (+-r samples, r = min(T, max radius)), weights it from a
+//      Hann table and overlap-adds it; the output is divided by the summed
+//      window weight wherever grains stack up (shifting up)
+// Unvoiced input falls back to fixed grains of the maximum radius.
+// The grain radius is capped at kMaxRadiusMs, which fixes the latency at
+// two radii (< 10 ms); lower notes keep one short grain per period around
+// the marked peak. Both channels share the marks.
+class PsolaShifter {
+public:
+    static constexpr int    kChannels    = 2;
+    static constexpr double kMaxRadiusMs = 4.8;
+
+    void prepare(double sampleRate);
+    void reset();
+
+    void setPitchRatio(float ratio) { m_ratio = ratio; }
+
+    int latencySamples() const { return 2 * m_maxRadius; }
+    const PitchDetector& detector() const { return m_detector; }
+
+    // Up to kChannels channels (in and out must not alias).
+    void process(const float* const* in, float* const* out, int numCh, int n);
+
+private:
+    static constexpr int kTableSize = 512;
+    static constexpr int kMaxMarks  = 8;
+
+    PitchDetector m_detector;
+    float  m_ratio     = 1.0f;
+    int    m_maxRadius = 230;
+
+    float m_window[kTableSize + 1] = {};  // Hann over [-r, r] (+ guard point)
+    std::vector<float> m_grainWindow;     // m_window resampled to 2 * m_grainRadius points
+    int                m_grainRadius = 0;
+
+    std::vector<float> m_in[kChannels];   // input history
+    std::vector<float> m_mono;            // analysis signal (channel average)
+    std::vector<float> m_acc[kChannels];  // overlap-add accumulators
+    std::vector<float> m_weight;          // summed window weight
+    long long m_mask = 0;
+
+    long long m_now = 0;                 // absolute index of the next input sample
+    long long m_marks[kMaxMarks] = {};   // recent analysis marks, ring
+    int       m_markHead = 0;
+    double    m_synth = 0.0;             // next synthesis mark
+
+    void addMark(long long predicted, int period, long long limit);
+    long long nearestMark(long long pos) const;
+    void setGrainRadius(int r);
+    void addGrain(long long synth, int period, int numCh);
+};
+
+} // namespace gearboxfx
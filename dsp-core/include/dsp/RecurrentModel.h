@@ -0,0 +1,84 @@
+#pragma once
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace gearboxfx {
+
+// Single-layer LSTM or GRU followed by a dense output neuron, the shape of
+// most real-time recurrent amp captures.
+//
+// The model file is gearboxfx's own JSON: the tensors of a PyTorch
+// nn.LSTM / nn.GRU + nn.Linear state dict, in PyTorch layout and gate
+// order, under these keys. .nam files and other capture formats are not
+// read; their weights have to be exported into this layout first.
+//   {
+//     "type": "lstm" | "gru",
+//     "hidden_size": 20,
+//     "weight_ih": [gates*H],           // input size 1 (flat or [[w], ...])
+//     "weight_hh": [[...] x gates*H],   // gates*H rows of H
+//     "bias_ih":   [gates*H], "bias_hh": [gates*H],
+//     "dense_weight": [H], "dense_bias": 0.0,
+//     "skip": true                      // output += input
+//   }
+// LSTM gates are (i, f, g, o), GRU gates (r, z, n).
+//
+// Kernel layout: all gates are fused into one gates*H pre-activation vector
+// (row count padded to kLanes), and W_hh is stored transposed so the
+// recurrent product is H axpy passes over contiguous columns. The whole model
+// lives in one contiguous arena; process() does not allocate.
+class RecurrentModel {
+public:
+    enum class Type { None, Lstm, Gru };
+
+    static constexpr int kLanes         = 8;
+    static constexpr int kMaxHiddenSize = 128;
+
+    RecurrentModel() = default;
+    RecurrentModel(const RecurrentModel&)            = delete;  // arena views
+    RecurrentModel& operator=(const RecurrentModel&) = delete;
+
+    // Returns false (and leaves the model empty) on malformed weights.
+    bool load(const nlohmann::json& j, std::string* error = nullptr);
+    nlohmann::json save() const { return m_source; }
+
+    void clear();
+    void reset();  // zero the hidden state
+
+    // Take over the recurrent state of a model with the same weights.
+    void copyStateFrom(const RecurrentModel& other);
+
+    bool isLoaded()   const { return m_type != Type::None; }
+    Type type()       const { return m_type; }
+    int  hiddenSize() const { return m_hidden; }
+
+    // Mono, one sample in / one sample out. in and out may alias.
+    void process(const float* in, float* out, int numSamples);
+
+private:
+    Type m_type   = Type::None;
+    int  m_hidden = 0;
+    int  m_gates  = 0;
+    int  m_rows   = 0;   // gates * hidden, padded to kLanes
+    bool m_skip   = false;
+    float m_denseBias = 0.0f;
+
+    // Arena views (offsets into m_arena)
+    std::vector<float> m_arena;
+    float* m_wIh    = nullptr;  // [rows]
+    float* m_wHhT   = nullptr;  // [hidden][rows] (transposed)
+    float* m_bIh    = nullptr;  // [rows]
+    float* m_bHh    = nullptr;  // [rows]
+    float* m_dense  = nullptr;  // [hidden]
+    float* m_zx     = nullptr;  // [rows] scratch: W_ih x + b_ih
+    float* m_zh     = nullptr;  // [rows] scratch: W_hh h + b_hh
+    float* m_h      = nullptr;  // [hidden]
+    float* m_c      = nullptr;  // [hidden] (LSTM cell)
+
+    nlohmann::json m_source;
+
+    void stepLstm(float x);
+    void stepGru(float x);
+};
+
+} // namespace gearboxfx
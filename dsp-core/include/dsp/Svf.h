@@ -0,0 +1,39 @@
+#pragma once
+
+namespace gearboxfx {
+
+// Trapezoidal (TPT) state-variable filter after Simper / Zavalishin.
+// The structure keeps its state in the integrators, so coefficients can
+// change every sample without the transients a direct-form biquad produces.
+//
+// Coefficients are stored in their "musical" form (g = tan(pi*fc/sr), k = 1/Q
+// and the output mix m0..m2) rather than as a1..a3: any point on a straight
+// line between two valid coefficient sets is itself a valid, stable filter,
+// so a ramp between control points can never blow up.
+struct SvfCoeffs {
+    float g = 0.0f, k = 1.414f;
+    float m0 = 1.0f, m1 = 0.0f, m2 = 0.0f;   // out = m0*x + m1*band + m2*low
+
+    static SvfCoeffs lowpass  (float freqHz, float q, float sr);
+    static SvfCoeffs highpass (float freqHz, float q, float sr);
+    static SvfCoeffs bell     (float freqHz, float q, float gainDb, float sr);
+    static SvfCoeffs lowShelf (float freqHz, float q, float gainDb, float sr);
+    static SvfCoeffs highShelf(float freqHz, float q, float gainDb, float sr);
+
+    // Per-sample increment that reaches `to` after n samples.
+    static SvfCoeffs step(const SvfCoeffs& from, const SvfCoeffs& to, int n);
+};
+
+struct SvfState {
+    float ic1 = 0.0f, ic2 = 0.0f;
+};
+
+// Filter n samples with fixed coefficients (in and out may alias).
+void svfBlock(SvfState& s, const float* in, float* out, int n, const SvfCoeffs& c);
+
+// Filter n samples while the coefficients move from c by dc per sample; the
+// last sample uses c + n*dc, i.e. the ramp ends exactly on the new target.
+void svfBlockRamp(SvfState& s, const float* in, float* out, int n,
+                  const SvfCoeffs& c, const SvfCoeffs& dc);
+
+} // namespace gearboxfx
@@ -0,0 +1,65 @@
+#pragma once
+#include "../EffectNode.h"
+#include "../dsp/HalfBand.h"
+#include <memory>
+
+namespace gearboxfx {
+
+// Runs any EffectNode at 2x / 4x / 8x the chain rate to keep the images of a
+// nonlinearity away from the audio band.
+// Upsampling and downsampling are cascades of polyphase half-band stages; the
+// first stage (steepest transition) uses 47 taps, later stages 19 taps.
+// A half-band stage's group delay is odd at its own rate, so from 4x on the
+// cascade delays by a fraction of a base-rate sample; a delay of under
+// `factor` samples at the oversampled rate pads it to a whole number, which
+// keeps the reported latency exact for parallel paths.
+// The wrapper mirrors the inner node's params and type id, so the chain, the
+// ParameterManager and the GUI see it as the original effect.
+// Preset: "oversampling": 2 | 4 | 8 on the node object.
+class OversampledNode : public EffectNode {
+public:
+    static constexpr int kMaxStages = 3;  // 8x
+    static constexpr int kMaxFactor = 1 << kMaxStages;
+
+    OversampledNode(std::shared_ptr<EffectNode> inner, int factor);
+
+    void process(AudioBufferView input, AudioBufferView output, int numSamples) override;
+    void reset() override;
+    int  latencySamples() const override;  // exact, see alignmentDelay()
+    float gainReductionDb() const override { return m_inner->gainReductionDb(); }
+
+    void loadData(const nlohmann::json& j) override { m_inner->loadData(j); }
+    nlohmann::json saveData() const override        { return m_inner->saveData(); }
+
+    void setTempoClock(const TempoClock* clock) override {
+        EffectNode::setTempoClock(clock);
+        m_inner->setTempoClock(clock);
+    }
+
+    int factor() const { return 1 << m_numStages; }
+    const std::shared_ptr<EffectNode>& inner() const { return m_inner; }
+
+    static bool isValidFactor(int f) { return f == 2 || f == 4 || f == 8; }
+
+protected:
+    void onPrepare(double sampleRate, int maxBlockSize) override;
+    void onParamChanged(const std::string& name, float value) override;
+
+private:
+    std::shared_ptr<EffectNode> m_inner;
+    int m_numStages = 1;
+
+    HalfBandStage m_up[2][kMaxStages];
+    HalfBandStage m_down[2][kMaxStages];
+
+    AudioBuffer m_osIn;     // inner node input, maxBlockSize * factor
+    AudioBuffer m_osOut;    // inner node output
+    AudioBuffer m_scratch;  // intermediate rates of the cascade
+
+    float m_alignHist[2][kMaxFactor] = {};  // samples held over by the alignment delay
+
+    int oversampledDelay() const;  // cascade + inner node, at the oversampled rate
+    int alignmentDelay() const;    // pads oversampledDelay() to a multiple of factor()
+};
+
+} // namespace gearboxfx
@@ -0,0 +1,51 @@
+#pragma once
+#include "../../EffectNode.h"
+#include "../../dsp/RecurrentModel.h"
+#include "../../RtHandoff.h"
+#include <string>
+
+namespace gearboxfx {
+
+// Neural amp capture: runs a recurrent (LSTM / GRU) model per sample.
+// Passes audio through unchanged until a model is loaded.
+// Models are built on the calling thread and handed to process() through an
+// RtHandoff, so a model can be swapped while audio runs; a load that fails
+// keeps the current model.
+// Params: input_db [-24,24], output_db [-24,24]
+// Data:   {"model": {...}} inline weights, or {"model_path": "amps/foo.json"}
+//         (relative to dataDir(); see RecurrentModel.h for the weight format)
+class NeuralAmpNode : public EffectNode {
+public:
+    NeuralAmpNode();
+    void process(AudioBufferView input, AudioBufferView output, int numSamples) override;
+    void reset() override;
+
+    // Allocates — call from the loader / GUI thread, not from process().
+    bool loadModel(const nlohmann::json& model);
+    bool loadModelFile(const std::string& path);
+
+    bool               hasModel()   const { return !m_modelSource.is_null(); }
+    const std::string& modelError() const { return m_error; }
+
+    void loadData(const nlohmann::json& j) override;
+    nlohmann::json saveData() const override;
+
+protected:
+    void onPrepare(double sampleRate, int maxBlockSize) override;
+    void onParamChanged(const std::string& name, float value) override;
+
+private:
+    struct Models {
+        RecurrentModel channel[2];  // identical weights, separate state
+    };
+
+    RtHandoff<Models> m_models;       // built off-thread, adopted in process()
+    nlohmann::json    m_modelSource;  // weights of the last good load (loader side)
+    std::string       m_modelPath;    // saved instead of the weights when set
+    std::string       m_error;
+
+    float m_inGain  = 1.0f;
+    float m_outGain = 1.0f;
+};
+
+} // namespace gearboxfx
@@ -1,21 +1,27 @@
 #pragma once
 #include "../../EffectNode.h"
+#include <atomic>
+#include <vector>
 
 namespace gearboxfx {
 
 // RMS compressor with soft knee.
+// Works per block: detector levels and gains are computed as whole-block
+// vector passes; only the envelope recursion is serial. While the envelope
+// stays below the knee the block is a constant makeup multiply.
 // Params: threshold_db, ratio, attack_ms, release_ms, makeup_db, knee_db
 class CompressorNode : public EffectNode {
 public:
     CompressorNode();
     void process(AudioBufferView input, AudioBufferView output, int numSamples) override;
+    float gainReductionDb() const override { return m_gainReductionDb.load(std::memory_order_relaxed); }
 
 protected:
     void onPrepare(double sampleRate, int maxBlockSize) override;
     void onParamChanged(const std::string& name, float value) override;
 
 private:
-    float m_thresholdLin = 1.0f;
+    float m_thresholdDb  = -18.0f;
     float m_ratio        = 4.0f;
     float m_makeupLin    = 1.0f;
     float m_kneeDb       = 6.0f;
@@ -23,8 +29,11 @@ private:
     float m_releaseCoeff = 0.9999f;
     float m_envelope     = 0.0f;  // dB envelope
 
-    float computeGainDb(float inputDb) const;
-    void  recalcCoeffs();
+    std::atomic<float> m_gainReductionDb{0.0f};  // deepest in the last block
+
+    std::vector<float> m_envBuf;   // per-sample detector level, then envelope (dB)
+
+    void recalcCoeffs();
 };
 
 } // namespace gearboxfx
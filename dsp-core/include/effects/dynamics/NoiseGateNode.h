@@ -1,14 +1,18 @@
 #pragma once
 #include "../../EffectNode.h"
+#include <atomic>
+#include <vector>
 
 namespace gearboxfx {
 
 // Noise gate with envelope follower (peak decay).
+// A gate that stays fully open for a block copies it; fully closed zero-fills.
 // Params: threshold_db, attack_ms, release_ms
 class NoiseGateNode : public EffectNode {
 public:
     NoiseGateNode();
     void process(AudioBufferView input, AudioBufferView output, int numSamples) override;
+    float gainReductionDb() const override { return m_gainReductionDb.load(std::memory_order_relaxed); }
 
 protected:
     void onPrepare(double sampleRate, int maxBlockSize) override;
@@ -21,6 +25,10 @@ private:
     float m_envelope     = 0.0f;
     float m_gate         = 0.0f;   // smooth gate state [0,1]
 
+    std::atomic<float> m_gainReductionDb{-96.0f};  // gate gain at the end of the last block
+
+    std::vector<float> m_target;   // per-sample gate target (0 or 1)
+
     void recalcCoeffs();
 };
 
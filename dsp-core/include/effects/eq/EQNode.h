@@ -1,40 +1,46 @@
 #pragma once
 #include "../../EffectNode.h"
+#include "../../dsp/ControlRate.h"
+#include "../../dsp/Svf.h"
 
 namespace gearboxfx {
 
 // 3-band parametric EQ: low-shelf (bass), peaking (mid), high-shelf (treble).
-// All bands implemented as biquad filters (Audio EQ Cookbook formulas).
+// Bands are TPT state-variable filters with Cookbook-equivalent responses.
+// Parameter changes glide (~10 ms) instead of jumping: band gains and the mid
+// frequency are smoothed once per control interval, coefficients are
+// recomputed there and ramped linearly across the samples in between. Once
+// the targets are reached the filters run with fixed coefficients.
 // Params: bass_db [-12,12], mid_db [-12,12], treble_db [-12,12], mid_freq [200,5000] Hz
 class EQNode : public EffectNode {
 public:
     EQNode();
     void process(AudioBufferView input, AudioBufferView output, int numSamples) override;
 
+    void setControlInterval(int samples);
+
 protected:
     void onPrepare(double sampleRate, int maxBlockSize) override;
     void onParamChanged(const std::string& name, float value) override;
 
 private:
-    struct BiquadCoeffs {
-        float b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;  // normalized (divided by a0)
-    };
-
-    struct BiquadState {
-        float x1 = 0, x2 = 0, y1 = 0, y2 = 0;
-    };
+    static constexpr int   kNumBands  = 3;
+    static constexpr float kSmoothMs  = 10.0f;
 
-    // Band indices: 0=bass, 1=mid, 2=treble
-    BiquadCoeffs m_coeffs[3];
-    BiquadState  m_state[3][2];  // [band][channel]
+    // Smoothed band settings: 0=bass dB, 1=mid dB, 2=treble dB, 3=mid freq
+    static constexpr int kNumSettings = 4;
+    float m_target[kNumSettings]  = {};
+    float m_current[kNumSettings] = {};
 
-    void recalcCoeffs();
+    int   m_interval    = kDefaultControlInterval;
+    float m_smoothCoeff = 0.0f;  // per control interval
 
-    static BiquadCoeffs makeLowShelf (float gainDb, float freqHz, float sr);
-    static BiquadCoeffs makePeaking  (float gainDb, float freqHz, float sr, float Q);
-    static BiquadCoeffs makeHighShelf(float gainDb, float freqHz, float sr);
+    SvfCoeffs m_coeffs[kNumBands];
+    SvfState  m_state[kNumBands][2];  // [band][channel]
 
-    static float processBiquad(float x, BiquadState& s, const BiquadCoeffs& c);
+    void readTargets();
+    void recalcSmoothing();
+    void computeCoeffs(SvfCoeffs* out) const;
 };
 
 } // namespace gearboxfx
@@ -1,14 +1,17 @@
 #pragma once
 #include "../../EffectNode.h"
+#include "../../dsp/Adaa.h"
 
 namespace gearboxfx {
 
 // Hard-clip distortion with asymmetric threshold + HP input + LP tone output.
-// Params: gain [0,1], tone [0,1], level [0,1], asymmetry [0,1]
+// antialias selects plain / 1st-order / 2nd-order ADAA for the clipper.
+// Params: gain [0,1], tone [0,1], level [0,1], asymmetry [0,1], antialias [0,2]
 class DistortionNode : public EffectNode {
 public:
     DistortionNode();
     void process(AudioBufferView input, AudioBufferView output, int numSamples) override;
+    int  latencySamples() const override { return m_adaaOrder == 2 ? 1 : 0; }
 
 protected:
     void onPrepare(double sampleRate, int maxBlockSize) override;
@@ -31,6 +34,9 @@ private:
     float m_lpState[2] = {0.0f, 0.0f};
     float m_lpCoeff    = 0.5f;
 
+    int  m_adaaOrder = 0;
+    Adaa m_adaa[2];
+
     void recalcThresholds();
     void recalcLpFilter();
 };
@@ -1,14 +1,17 @@
 #pragma once
 #include "../../EffectNode.h"
+#include "../../dsp/Adaa.h"
 
 namespace gearboxfx {
 
 // Tube-style overdrive: arctan soft clipper + IIR tone filter.
-// Params: gain [0,1], tone [0,1], level [0,1]
+// antialias selects plain / 1st-order / 2nd-order ADAA for the clipper.
+// Params: gain [0,1], tone [0,1], level [0,1], antialias [0,2]
 class OverdriveNode : public EffectNode {
 public:
     OverdriveNode();
     void process(AudioBufferView input, AudioBufferView output, int numSamples) override;
+    int  latencySamples() const override { return m_adaaOrder == 2 ? 1 : 0; }
 
 protected:
     void onPrepare(double sampleRate, int maxBlockSize) override;
@@ -23,6 +26,9 @@ private:
     float m_toneState[2] = {0.0f, 0.0f};
     float m_toneCoeff    = 0.5f;  // a1 coefficient
 
+    int  m_adaaOrder = 0;
+    Adaa m_adaa[2];
+
     void recalcToneFilter();
 };
 
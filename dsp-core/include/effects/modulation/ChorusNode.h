@@ -1,11 +1,15 @@
 #pragma once
 #include "../../EffectNode.h"
+#include "../../dsp/Lfo.h"
+#include "../../dsp/ModulatedDelay.h"
 #include <vector>
 
 namespace gearboxfx {
 
 // Multi-voice chorus using modulated delay lines (LFO-driven).
-// Params: rate [0.1,8] Hz, depth [0,1], mix [0,1], voices [1,4]
+// All voices are read in one ModulatedDelay::tapSum call per sample and
+// channel, so 8 voices cost about the same as 1.
+// Params: rate [0.1,8] Hz, depth [0,1], mix [0,1], voices [1,8]
 class ChorusNode : public EffectNode {
 public:
     ChorusNode();
@@ -16,23 +20,22 @@ protected:
     void onParamChanged(const std::string& name, float value) override;
 
 private:
-    static constexpr int kMaxVoices    = 4;
-    static constexpr int kMaxDelaySamp = 4096;  // ~85ms @ 48kHz
+    static constexpr int   kMaxVoices = ModulatedDelay::kLanes;
+    static constexpr float kMaxDelayMs = 35.0f;  // 20 ms centre ± 10 ms, plus margin
 
     float m_rate   = 0.5f;
     float m_depth  = 0.5f;
     float m_mix    = 0.5f;
     int   m_voices = 2;
 
-    // Circular delay buffer (shared across voices, per channel)
-    std::vector<float> m_delayBuf[2];  // channel 0, 1
-    int                m_writePos = 0;
+    ModulatedDelay m_delay;
 
-    // LFO phases for each voice
-    float m_lfoPhase[kMaxVoices] = {};
-    float m_lfoIncrement = 0.0f;
+    // One LFO per voice, phases spread evenly over the cycle
+    Lfo                m_lfo[kMaxVoices];
+    std::vector<float> m_lfoBuf[kMaxVoices];
+    std::vector<float> m_tapDelays;  // [sample][lane], maxBlockSize * kMaxVoices
 
-    float readDelayLinear(const std::vector<float>& buf, float delaySamps) const;
+    void spreadVoicePhases();
 };
 
 } // namespace gearboxfx
@@ -1,5 +1,7 @@
 #pragma once
 #include "../../EffectNode.h"
+#include "../../dsp/Lfo.h"
+#include "../../dsp/ModulatedDelay.h"
 #include <vector>
 
 namespace gearboxfx {
@@ -17,14 +19,12 @@ protected:
     void onParamChanged(const std::string& name, float value) override;
 
 private:
-    static constexpr int kMaxDelaySamp = 2048;  // ~42ms @ 48kHz — plenty for flanger
+    static constexpr float kMaxDelayMs = 8.0f;  // 4 ms centre ± 3 ms, plus margin
 
-    std::vector<float> m_delayBuf[2];
-    int   m_writePos     = 0;
-    float m_lfoPhase     = 0.0f;
-    float m_lfoIncrement = 0.0f;
+    ModulatedDelay m_delay;
 
-    float readDelayLinear(const std::vector<float>& buf, float delaySamps) const;
+    Lfo                m_lfo;
+    std::vector<float> m_lfoBuf;
 };
 
 } // namespace gearboxfx
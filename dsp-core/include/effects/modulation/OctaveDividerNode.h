@@ -0,0 +1,43 @@
+#pragma once
+#include "../../EffectNode.h"
+
+namespace gearboxfx {
+
+// Analog-style octave divider (a handful of operations per sample).
+//   tracking: the input goes through a 2-pole low-pass whose cutoff follows
+//             the fundamental, measured from the interval between zero crossings
+//   sub:      a flip-flop toggles on each rising crossing (Schmitt trigger,
+//             hysteresis relative to the envelope), giving a square at f/2;
+//             scaled by the envelope and smoothed by a second tracking low-pass
+//   up:       full-wave rectified fundamental (2f), DC removed
+// Monophonic: like the pedals it models, chords confuse the divider.
+// Params: sub [0,1], up [0,1], dry [0,1]
+class OctaveDividerNode : public EffectNode {
+public:
+    OctaveDividerNode();
+    void process(AudioBufferView input, AudioBufferView output, int numSamples) override;
+
+protected:
+    void onPrepare(double sampleRate, int maxBlockSize) override;
+
+private:
+    struct Voice {
+        float lp1 = 0.0f, lp2 = 0.0f;   // tracking low-pass
+        float env = 0.0f;               // envelope follower
+        float subLp = 0.0f;             // sub-octave smoothing
+        float upLp  = 0.0f;             // DC estimate of the rectified signal
+        float coeff = 0.0f;             // tracking low-pass coefficient
+        int   sinceCross = 0;           // samples since the last rising crossing (capped)
+        bool  high = false;             // Schmitt trigger state
+        float flip = 1.0f;              // flip-flop output, +-1
+    };
+
+    double m_sr = 48000.0;
+    float  m_envCoeff = 0.0f;
+    float  m_dcCoeff  = 0.0f;
+    Voice  m_voice[2];
+
+    float trackingCoeff(float hz) const;
+};
+
+} // namespace gearboxfx
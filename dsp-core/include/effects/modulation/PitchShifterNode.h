@@ -1,15 +1,25 @@
 #pragma once
 #include "../../EffectNode.h"
+#include "../../dsp/PhaseVocoder.h"
+#include "../../dsp/PsolaShifter.h"
 #include <vector>
 
 namespace gearboxfx {
 
-// Granular pitch shifter using two overlapping read heads with Hann-window crossfade.
-// Params: semitones [-12,12], mix [0,1]
+// Pitch shifter with two engines:
+//   mode 0: granular — two overlapping read heads with Hann-window crossfade
+//           (mono, no latency, best on single notes)
+//   mode 1: phase vocoder with phase locking — stereo, clean on chords;
+//           latency fft_size samples (the overlap does not change it)
+//   mode 2: PSOLA — pitch-synchronous grains at detected pitch marks;
+//           monophonic (whammy), latency under 10 ms
+// Params: semitones [-12,12], mix [0,1], mode [0,2],
+//         fft_size [512,4096] (power of two), overlap [2,8] (power of two)
 class PitchShifterNode : public EffectNode {
 public:
     PitchShifterNode();
     void process(AudioBufferView input, AudioBufferView output, int numSamples) override;
+    int  latencySamples() const override;
 
 protected:
     void onPrepare(double sampleRate, int maxBlockSize) override;
@@ -21,9 +31,29 @@ private:
     std::vector<float> m_buf[2];  // per-channel circular buffer
     int   m_writePos = 0;
     float m_readPos[2] = {};       // fractional read position per head (0..kGrainSize)
+    float m_window[kGrainSize + 1] = {};  // Hann over one grain (+ guard point)
+
+    PhaseVocoder       m_vocoder;
+    std::vector<float> m_wet[2];
+    bool               m_dualMono = true;  // last vocoder block ran channel 0 only
+
+    PsolaShifter       m_psola;
+
+    // Dry input history, so the dry part of the mix lines up with a delayed
+    // wet signal. Power-of-two length, enough for the longest latency plus a block.
+    std::vector<float> m_dry[2];
+    int                m_dryMask = 0;
+    int                m_dryPos  = 0;
 
     // Hermite cubic interpolation
     float readHermite(const std::vector<float>& buf, float pos) const;
+
+    void processGranular(AudioBufferView input, AudioBufferView output, int numSamples);
+    void processVocoder (AudioBufferView input, AudioBufferView output, int numSamples);
+    void processPsola   (AudioBufferView input, AudioBufferView output, int numSamples);
+    void mixDelayedDry  (AudioBufferView input, AudioBufferView output, const float* const* wet,
+                         int numWet, int numSamples, int delay);
+    int  mode() const { return static_cast<int>(getParam("mode") + 0.5f); }
 };
 
 } // namespace gearboxfx
@@ -1,10 +1,14 @@
 #pragma once
 #include "../../EffectNode.h"
+#include "../../dsp/Lfo.h"
+#include <vector>
 
 namespace gearboxfx {
 
 // Amplitude modulation tremolo.
-// Params: rate [0.1,20] Hz, depth [0,1], waveform [0=sine,1=triangle,2=square]
+// Params: rate [0.1,20] Hz, depth [0,1],
+//         waveform [0=sine,1=triangle,2=square,3=sample&hold,4=random],
+//         sync [0=free,1=1/1,2=1/2,3=1/4,4=1/8,5=1/8T,6=1/16] (follows the engine tempo)
 class TremoloNode : public EffectNode {
 public:
     TremoloNode();
@@ -15,15 +19,13 @@ protected:
     void onParamChanged(const std::string& name, float value) override;
 
 private:
-    float m_rate      = 5.0f;
-    float m_depth     = 0.7f;
-    int   m_waveform  = 0;  // 0=sine, 1=triangle, 2=square
+    float m_depth    = 0.7f;
+    int   m_division = 0;  // TempoClock division index, 0 = free running
 
-    float m_phase     = 0.0f;
-    float m_increment = 0.0f;
+    Lfo                m_lfo;
+    std::vector<float> m_gainBuf;  // LFO output, then per-sample gain
 
-    float computeLfo(float phase) const;
-    void  recalcIncrement();
+    void updateLfo();
 };
 
 } // namespace gearboxfx
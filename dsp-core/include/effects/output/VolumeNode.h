@@ -1,26 +1,35 @@
 #pragma once
 #include "../../EffectNode.h"
+#include <atomic>
+#include "../../dsp/LookaheadLimiter.h"
 
 namespace gearboxfx {
 
-// Output volume control with soft-knee brick-wall limiter.
-// Params: volume_db [-60,12], limiter_threshold_db [-18,0]
+// Output volume control with lookahead true-peak brick-wall limiter.
+// The limiter delays the signal by its lookahead (reported as latency) so
+// gain reduction is in place before a peak arrives; output never exceeds
+// the threshold.
+// Params: volume_db [-60,12], limiter_threshold_db [-18,0], lookahead_ms [0.5,5]
 class VolumeNode : public EffectNode {
 public:
     VolumeNode();
     void process(AudioBufferView input, AudioBufferView output, int numSamples) override;
+    int  latencySamples() const override { return m_limiter.latencySamples(); }
 
 protected:
+    void onPrepare(double sampleRate, int maxBlockSize) override;
     void onParamChanged(const std::string& name, float value) override;
 
 private:
-    float m_linearGain = 1.0f;
-    float m_limThresh  = 1.0f;   // linear threshold
+    static constexpr float kMaxLookaheadMs = 5.0f;
+    static constexpr float kReleaseMs      = 100.0f;
 
-    // Envelope follower for limiter gain reduction (per-channel)
-    float m_envState[2] = {};
+    std::atomic<float> m_linearGain{1.0f};  // written by onParamChanged
+
+    LookaheadLimiter m_limiter;
 
     void recalcGains();
+    int  lookaheadSamples() const;
 };
 
 } // namespace gearboxfx
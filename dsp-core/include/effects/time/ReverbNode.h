@@ -1,11 +1,14 @@
 #pragma once
 #include "../../EffectNode.h"
+#include <algorithm>
 #include <vector>
 #include <array>
 
 namespace gearboxfx {
 
 // Freeverb-style reverb: 4 damped comb filters + 2 allpass filters.
+// Filter buffers are allocated for the largest size in prepare(); a size
+// change only moves the active length, so it is safe while audio runs.
 // Params: size [0,1], decay [0,1], damping [0,1], pre_delay_ms [0,100], mix [0,1]
 class ReverbNode : public EffectNode {
 public:
@@ -31,20 +34,24 @@ private:
     static constexpr float kAllpassBaseMs[kNumAllpass] = {5.0f, 1.7f};
 
     struct CombFilter {
-        std::vector<float> buf;
+        std::vector<float> buf;      // longest length, active part [0, len)
+        int   len      = 1;
         int   pos      = 0;
         float feedback = 0.5f;
         float damp     = 0.5f;
         float store    = 0.0f;
-        void resize(int n) { buf.assign(n, 0.0f); }
+        void allocate(int n)  { buf.assign(n, 0.0f); pos = 0; store = 0.0f; }
+        void setLength(int n) { len = std::max(1, std::min(n, static_cast<int>(buf.size()))); }
         float process(float x);
     };
 
     struct AllpassFilter {
-        std::vector<float> buf;
+        std::vector<float> buf;      // longest length, active part [0, len)
+        int   len      = 1;
         int   pos      = 0;
         float feedback = 0.5f;
-        void resize(int n) { buf.assign(n, 0.0f); }
+        void allocate(int n)  { buf.assign(n, 0.0f); pos = 0; }
+        void setLength(int n) { len = std::max(1, std::min(n, static_cast<int>(buf.size()))); }
         float process(float x);
     };
 
@@ -58,6 +65,8 @@ private:
     int                m_preDelaySamples = 0;
 
     void rebuildFilters();
+    static int combLength(int i, float sizeScale, double sampleRate);
+    static int allpassLength(int i, float sizeScale, double sampleRate);
 };
 
 } // namespace gearboxfx
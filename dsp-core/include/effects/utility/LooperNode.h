@@ -0,0 +1,146 @@
+#pragma once
+#include "../../EffectNode.h"
+#include "../../SpscQueue.h"
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gearboxfx {
+
+enum class LooperCommand { Record, Play, Overdub, Stop, Undo, Redo, Clear };
+enum class LooperState   { Empty, Recording, Playing, Overdubbing, Stopped };
+
+// "record", "play", "overdub", "stop", "undo", "redo", "clear"
+bool        parseLooperCommand(const std::string& name, LooperCommand& cmd);
+const char* looperStateName(LooperState state);
+
+// Record / overdub / play looper (stereo loop, input passes through).
+//   memory:  the loop lives in kChunkFrames-sized chunks carved out of one
+//            pool, two slots per chunk; recording only picks slots, process()
+//            never allocates. The pool, the spill file and its thread are
+//            set up by the first Record command (on the control thread) and
+//            released by prepare(), so a looper that is never used costs nothing
+//   overdub: the first time a pass enters a chunk, the chunk is copied into
+//            its spare slot and the two are swapped (copy-on-write), so undo
+//            and redo just swap the touched chunks back — no audio is copied
+//   spill:   past the RAM budget, recording carries on into a few stream
+//            buffers that a background thread writes to a spill file; when
+//            playing, the same thread reads that tail ahead. Requests and
+//            completions travel through lock-free SPSC queues. Overdub and
+//            undo cover the in-RAM part of the loop; the tail plays as recorded.
+// Transport commands come from one control thread via command() and take
+// effect at the start of the next block.
+// Params: level [0,1] (loop playback level)
+class LooperNode : public EffectNode {
+public:
+    static constexpr int    kChunkFrames     = 4096;
+    static constexpr int    kStreamBuffers   = 8;
+    static constexpr double kMaxSpillSeconds = 600.0;
+
+    LooperNode();
+    ~LooperNode() override;
+
+    void process(AudioBufferView input, AudioBufferView output, int numSamples) override;
+
+    // ── Control thread ───────────────────────────────────────────────────────
+    // Record allocates the loop memory first if prepare() released it.
+    bool        command(LooperCommand cmd);
+    LooperState state()          const { return m_state.load(std::memory_order_acquire); }
+    double      lengthSeconds()  const { return m_publishedLength.load(std::memory_order_acquire) / m_sampleRate; }
+    int         spillUnderruns() const { return m_underruns.load(std::memory_order_relaxed); }
+    int         spillPending()   const { return m_diskPending.load(std::memory_order_acquire); }
+    size_t      allocatedBytes() const;
+
+    // RAM budget and spill file (empty path = anonymous temp file);
+    // both take effect at the next prepare().
+    void setMemorySeconds(double seconds)      { m_memorySeconds = seconds; }
+    void setSpillPath(const std::string& path) { m_spillPath = path; }
+    void setDiskSpill(bool enabled)            { m_spillEnabled = enabled; }
+
+protected:
+    void onPrepare(double sampleRate, int maxBlockSize) override;
+
+private:
+    static constexpr int kChunkFloats = 2 * kChunkFrames;  // planar L, R
+
+    struct SpillRequest {
+        int       buffer = 0;
+        long long chunk  = 0;
+        bool      write  = false;
+        unsigned  gen    = 0;
+    };
+
+    double      m_memorySeconds = 60.0;
+    std::string m_spillPath;
+    bool        m_spillEnabled  = true;
+
+    // ── RAM chunks ───────────────────────────────────────────────────────────
+    bool                  m_allocated = false;  // control thread: storage is set up
+    std::vector<float>    m_pool;      // 2 slots per RAM chunk
+    int                   m_ramChunks = 0;
+    std::vector<int>      m_cur, m_alt;  // pool slot per chunk: in use / spare
+    std::vector<unsigned> m_forkPass;    // pass that last forked each chunk
+    std::vector<int>      m_touched;     // chunks forked by the last pass
+    int                   m_numTouched = 0;
+    unsigned              m_pass   = 0;
+    bool                  m_undone = false;
+
+    // ── Transport ────────────────────────────────────────────────────────────
+    SpscQueue<LooperCommand> m_commands{16};
+    std::atomic<LooperState> m_state{LooperState::Empty};
+    std::atomic<long long>   m_publishedLength{0};
+    long long                m_length = 0;  // frames, set when the first pass closes
+    long long                m_pos    = 0;
+
+    // ── Disk spill ───────────────────────────────────────────────────────────
+    std::vector<float> m_stream;             // kStreamBuffers chunk buffers
+    std::vector<float> m_scratch;            // absorbs audio when no buffer is free
+    int       m_free[kStreamBuffers] = {};
+    int       m_numFree = 0;
+    struct Ready { int buffer; long long chunk; };
+    Ready     m_ready[kStreamBuffers] = {};  // read-ahead FIFO
+    int       m_readyHead = 0, m_readyCount = 0;
+    int       m_inFlight  = 0;               // reads requested, not yet returned
+    int       m_recBuffer  = -1;
+    int       m_playBuffer = -1;
+    long long m_playChunk  = -1;
+    long long m_fetchChunk = 0;
+    long long m_maxChunks  = 0;
+    unsigned  m_gen = 0;                     // reads from older generations are dropped
+
+    SpscQueue<SpillRequest> m_toDisk{kStreamBuffers};
+    SpscQueue<SpillRequest> m_fromDisk{kStreamBuffers};
+    std::thread       m_worker;
+    std::atomic<bool> m_running{false};
+    std::FILE*        m_file = nullptr;
+    bool              m_spilling = false;  // audio thread: m_file as of the last Record
+    std::atomic<int>  m_underruns{0};
+    std::atomic<int>  m_diskPending{0};    // requests pushed, not yet completed
+
+    void allocate();
+    void release();
+    bool requestDisk(const SpillRequest& r);
+
+    void applyCommand(LooperCommand cmd);
+    void closeLoop();
+    void clearLoop();
+    void restartReadAhead();
+    void swapTouched();
+
+    float* recordTarget(long long chunk);
+    void   flushRecordBuffer(long long chunk);
+    float* playSource(long long chunk);
+    float* fork(long long chunk);
+
+    void drainDisk();
+    void readAhead();
+    void releaseBuffer(int buffer) { m_free[m_numFree++] = buffer; }
+
+    void startWorker();
+    void stopWorker();
+    void workerLoop();
+};
+
+} // namespace gearboxfx
@@ -0,0 +1,113 @@
+#include "AudioIOStats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace gearboxfx {
+
+int AudioIOStats::bucketFor(std::int64_t ns) {
+    if (ns < (std::int64_t{1} << kMinOctave)) return 0;
+    const int octave = std::ilogb(static_cast<double>(ns));  // floor(log2)
+    const int sub    = static_cast<int>((ns >> (octave - 2)) & (kBucketsPerOctave - 1));
+    return std::min(kBuckets - 1, (octave - kMinOctave) * kBucketsPerOctave + sub);
+}
+
+double AudioIOStats::Histogram::bucketUpperUs(int bucket) {
+    const int octave = kMinOctave + bucket / kBucketsPerOctave;
+    const int sub    = bucket % kBucketsPerOctave;
+    return std::ldexp(1.0 + (sub + 1) / static_cast<double>(kBucketsPerOctave), octave) * 1e-3;
+}
+
+std::uint64_t AudioIOStats::Histogram::total() const {
+    std::uint64_t n = 0;
+    for (auto c : count) n += c;
+    return n;
+}
+
+double AudioIOStats::Histogram::percentileUs(double p) const {
+    const std::uint64_t n = total();
+    if (n == 0) return 0.0;
+    const auto rank = static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(n)));
+    std::uint64_t seen = 0;
+    for (int b = 0; b < kBuckets; ++b) {
+        seen += count[b];
+        if (seen >= std::max<std::uint64_t>(rank, 1)) return bucketUpperUs(b);
+    }
+    return bucketUpperUs(kBuckets - 1);
+}
+
+void AudioIOStats::setPeriod(double sampleRate, int blockSize) {
+    const double periodNs = blockSize * 1e9 / (sampleRate > 0.0 ? sampleRate : 48000.0);
+    m_periodNs.store(static_cast<std::int64_t>(periodNs), std::memory_order_relaxed);
+    m_lateNs.store(static_cast<std::int64_t>(periodNs * kLateFactor), std::memory_order_relaxed);
+    m_lastBegin = 0;  // a new stream: the first interval starts from its first callback
+}
+
+AudioIOStats::Snapshot AudioIOStats::snapshot() const {
+    constexpr auto r = std::memory_order_relaxed;
+    Snapshot s;
+    s.callbacks     = m_callbacks.load(r);
+    s.overruns      = m_overruns.load(r);
+    s.late          = m_late.load(r);
+    s.underflows    = m_underflows.load(r);
+    s.overflows     = m_overflows.load(r);
+    s.lockSkips     = m_lockSkips.load(r);
+    s.maxDurationUs = m_maxDurationNs.load(r) * 1e-3;
+    s.maxIntervalUs = m_maxIntervalNs.load(r) * 1e-3;
+    const std::int64_t period = m_periodNs.load(r);
+    s.periodUs      = (period == INT64_MAX) ? 0.0 : period * 1e-3;
+    for (int b = 0; b < kBuckets; ++b) {
+        s.duration.count[b] = m_duration[b].load(r);
+        s.interval.count[b] = m_interval[b].load(r);
+    }
+    return s;
+}
+
+void AudioIOStats::reset() {
+    constexpr auto r = std::memory_order_relaxed;
+    for (Counter* c : { &m_callbacks, &m_overruns, &m_late, &m_underflows, &m_overflows, &m_lockSkips })
+        c->store(0, r);
+    m_maxDurationNs.store(0, r);
+    m_maxIntervalNs.store(0, r);
+    for (int b = 0; b < kBuckets; ++b) {
+        m_duration[b].store(0, r);
+        m_interval[b].store(0, r);
+    }
+}
+
+AudioIOStats::Snapshot AudioIOStats::Snapshot::operator-(const Snapshot& earlier) const {
+    Snapshot d = *this;
+    d.callbacks  -= earlier.callbacks;
+    d.overruns   -= earlier.overruns;
+    d.late       -= earlier.late;
+    d.underflows -= earlier.underflows;
+    d.overflows  -= earlier.overflows;
+    d.lockSkips  -= earlier.lockSkips;
+    for (int b = 0; b < kBuckets; ++b) {
+        d.duration.count[b] -= earlier.duration.count[b];
+        d.interval.count[b] -= earlier.interval.count[b];
+    }
+    return d;
+}
+
+// Percentiles are bucket edges, so they are capped at the exact maximum.
+std::string AudioIOStats::Snapshot::format() const {
+    char line[320];
+    std::snprintf(line, sizeof(line),
+                  "%llu callbacks (period %.0f us) | overruns %llu, lock skips %llu, "
+                  "underflows %llu, overflows %llu, late %llu | duration p50 %.0f p99 %.0f max %.0f us | "
+                  "interval p50 %.0f p99 %.0f max %.0f us",
+                  static_cast<unsigned long long>(callbacks), periodUs,
+                  static_cast<unsigned long long>(overruns),
+                  static_cast<unsigned long long>(lockSkips),
+                  static_cast<unsigned long long>(underflows),
+                  static_cast<unsigned long long>(overflows),
+                  static_cast<unsigned long long>(late),
+                  std::min(duration.percentileUs(50), maxDurationUs),
+                  std::min(duration.percentileUs(99), maxDurationUs), maxDurationUs,
+                  std::min(interval.percentileUs(50), maxIntervalUs),
+                  std::min(interval.percentileUs(99), maxIntervalUs), maxIntervalUs);
+    return line;
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,192 @@
+#include "ChainProfiler.h"
+#include "EffectChain.h"
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+namespace gearboxfx {
+
+void ChainProfiler::Window::add(float v) {
+    if (values.empty()) values.assign(kWindowBlocks, 0.0f);
+    values[pos] = v;
+    pos   = (pos + 1) % kWindowBlocks;
+    count = std::min(count + 1, kWindowBlocks);
+}
+
+ChainProfiler::Stats ChainProfiler::Window::stats(float scale) const {
+    Stats s;
+    s.count = count;
+    if (count == 0) return s;
+
+    std::vector<float> v(values.begin(), values.begin() + count);
+    double sum = 0.0;
+    for (float x : v) sum += x;
+    auto p99 = v.begin() + std::min(count - 1, count * 99 / 100);
+    std::nth_element(v.begin(), p99, v.end());
+
+    s.p99  = *p99 * scale;
+    s.min  = *std::min_element(v.begin(), v.end()) * scale;
+    s.max  = *std::max_element(v.begin(), v.end()) * scale;
+    s.mean = sum / count * scale;
+    return s;
+}
+
+bool ChainProfiler::beginCounters() {
+    HwState state = m_hwState.load(std::memory_order_relaxed);
+    if (state == HwState::Closed) {
+        // First hardware block: open on this (the chain's) thread.
+        state = m_perf.open() ? HwState::Open : HwState::Failed;
+        m_hwState.store(state, std::memory_order_release);
+    }
+    return state == HwState::Open && m_perf.read(m_hwLast);
+}
+
+void ChainProfiler::readCounters(PerfCounters::Values& delta) {
+    PerfCounters::Values now;
+    if (!m_perf.read(now)) {
+        std::fill(std::begin(delta), std::end(delta), 0);
+        return;
+    }
+    for (int c = 0; c < PerfCounters::kNumCounters; ++c) {
+        delta[c]    = now[c] - m_hwLast[c];
+        m_hwLast[c] = now[c];
+    }
+}
+
+double ChainProfiler::TypeCounters::ipc() const {
+    const auto cycles = value[PerfCounters::Cycles];
+    return cycles ? static_cast<double>(value[PerfCounters::Instructions]) / cycles : 0.0;
+}
+
+double ChainProfiler::TypeCounters::perSample(PerfCounters::Counter c) const {
+    return samples ? static_cast<double>(value[c]) / samples : 0.0;
+}
+
+void ChainProfiler::collect() {
+    const std::uint32_t generation = m_generation.load(std::memory_order_acquire);
+    if (generation != m_nodesGeneration) {
+        m_nodes.clear();
+        m_counters.clear();
+        m_nodesGeneration = generation;
+    }
+
+    BlockRecord r;
+    while (m_ring.pop(r)) {
+        // Node pointers of an older chain may be dangling or reused
+        const int numNodes = (r.generation == generation) ? r.numNodes : 0;
+        for (int i = 0; i < numNodes; ++i) {
+            m_nodes[r.node[i]].add(static_cast<float>(r.ns[i]));
+            if (r.hasHw) {
+                NodeCounters& nc = m_counters[r.node[i]];
+                nc.samples += static_cast<std::uint64_t>(r.numSamples);
+                for (int c = 0; c < PerfCounters::kNumCounters; ++c)
+                    nc.value[c] += r.hw[i][c];
+            }
+        }
+        m_chain.add(static_cast<float>(r.totalNs));
+        m_lastLoad = r.deadlineNs > 0.0f ? 100.0 * r.totalNs / r.deadlineNs : 0.0;
+        m_load.add(static_cast<float>(m_lastLoad));
+        m_deadlineUs = r.deadlineNs * 1e-3;
+    }
+}
+
+void ChainProfiler::clear() {
+    BlockRecord r;
+    while (m_ring.pop(r)) {}
+    m_nodes.clear();
+    m_counters.clear();
+    m_chain = Window{};
+    m_load  = Window{};
+    m_lastLoad = 0.0;
+}
+
+ChainProfiler::Report ChainProfiler::report(const EffectChain& chain) const {
+    Report rep;
+    rep.chain       = m_chain.stats(1e-3f);
+    rep.loadPercent = m_load.stats(1.0f);
+    rep.deadlineUs  = m_deadlineUs;
+
+    double total = 0.0;
+    for (const auto& node : chain.nodes()) {
+        NodeReport n;
+        n.id     = node->id();
+        n.typeId = node->typeId();
+        auto it = m_nodes.find(node.get());
+        if (it != m_nodes.end()) n.time = it->second.stats(1e-3f);
+        total += n.time.mean;
+        rep.nodes.push_back(std::move(n));
+    }
+    for (auto& n : rep.nodes)
+        n.share = total > 0.0 ? n.time.mean / total : 0.0;
+
+    // Hardware counters, grouped by node type in chain order
+    const HwState hw = m_hwState.load(std::memory_order_acquire);
+    if (hw == HwState::Failed) rep.counterStatus = m_perf.error();
+    if (hw != HwState::Open) return rep;
+    for (int c = 0; c < PerfCounters::kNumCounters; ++c)
+        rep.hasCounter[c] = m_perf.has(static_cast<PerfCounters::Counter>(c));
+
+    for (const auto& node : chain.nodes()) {
+        auto it = m_counters.find(node.get());
+        if (it == m_counters.end()) continue;
+        auto type = std::find_if(rep.types.begin(), rep.types.end(),
+            [&](const TypeCounters& t) { return t.typeId == node->typeId(); });
+        if (type == rep.types.end()) {
+            rep.types.push_back(TypeCounters{});
+            type = rep.types.end() - 1;
+            type->typeId = node->typeId();
+        }
+        type->samples += it->second.samples;
+        for (int c = 0; c < PerfCounters::kNumCounters; ++c)
+            type->value[c] += it->second.value[c];
+    }
+    return rep;
+}
+
+std::string ChainProfiler::Report::format() const {
+    std::string out;
+    char line[256];
+
+    std::snprintf(line, sizeof(line),
+        "DSP load: mean %.2f%%  p99 %.2f%%  max %.2f%%  (deadline %.0f us, %d blocks)\n",
+        loadPercent.mean, loadPercent.p99, loadPercent.max, deadlineUs, chain.count);
+    out += line;
+    std::snprintf(line, sizeof(line), "%-24s %-26s %9s %9s %9s %9s %7s\n",
+                  "node", "type", "min us", "mean us", "p99 us", "max us", "share");
+    out += line;
+    for (const auto& n : nodes) {
+        std::snprintf(line, sizeof(line), "%-24s %-26s %9.2f %9.2f %9.2f %9.2f %6.1f%%\n",
+                      n.id.c_str(), n.typeId.c_str(), n.time.min, n.time.mean,
+                      n.time.p99, n.time.max, 100.0 * n.share);
+        out += line;
+    }
+    std::snprintf(line, sizeof(line), "%-24s %-26s %9.2f %9.2f %9.2f %9.2f\n",
+                  "chain", "", chain.min, chain.mean, chain.p99, chain.max);
+    out += line;
+
+    if (!counterStatus.empty()) {
+        out += "\nHardware counters unavailable: " + counterStatus + "\n";
+        return out;
+    }
+    if (types.empty()) return out;
+
+    // Per sample, so node types compare regardless of block size or run length
+    auto cell = [&](const TypeCounters& t, PerfCounters::Counter c) {
+        char buf[32];
+        if (hasCounter[c]) std::snprintf(buf, sizeof(buf), "%10.2f", t.perSample(c));
+        else               std::snprintf(buf, sizeof(buf), "%10s", "n/a");
+        return std::string(buf);
+    };
+    std::snprintf(line, sizeof(line), "\n%-26s %6s %10s %10s %10s %10s   (per sample)\n",
+                  "type", "IPC", "cycles", "L1D miss", "LLC miss", "br miss");
+    out += line;
+    for (const auto& t : types) {
+        std::snprintf(line, sizeof(line), "%-26s %6.2f ", t.typeId.c_str(), t.ipc());
+        out += line;
+        out += cell(t, PerfCounters::Cycles) + " " + cell(t, PerfCounters::L1dMisses) + " "
+             + cell(t, PerfCounters::LlcMisses) + " " + cell(t, PerfCounters::BranchMisses) + "\n";
+    }
+    return out;
+}
+
+} // namespace gearboxfx
@@ -1,4 +1,5 @@
 #include "EffectChain.h"
+#include "Telemetry.h"
 #include <algorithm>
 #include <cstring>
 
@@ -13,14 +14,17 @@ void EffectChain::prepare(double sampleRate, int maxBlockSize) {
 
     for (auto& node : m_nodes)
         node->prepare(sampleRate, maxBlockSize);
+    m_profiler.chainChanged();
 }
 
 void EffectChain::addNode(std::shared_ptr<EffectNode> node) {
+    node->setTempoClock(m_clock);
     node->prepare(m_sampleRate, m_maxBlockSize);
     m_nodes.push_back(std::move(node));
 }
 
 void EffectChain::insertNode(int index, std::shared_ptr<EffectNode> node) {
+    node->setTempoClock(m_clock);
     node->prepare(m_sampleRate, m_maxBlockSize);
     index = std::max(0, std::min(index, (int)m_nodes.size()));
     m_nodes.insert(m_nodes.begin() + index, std::move(node));
@@ -32,6 +36,7 @@ bool EffectChain::removeNode(const std::string& effectId) {
     if (it == m_nodes.end()) return false;
     (*it)->reset();
     m_nodes.erase(it);
+    m_profiler.chainChanged();
     return true;
 }
 
@@ -40,8 +45,10 @@ bool EffectChain::replaceNode(const std::string& effectId, std::shared_ptr<Effec
         [&](const auto& n){ return n->id() == effectId; });
     if (it == m_nodes.end()) return false;
     (*it)->reset();
+    newNode->setTempoClock(m_clock);
     newNode->prepare(m_sampleRate, m_maxBlockSize);
     *it = std::move(newNode);
+    m_profiler.chainChanged();
     return true;
 }
 
@@ -54,6 +61,19 @@ std::shared_ptr<EffectNode> EffectChain::findNode(const std::string& effectId) c
 void EffectChain::clear() {
     for (auto& n : m_nodes) n->reset();
     m_nodes.clear();
+    m_profiler.chainChanged();
+}
+
+void EffectChain::setTempoClock(const TempoClock* clock) {
+    m_clock = clock;
+    for (auto& n : m_nodes) n->setTempoClock(clock);
+}
+
+int EffectChain::latencySamples() const {
+    int total = 0;
+    for (auto& n : m_nodes)
+        if (n->isEnabled()) total += n->latencySamples();
+    return total;
 }
 
 void EffectChain::process(AudioBufferView input, AudioBufferView output, int numSamples) {
@@ -64,6 +84,19 @@ void EffectChain::process(AudioBufferView input, AudioBufferView output, int num
         return;
     }
 
+#if GEARBOX_PROFILER
+    if (m_profiler.enabled()) {
+        processNodes<true>(input, output, numSamples);
+        return;
+    }
+#endif
+    processNodes<false>(input, output, numSamples);
+}
+
+template <bool Profile>
+void EffectChain::processNodes(AudioBufferView input, AudioBufferView output, int numSamples) {
+    if (Profile) m_profiler.beginBlock();
+
     const int numCh = input.numChannels;
 
     // Set up ping-pong: ping receives first node output, pong receives second, etc.
@@ -86,6 +119,9 @@ void EffectChain::process(AudioBufferView input, AudioBufferView output, int num
         dstView.numChannels = numCh;
         dstView.numSamples  = numSamples;
 
+        TelemetryTaps* taps = node->telemetryTaps();
+        if (taps) taps->input.write(srcView[0], numSamples);
+
         if (node->isEnabled()) {
             node->process(srcView, dstView, numSamples);
         } else {
@@ -94,12 +130,17 @@ void EffectChain::process(AudioBufferView input, AudioBufferView output, int num
                 std::memcpy(dstView[c], srcView[c], numSamples * sizeof(float));
         }
 
+        if (taps) taps->output.write(dstView[0], numSamples);
+        if (Profile) m_profiler.nodeDone(node.get());
+
         std::swap(src, dst);
     }
 
     // After the last node, src points to the buffer with the final result.
     for (int c = 0; c < numCh; ++c)
         std::memcpy(output[c], src->getWritePointer(c), numSamples * sizeof(float));
+
+    if (Profile) m_profiler.endBlock(numSamples, m_sampleRate);
 }
 
 } // namespace gearboxfx
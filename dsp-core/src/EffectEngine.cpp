@@ -1,4 +1,6 @@
 #include "EffectEngine.h"
+#include "RtCheck.h"
+#include "dsp/Denormals.h"
 #include <spdlog/spdlog.h>
 #include <cstring>
 
@@ -6,21 +8,31 @@ namespace gearboxfx {
 
 EffectEngine::EffectEngine() {
     m_paramManager.attachChain(&m_chain);
+    m_chain.setTempoClock(&m_clock);
 }
 
 void EffectEngine::prepare(double sampleRate, int maxBlockSize) {
     m_sampleRate   = sampleRate;
     m_maxBlockSize = maxBlockSize;
     m_chain.prepare(sampleRate, maxBlockSize);
+    m_tuner.prepare(sampleRate);
     m_prepared = true;
     spdlog::info("EffectEngine prepared: {}Hz, block={}", (int)sampleRate, maxBlockSize);
 }
 
 void EffectEngine::processBlock(AudioBufferView input, AudioBufferView output, int numSamples) {
+    rtcheck::RealtimeScope realtime;  // checked when the GearBoxRtCheck hooks are linked
+    ScopedFlushDenormals   noDenormals;
+
+    // Before the chain: processing may be in place
+    if (m_tuner.enabled() && input.numChannels > 0)
+        m_tuner.push(input[0], numSamples);
+
     if (m_bypass) {
         // Pass-through
         for (int c = 0; c < output.numChannels; ++c)
             std::memcpy(output[c], input[c], numSamples * sizeof(float));
+        m_clock.advance(numSamples, m_sampleRate);
         return;
     }
 
@@ -33,6 +45,8 @@ void EffectEngine::processBlock(AudioBufferView input, AudioBufferView output, i
             for (int s = 0; s < numSamples; ++s)
                 output[c][s] *= vol;
     }
+
+    m_clock.advance(numSamples, m_sampleRate);
 }
 
 bool EffectEngine::loadPreset(const std::string& path) {
@@ -43,6 +57,7 @@ bool EffectEngine::loadPreset(const std::string& path) {
         return false;
     }
     m_currentPreset = *result;
+    m_clock.bpm.store(m_currentPreset.bpm, std::memory_order_relaxed);
     m_paramManager.syncFromChain();
     spdlog::info("EffectEngine: loaded preset '{}' from '{}'", m_currentPreset.name, path);
     return true;
@@ -56,4 +71,15 @@ bool EffectEngine::setParam(const std::string& effectId_paramName, float value)
     return m_paramManager.set(effectId_paramName, value);
 }
 
+bool EffectEngine::looperCommand(LooperCommand cmd) {
+    bool found = false;
+    for (auto& node : m_chain.nodes()) {
+        if (auto looper = std::dynamic_pointer_cast<LooperNode>(node)) {
+            looper->command(cmd);
+            found = true;
+        }
+    }
+    return found;
+}
+
 } // namespace gearboxfx
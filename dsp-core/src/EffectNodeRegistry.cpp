@@ -1,4 +1,6 @@
 #include "effects/EffectNodeRegistry.h"
+#include "effects/amp/NeuralAmpNode.h"
+#include "effects/cab/ShortIRCabNode.h"
 #include "effects/dynamics/NoiseGateNode.h"
 #include "effects/dynamics/CompressorNode.h"
 #include "effects/eq/EQNode.h"
@@ -7,10 +9,12 @@
 #include "effects/gain/DistortionNode.h"
 #include "effects/modulation/ChorusNode.h"
 #include "effects/modulation/FlangerNode.h"
+#include "effects/modulation/OctaveDividerNode.h"
 #include "effects/modulation/PhaserNode.h"
 #include "effects/modulation/PitchShifterNode.h"
 #include "effects/modulation/TremoloNode.h"
 #include "effects/output/VolumeNode.h"
+#include "effects/utility/LooperNode.h"
 #include "effects/time/DelayNode.h"
 #include "effects/time/ReverbNode.h"
 
@@ -19,18 +23,22 @@ namespace gearboxfx {
 void EffectNodeRegistry::registerAll() {
     reg<NoiseGateNode>    ("dynamics.noise_gate");
     reg<CompressorNode>   ("dynamics.compressor");
+    reg<NeuralAmpNode>    ("amp.neural");
+    reg<ShortIRCabNode>   ("cab.short_ir");
     reg<EQNode>           ("eq.parametric");
     reg<CleanBoostNode>   ("gain.clean_boost");
     reg<OverdriveNode>    ("gain.overdrive");
     reg<DistortionNode>   ("gain.distortion");
     reg<ChorusNode>       ("modulation.chorus");
     reg<FlangerNode>      ("modulation.flanger");
+    reg<OctaveDividerNode>("modulation.octave_divider");
     reg<PhaserNode>       ("modulation.phaser");
     reg<PitchShifterNode> ("modulation.pitch_shifter");
     reg<TremoloNode>      ("modulation.tremolo");
     reg<VolumeNode>       ("output.volume");
     reg<DelayNode>        ("time.delay");
     reg<ReverbNode>       ("time.reverb");
+    reg<LooperNode>       ("utility.looper");
 }
 
 } // namespace gearboxfx
@@ -0,0 +1,113 @@
+#include "PerfCounters.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace gearboxfx {
+
+const char* PerfCounters::name(Counter c) {
+    switch (c) {
+        case Cycles:       return "cycles";
+        case Instructions: return "instructions";
+        case L1dMisses:    return "L1D misses";
+        case LlcMisses:    return "LLC misses";
+        case BranchMisses: return "branch misses";
+        default:           return "?";
+    }
+}
+
+#ifdef __linux__
+
+namespace {
+
+perf_event_attr makeAttr(PerfCounters::Counter c) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP;
+
+    switch (c) {
+        case PerfCounters::Cycles:
+            attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case PerfCounters::Instructions:
+            attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case PerfCounters::L1dMisses:
+            attr.type   = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D
+                        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case PerfCounters::LlcMisses:
+            attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+        case PerfCounters::BranchMisses:
+            attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        default: break;
+    }
+    return attr;
+}
+
+} // anonymous namespace
+
+bool PerfCounters::open() {
+    close();
+    for (int c = 0; c < kNumCounters; ++c) {
+        perf_event_attr attr = makeAttr(static_cast<Counter>(c));
+        attr.disabled = (c == Cycles) ? 1 : 0;  // the group starts with its leader
+        int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, m_leader, 0));
+        if (fd < 0) {
+            if (c == Cycles) {
+                m_error = std::string("perf_event_open: ") + std::strerror(errno);
+                return false;
+            }
+            continue;  // optional event
+        }
+        if (c == Cycles) m_leader = fd;
+        m_fd[c]   = fd;
+        m_slot[c] = m_numOpen++;
+    }
+    ioctl(m_leader, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+    ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    m_error.clear();
+    return true;
+}
+
+void PerfCounters::close() {
+    for (int c = kNumCounters - 1; c >= 0; --c) {
+        if (m_fd[c] >= 0) ::close(m_fd[c]);
+        m_fd[c]   = -1;
+        m_slot[c] = -1;
+    }
+    m_leader  = -1;
+    m_numOpen = 0;
+}
+
+bool PerfCounters::read(Values& out) const {
+    std::uint64_t buf[1 + kNumCounters];  // nr, then one value per event
+    if (m_leader < 0 || ::read(m_leader, buf, sizeof(buf)) <= 0) return false;
+    for (int c = 0; c < kNumCounters; ++c)
+        out[c] = (m_slot[c] >= 0) ? buf[1 + m_slot[c]] : 0;
+    return true;
+}
+
+#else
+
+bool PerfCounters::open() {
+    m_error = "hardware counters need Linux perf_event_open";
+    return false;
+}
+
+void PerfCounters::close() {}
+
+bool PerfCounters::read(Values&) const { return false; }
+
+#endif
+
+} // namespace gearboxfx
@@ -1,5 +1,7 @@
 #include "PresetStore.h"
 #include "effects/EffectNodeRegistry.h"
+#include "effects/OversampledNode.h"
+#include <filesystem>
 #include <fstream>
 #include <spdlog/spdlog.h>
 
@@ -10,7 +12,8 @@ static std::optional<Preset> buildFromJson(
     EffectChain&          chain,
     EffectNodeRegistry&   registry,
     double                sampleRate,
-    int                   maxBlockSize)
+    int                   maxBlockSize,
+    const std::string&    dataDir)
 {
     try {
         Preset p;
@@ -28,6 +31,12 @@ static std::optional<Preset> buildFromJson(
         }
         p.outputVolume = j.value("output_volume", 0.85f);
 
+        p.bpm = j.value("bpm", TempoClock::kDefaultBpm);
+        if (p.bpm != TempoClock::clampBpm(p.bpm)) {
+            spdlog::warn("Preset '{}': bpm {} out of range, clamped", p.name, p.bpm);
+            p.bpm = TempoClock::clampBpm(p.bpm);
+        }
+
         chain.clear();
 
         if (!j.contains("effect_chain") || !j["effect_chain"].is_array()) {
@@ -47,12 +56,24 @@ static std::optional<Preset> buildFromJson(
                 continue;
             }
 
-            node->setId(nodeId);
-            node->setEnabled(enabled);
-
             if (nodeJson.contains("params") && nodeJson["params"].is_object())
                 node->loadParams(nodeJson["params"]);
 
+            if (nodeJson.contains("data")) {
+                node->setDataDir(dataDir);
+                node->loadData(nodeJson["data"]);
+            }
+
+            int oversampling = nodeJson.value("oversampling", 1);
+            if (OversampledNode::isValidFactor(oversampling))
+                node = std::make_shared<OversampledNode>(node, oversampling);
+            else if (oversampling != 1)
+                spdlog::warn("Preset '{}': node '{}' has invalid oversampling {} (use 2, 4 or 8)",
+                             p.name, nodeId, oversampling);
+
+            node->setId(nodeId);
+            node->setEnabled(enabled);
+
             chain.addNode(node);
         }
 
@@ -86,7 +107,10 @@ std::optional<Preset> PresetStore::loadFromFile(
         return std::nullopt;
     }
 
-    return buildFromJson(j, chain, registry, sampleRate, maxBlockSize);
+    // Relative file paths in node data (e.g. amp.neural "model_path") are
+    // relative to the preset, not to the working directory.
+    const std::string dataDir = std::filesystem::path(path).parent_path().string();
+    return buildFromJson(j, chain, registry, sampleRate, maxBlockSize, dataDir);
 }
 
 std::optional<Preset> PresetStore::loadFromJson(
@@ -96,7 +120,7 @@ std::optional<Preset> PresetStore::loadFromJson(
     double                sampleRate,
     int                   maxBlockSize)
 {
-    return buildFromJson(j, chain, registry, sampleRate, maxBlockSize);
+    return buildFromJson(j, chain, registry, sampleRate, maxBlockSize, std::string());
 }
 
 bool PresetStore::saveToFile(
@@ -115,6 +139,7 @@ bool PresetStore::saveToFile(
         {"treble_db", preset.trebleDb}
     };
     j["output_volume"]  = preset.outputVolume;
+    j["bpm"]            = preset.bpm;
 
     nlohmann::json chainArr = nlohmann::json::array();
     for (auto& node : chain.nodes()) {
@@ -123,6 +148,11 @@ bool PresetStore::saveToFile(
         nodeJson["type"]    = node->typeId();
         nodeJson["enabled"] = node->isEnabled();
         nodeJson["params"]  = node->saveParams();
+        if (auto os = std::dynamic_pointer_cast<OversampledNode>(node))
+            nodeJson["oversampling"] = os->factor();
+        auto data = node->saveData();
+        if (!data.is_null())
+            nodeJson["data"] = data;
         chainArr.push_back(nodeJson);
     }
     j["effect_chain"] = chainArr;
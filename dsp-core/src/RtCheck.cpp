@@ -0,0 +1,129 @@
+#include "RtCheck.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#include <unistd.h>
+#define GEARBOX_RTCHECK_BACKTRACE 1
+#endif
+
+namespace gearboxfx {
+namespace rtcheck {
+
+namespace {
+
+thread_local int  t_realtimeDepth = 0;
+thread_local bool t_reporting     = false;  // inside check(): don't recurse
+
+std::atomic<Mode>          g_mode{Mode::Off};
+std::atomic<bool>          g_installed{false};
+std::atomic<std::uint64_t> g_count[kNumKinds];
+
+// First violation since the last reset (written once, by whoever wins g_haveFirst)
+constexpr int              kMaxFrames = 32;
+std::atomic<bool>          g_haveFirst{false};
+std::atomic<bool>          g_firstReady{false};
+const char*                g_firstCall = nullptr;
+void*                      g_firstFrames[kMaxFrames];
+int                        g_firstNumFrames = 0;
+
+void writeStderr(const char* s) {
+#ifdef GEARBOX_RTCHECK_BACKTRACE
+    ssize_t ignored = ::write(2, s, std::strlen(s));
+    (void)ignored;
+#else
+    std::fputs(s, stderr);
+#endif
+}
+
+} // anonymous namespace
+
+RealtimeScope::RealtimeScope()  { ++t_realtimeDepth; }
+RealtimeScope::~RealtimeScope() { --t_realtimeDepth; }
+
+bool isRealtimeThread() { return t_realtimeDepth > 0; }
+
+void setMode(Mode mode) { g_mode.store(mode, std::memory_order_relaxed); }
+Mode mode()             { return g_mode.load(std::memory_order_relaxed); }
+
+bool hooksInstalled() { return g_installed.load(std::memory_order_relaxed); }
+
+std::uint64_t violations(Kind kind) { return g_count[kind].load(std::memory_order_relaxed); }
+
+std::uint64_t totalViolations() {
+    std::uint64_t total = 0;
+    for (int k = 0; k < kNumKinds; ++k) total += violations(static_cast<Kind>(k));
+    return total;
+}
+
+void resetViolations() {
+    for (auto& c : g_count) c.store(0, std::memory_order_relaxed);
+    g_firstReady.store(false, std::memory_order_relaxed);
+    g_haveFirst.store(false, std::memory_order_release);
+}
+
+const char* kindName(Kind kind) {
+    switch (kind) {
+        case Allocation:   return "allocation";
+        case Deallocation: return "deallocation";
+        case Lock:         return "lock";
+        case Syscall:      return "syscall";
+        default:           return "?";
+    }
+}
+
+std::string firstViolation() {
+    if (!g_firstReady.load(std::memory_order_acquire)) return {};
+    std::string out = std::string(g_firstCall) + " on a real-time thread\n";
+#ifdef GEARBOX_RTCHECK_BACKTRACE
+    char** symbols = backtrace_symbols(g_firstFrames, g_firstNumFrames);
+    for (int i = 0; symbols && i < g_firstNumFrames; ++i)
+        out += std::string("  ") + symbols[i] + "\n";
+    std::free(symbols);
+#endif
+    return out;
+}
+
+namespace detail {
+
+void markInstalled(Mode initialMode) {
+    g_mode.store(initialMode, std::memory_order_relaxed);
+    g_installed.store(true, std::memory_order_relaxed);
+}
+
+void check(Kind kind, const char* call) {
+    if (t_realtimeDepth == 0 || t_reporting) return;
+    const Mode m = g_mode.load(std::memory_order_relaxed);
+    if (m == Mode::Off) return;
+
+    t_reporting = true;
+    g_count[kind].fetch_add(1, std::memory_order_relaxed);
+
+    if (m == Mode::Abort) {
+        writeStderr("gearboxfx rtcheck: ");
+        writeStderr(call);
+        writeStderr(" on a real-time thread\n");
+#ifdef GEARBOX_RTCHECK_BACKTRACE
+        void* frames[kMaxFrames];
+        backtrace_symbols_fd(frames, backtrace(frames, kMaxFrames), 2);
+#endif
+        std::abort();
+    }
+
+    if (!g_haveFirst.exchange(true, std::memory_order_acq_rel)) {
+        g_firstCall = call;
+#ifdef GEARBOX_RTCHECK_BACKTRACE
+        g_firstNumFrames = backtrace(g_firstFrames, kMaxFrames);
+#endif
+        g_firstReady.store(true, std::memory_order_release);
+    }
+    t_reporting = false;
+}
+
+} // namespace detail
+
+} // namespace rtcheck
+} // namespace gearboxfx
@@ -0,0 +1,232 @@
+// Interposers for the real-time safety checker (see RtCheck.h).
+// Linked into an executable as the GearBoxRtCheck object library; never part
+// of GearBoxDSP itself. Each hook reports to rtcheck::detail::check() and
+// forwards to the real implementation: glibc's __libc_* allocator entry
+// points, and dlsym(RTLD_NEXT) for the pthread and I/O calls. Only operator
+// new/delete are hooked on other platforms.
+
+#include "RtCheck.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <cstdarg>
+#include <ctime>
+#include <unistd.h>
+#endif
+
+using gearboxfx::rtcheck::detail::check;
+namespace rc = gearboxfx::rtcheck;
+
+namespace {
+
+struct Installer {
+    Installer() {
+        rc::Mode m = rc::Mode::Count;
+        if (const char* env = std::getenv("GEARBOX_RTCHECK")) {
+            if (std::strcmp(env, "off") == 0)   m = rc::Mode::Off;
+            if (std::strcmp(env, "abort") == 0) m = rc::Mode::Abort;
+        }
+        rc::detail::markInstalled(m);
+    }
+} g_installer;
+
+} // anonymous namespace
+
+// ── Allocator ────────────────────────────────────────────────────────────────
+
+#if defined(__GLIBC__)
+
+extern "C" {
+void* __libc_malloc(size_t);
+void  __libc_free(void*);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+
+void* malloc(size_t n)            { check(rc::Allocation, "malloc"); return __libc_malloc(n); }
+void* calloc(size_t n, size_t s)  { check(rc::Allocation, "calloc"); return __libc_calloc(n, s); }
+void* realloc(void* p, size_t n)  { check(rc::Allocation, "realloc"); return __libc_realloc(p, n); }
+void  free(void* p)               { if (p) check(rc::Deallocation, "free"); __libc_free(p); }
+
+void* aligned_alloc(size_t align, size_t n) {
+    check(rc::Allocation, "aligned_alloc");
+    return __libc_memalign(align, n);
+}
+
+int posix_memalign(void** out, size_t align, size_t n) {
+    check(rc::Allocation, "posix_memalign");
+    void* p = __libc_memalign(align, n);
+    if (!p) return ENOMEM;
+    *out = p;
+    return 0;
+}
+} // extern "C"
+
+static void* rawAlloc(size_t n)                { return __libc_malloc(n ? n : 1); }
+static void* rawAlignedAlloc(size_t n, size_t a) { return __libc_memalign(a, n ? n : 1); }
+static void  rawFree(void* p)                  { __libc_free(p); }
+
+#else
+
+static void* rawAlloc(size_t n) { return std::malloc(n ? n : 1); }
+static void* rawAlignedAlloc(size_t n, size_t a) {
+#if defined(_MSC_VER)
+    return _aligned_malloc(n ? n : 1, a);
+#else
+    return std::aligned_alloc(a, (n + a - 1) / a * a);
+#endif
+}
+static void rawFree(void* p) { std::free(p); }
+
+#endif
+
+static void* newImpl(std::size_t n) {
+    check(rc::Allocation, "operator new");
+    if (void* p = rawAlloc(n)) return p;
+    throw std::bad_alloc();
+}
+
+static void* newAlignedImpl(std::size_t n, std::align_val_t a) {
+    check(rc::Allocation, "operator new");
+    if (void* p = rawAlignedAlloc(n, static_cast<std::size_t>(a))) return p;
+    throw std::bad_alloc();
+}
+
+static void deleteImpl(void* p) {
+    if (!p) return;
+    check(rc::Deallocation, "operator delete");
+    rawFree(p);
+}
+
+static void deleteAlignedImpl(void* p) {
+    if (!p) return;
+    check(rc::Deallocation, "operator delete");
+#if defined(_MSC_VER)
+    _aligned_free(p);
+#else
+    rawFree(p);
+#endif
+}
+
+void* operator new  (std::size_t n)                                 { return newImpl(n); }
+void* operator new[](std::size_t n)                                 { return newImpl(n); }
+void* operator new  (std::size_t n, const std::nothrow_t&) noexcept { try { return newImpl(n); } catch (...) { return nullptr; } }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { try { return newImpl(n); } catch (...) { return nullptr; } }
+void* operator new  (std::size_t n, std::align_val_t a)             { return newAlignedImpl(n, a); }
+void* operator new[](std::size_t n, std::align_val_t a)             { return newAlignedImpl(n, a); }
+
+void operator delete  (void* p) noexcept                            { deleteImpl(p); }
+void operator delete[](void* p) noexcept                            { deleteImpl(p); }
+void operator delete  (void* p, std::size_t) noexcept               { deleteImpl(p); }
+void operator delete[](void* p, std::size_t) noexcept               { deleteImpl(p); }
+void operator delete  (void* p, const std::nothrow_t&) noexcept     { deleteImpl(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept     { deleteImpl(p); }
+void operator delete  (void* p, std::align_val_t) noexcept          { deleteAlignedImpl(p); }
+void operator delete[](void* p, std::align_val_t) noexcept          { deleteAlignedImpl(p); }
+void operator delete  (void* p, std::size_t, std::align_val_t) noexcept { deleteAlignedImpl(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { deleteAlignedImpl(p); }
+
+// ── Locks and blocking calls (Linux) ─────────────────────────────────────────
+
+#ifdef __linux__
+
+// Resolved on first use; dlsym may allocate, which is fine off the RT thread
+// and ignored on it (check() is not re-entered while reporting).
+#define GEARBOX_REAL(ret, name, params)                                       \
+    using name##_fn = ret (*) params;                                         \
+    static name##_fn real_##name() {                                          \
+        static name##_fn fn = reinterpret_cast<name##_fn>(dlsym(RTLD_NEXT, #name)); \
+        return fn;                                                            \
+    }
+
+GEARBOX_REAL(int, pthread_mutex_lock,     (pthread_mutex_t*))
+GEARBOX_REAL(int, pthread_rwlock_rdlock,  (pthread_rwlock_t*))
+GEARBOX_REAL(int, pthread_rwlock_wrlock,  (pthread_rwlock_t*))
+GEARBOX_REAL(int, pthread_cond_wait,      (pthread_cond_t*, pthread_mutex_t*))
+GEARBOX_REAL(int, pthread_cond_timedwait, (pthread_cond_t*, pthread_mutex_t*, const struct timespec*))
+GEARBOX_REAL(int, sem_wait,               (sem_t*))
+GEARBOX_REAL(ssize_t, read,               (int, void*, size_t))
+GEARBOX_REAL(ssize_t, write,              (int, const void*, size_t))
+GEARBOX_REAL(int, open,                   (const char*, int, ...))
+GEARBOX_REAL(int, close,                  (int))
+GEARBOX_REAL(int, fsync,                  (int))
+GEARBOX_REAL(int, nanosleep,              (const struct timespec*, struct timespec*))
+GEARBOX_REAL(int, clock_nanosleep,        (clockid_t, int, const struct timespec*, struct timespec*))
+GEARBOX_REAL(int, usleep,                 (useconds_t))
+
+extern "C" {
+
+int pthread_mutex_lock(pthread_mutex_t* m) {
+    check(rc::Lock, "pthread_mutex_lock");
+    return real_pthread_mutex_lock()(m);
+}
+int pthread_rwlock_rdlock(pthread_rwlock_t* l) {
+    check(rc::Lock, "pthread_rwlock_rdlock");
+    return real_pthread_rwlock_rdlock()(l);
+}
+int pthread_rwlock_wrlock(pthread_rwlock_t* l) {
+    check(rc::Lock, "pthread_rwlock_wrlock");
+    return real_pthread_rwlock_wrlock()(l);
+}
+int pthread_cond_wait(pthread_cond_t* c, pthread_mutex_t* m) {
+    check(rc::Lock, "pthread_cond_wait");
+    return real_pthread_cond_wait()(c, m);
+}
+int pthread_cond_timedwait(pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t) {
+    check(rc::Lock, "pthread_cond_timedwait");
+    return real_pthread_cond_timedwait()(c, m, t);
+}
+int sem_wait(sem_t* s) {
+    check(rc::Lock, "sem_wait");
+    return real_sem_wait()(s);
+}
+
+ssize_t read(int fd, void* buf, size_t n) {
+    check(rc::Syscall, "read");
+    return real_read()(fd, buf, n);
+}
+ssize_t write(int fd, const void* buf, size_t n) {
+    check(rc::Syscall, "write");
+    return real_write()(fd, buf, n);
+}
+int open(const char* path, int flags, ...) {
+    check(rc::Syscall, "open");
+    mode_t mode = 0;
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        va_list ap;
+        va_start(ap, flags);
+        mode = static_cast<mode_t>(va_arg(ap, int));
+        va_end(ap);
+    }
+    return real_open()(path, flags, mode);
+}
+int close(int fd) {
+    check(rc::Syscall, "close");
+    return real_close()(fd);
+}
+int fsync(int fd) {
+    check(rc::Syscall, "fsync");
+    return real_fsync()(fd);
+}
+int nanosleep(const struct timespec* req, struct timespec* rem) {
+    check(rc::Syscall, "nanosleep");
+    return real_nanosleep()(req, rem);
+}
+int clock_nanosleep(clockid_t clock, int flags, const struct timespec* req, struct timespec* rem) {
+    check(rc::Syscall, "clock_nanosleep");
+    return real_clock_nanosleep()(clock, flags, req, rem);
+}
+int usleep(useconds_t us) {
+    check(rc::Syscall, "usleep");
+    return real_usleep()(us);
+}
+
+} // extern "C"
+
+#endif // __linux__
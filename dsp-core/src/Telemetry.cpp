@@ -0,0 +1,157 @@
+#include "Telemetry.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace gearboxfx {
+
+static constexpr double kPi = 3.14159265358979323846;
+
+static constexpr float kBandLowHz   = 30.0f;
+static constexpr float kPeakFallDbS = 20.0f;
+static constexpr int   kIntervalMs  = 20;
+
+void Telemetry::start(double sampleRate) {
+    stop();
+    m_sampleRate = sampleRate > 0 ? sampleRate : 48000.0;
+
+    m_fft.prepare(kFftSize);
+    m_window.resize(kFftSize);
+    double sum = 0.0;
+    for (int i = 0; i < kFftSize; ++i) {
+        m_window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * kPi * i / kFftSize));
+        sum += m_window[i];
+    }
+    // Scale so a full-scale sine reads 0 dB in its bin
+    for (auto& w : m_window) w = static_cast<float>(w * 2.0 / sum);
+    m_re.resize(kFftSize);
+    m_im.resize(kFftSize);
+    m_block.resize(8192);
+
+    const float nyquist = static_cast<float>(m_sampleRate * 0.5);
+    const float binHz   = static_cast<float>(m_sampleRate / kFftSize);
+    for (int b = 0; b < kBands; ++b) {
+        float lo = kBandLowHz * std::pow(nyquist / kBandLowHz, static_cast<float>(b)     / kBands);
+        float hi = kBandLowHz * std::pow(nyquist / kBandLowHz, static_cast<float>(b + 1) / kBands);
+        m_bandLo[b] = std::min(kFftSize / 2 - 1, static_cast<int>(lo / binHz));
+        m_bandHi[b] = std::max(m_bandLo[b] + 1, std::min(kFftSize / 2, static_cast<int>(hi / binHz)));
+    }
+
+    m_running.store(true, std::memory_order_release);
+    m_worker = std::thread([this] { workerLoop(); });
+}
+
+void Telemetry::stop() {
+    if (m_worker.joinable()) {
+        m_running.store(false, std::memory_order_release);
+        m_worker.join();
+    }
+}
+
+float Telemetry::bandHz(int band) const {
+    const float nyquist = static_cast<float>(m_sampleRate * 0.5);
+    return kBandLowHz * std::pow(nyquist / kBandLowHz, (band + 0.5f) / kBands);
+}
+
+void Telemetry::sync(const EffectChain& chain) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto& nodes = chain.nodes();
+
+    // Drop taps of nodes that left the chain (they no longer run)
+    m_nodes.erase(std::remove_if(m_nodes.begin(), m_nodes.end(), [&](Analysis& a) {
+        auto node = a.node.lock();
+        if (node && std::find(nodes.begin(), nodes.end(), node) != nodes.end()) return false;
+        if (node) node->setTelemetryTaps(nullptr);
+        return true;
+    }), m_nodes.end());
+
+    for (const auto& node : nodes) {
+        if (node->telemetryTaps()) continue;
+        Analysis a;
+        a.node = node;
+        a.taps = std::make_unique<TelemetryTaps>();
+        a.history.assign(kFftSize, 0.0f);
+        a.meters.spectrumDb.fill(kFloorDb);
+        node->setTelemetryTaps(a.taps.get());
+        m_nodes.push_back(std::move(a));
+    }
+}
+
+bool Telemetry::meters(const EffectNode* node, NodeMeters& out) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& a : m_nodes) {
+        if (a.node.lock().get() == node) {
+            out = a.meters;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Telemetry::workerLoop() {
+    auto last = std::chrono::steady_clock::now();
+    while (m_running.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(kIntervalMs));
+        auto now = std::chrono::steady_clock::now();
+        float dt = std::chrono::duration<float>(now - last).count();
+        last = now;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& a : m_nodes) analyse(a, dt);
+    }
+}
+
+void Telemetry::meter(const float* x, std::size_t n, Meter& m, float dt) {
+    m.peakDb = std::max(kFloorDb, m.peakDb - kPeakFallDbS * dt);
+    if (n == 0) {
+        m.rmsDb = kFloorDb;
+        return;
+    }
+    double sum = 0.0;
+    float  peak = 0.0f;
+    for (std::size_t i = 0; i < n; ++i) {
+        sum += static_cast<double>(x[i]) * x[i];
+        peak = std::max(peak, std::abs(x[i]));
+    }
+    m.rmsDb  = std::max(kFloorDb, static_cast<float>(10.0 * std::log10(sum / n + 1e-30)));
+    m.peakDb = std::max(m.peakDb, std::max(kFloorDb, 20.0f * std::log10(peak + 1e-30f)));
+}
+
+void Telemetry::analyse(Analysis& a, float dt) {
+    auto node = a.node.lock();
+    if (!node) return;
+    a.meters.gainReductionDb = node->gainReductionDb();
+
+    std::size_t n = a.taps->input.read(m_block.data(), m_block.size());
+    meter(m_block.data(), n, a.meters.input, dt);
+
+    n = a.taps->output.read(m_block.data(), m_block.size());
+    meter(m_block.data(), n, a.meters.output, dt);
+    if (n == 0) return;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        a.history[a.historyPos] = m_block[i];
+        a.historyPos = (a.historyPos + 1) % kFftSize;
+    }
+
+    // Scope: the most recent output, oldest first
+    for (int i = 0; i < kScopeSize; ++i) {
+        int idx = a.historyPos - (kScopeSize - i) * kScopeDecimation;
+        a.meters.scope[i] = a.history[((idx % kFftSize) + kFftSize) % kFftSize];
+    }
+
+    // Spectrum of the last kFftSize samples
+    for (int i = 0; i < kFftSize; ++i) {
+        m_re[i] = a.history[(a.historyPos + i) % kFftSize] * m_window[i];
+        m_im[i] = 0.0f;
+    }
+    m_fft.forward(m_re.data(), m_im.data());
+    for (int b = 0; b < kBands; ++b) {
+        float mag2 = 0.0f;
+        for (int k = m_bandLo[b]; k < m_bandHi[b]; ++k)
+            mag2 = std::max(mag2, m_re[k] * m_re[k] + m_im[k] * m_im[k]);
+        a.meters.spectrumDb[b] = std::max(kFloorDb, 10.0f * std::log10(mag2 + 1e-30f));
+    }
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,63 @@
+#include "Tuner.h"
+#include <chrono>
+#include <cmath>
+
+namespace gearboxfx {
+
+void Tuner::prepare(double sampleRate) {
+    stop();
+    m_detector.prepare(sampleRate, kMinHz, kMaxHz);
+    m_scratch.assign(1024, 0.0f);
+    float discard[256];
+    while (m_ring.pop(discard, 256) > 0) {}
+
+    m_running.store(true, std::memory_order_release);
+    m_worker = std::thread([this] { workerLoop(); });
+}
+
+void Tuner::stop() {
+    if (m_worker.joinable()) {
+        m_running.store(false, std::memory_order_release);
+        m_worker.join();
+    }
+}
+
+void Tuner::workerLoop() {
+    while (m_running.load(std::memory_order_acquire)) {
+        const std::size_t n = m_ring.pop(m_scratch.data(), m_scratch.size());
+        if (n == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
+
+        double sum = 0.0;
+        for (std::size_t i = 0; i < n; ++i) sum += static_cast<double>(m_scratch[i]) * m_scratch[i];
+        m_detector.push(m_scratch.data(), static_cast<int>(n));
+        publish(static_cast<float>(std::sqrt(sum / n)));
+    }
+}
+
+void Tuner::publish(float rms) {
+    const float f = m_detector.frequency();
+    if (f <= 0.0f || rms < kGateRms) {
+        m_frequency.store(0.0f, std::memory_order_relaxed);
+        m_note.store(-1, std::memory_order_relaxed);
+        m_cents.store(0.0f, std::memory_order_relaxed);
+        m_confidence.store(0.0f, std::memory_order_relaxed);
+        return;
+    }
+
+    const float midi = 69.0f + 12.0f * std::log2(f / reference());
+    const int   note = static_cast<int>(std::lround(midi));
+    m_frequency.store(f, std::memory_order_relaxed);
+    m_note.store(note, std::memory_order_relaxed);
+    m_cents.store(100.0f * (midi - static_cast<float>(note)), std::memory_order_relaxed);
+    m_confidence.store(m_detector.confidence(), std::memory_order_relaxed);
+}
+
+const char* Tuner::noteName(int midiNote) {
+    static const char* kNames[12] = { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" };
+    return midiNote >= 0 ? kNames[midiNote % 12] : "";
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,52 @@
+#include "dsp/DirectFir.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gearboxfx {
+
+void DirectFir::prepare(int maxTaps, int maxBlockSize) {
+    m_maxTaps      = std::max(1, maxTaps);
+    m_maxBlockSize = std::max(1, maxBlockSize);
+    m_kernelRev.assign(m_maxTaps, 0.0f);
+    m_buf.assign((m_maxTaps - 1) + m_maxBlockSize, 0.0f);
+    m_kernelRev[0] = 1.0f;  // identity until a kernel is loaded
+    m_numTaps = 1;
+}
+
+void DirectFir::setKernel(const float* h, int numTaps) {
+    numTaps = std::max(1, std::min(numTaps, m_maxTaps));
+    for (int k = 0; k < numTaps; ++k)
+        m_kernelRev[k] = h[numTaps - 1 - k];
+
+    // History older than the previous kernel was not kept
+    if (numTaps > m_numTaps) {
+        float* input = m_buf.data() + (m_maxTaps - 1);
+        std::fill(input - (numTaps - 1), input - (m_numTaps - 1), 0.0f);
+    }
+    m_numTaps = numTaps;
+}
+
+void DirectFir::reset() {
+    std::fill(m_buf.begin(), m_buf.end(), 0.0f);
+}
+
+// The input block always lands at the same offset; only the numTaps - 1
+// samples the active kernel needs are carried over to the next block.
+void DirectFir::process(const float* in, float* out, int numSamples) {
+    float*    input = m_buf.data() + (m_maxTaps - 1);
+    const int hist  = m_numTaps - 1;
+
+    std::memcpy(input, in, numSamples * sizeof(float));
+    firBlock(input - hist, m_kernelRev.data(), m_numTaps, out, numSamples);
+    std::memmove(input - hist, input + numSamples - hist, hist * sizeof(float));
+}
+
+void DirectFir::pushHistory(const float* in, int numSamples) {
+    float*    input = m_buf.data() + (m_maxTaps - 1);
+    const int hist  = m_numTaps - 1;
+
+    std::memcpy(input, in, numSamples * sizeof(float));
+    std::memmove(input - hist, input + numSamples - hist, hist * sizeof(float));
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,85 @@
+#include "dsp/Fft.h"
+#include <cmath>
+#include <cassert>
+#include <utility>
+
+namespace gearboxfx {
+
+int Fft::nextPowerOfTwo(int n) {
+    int p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+void Fft::prepare(int size) {
+    assert(isPowerOfTwo(size) && size >= 2);
+    m_size = size;
+
+    int bits = 0;
+    while ((1 << bits) < size) ++bits;
+
+    m_bitRev.resize(size);
+    for (int i = 0; i < size; ++i) {
+        int r = 0;
+        for (int b = 0; b < bits; ++b)
+            if (i & (1 << b)) r |= 1 << (bits - 1 - b);
+        m_bitRev[i] = r;
+    }
+
+    m_cos.resize(size / 2);
+    m_sin.resize(size / 2);
+    for (int k = 0; k < size / 2; ++k) {
+        double w = -2.0 * 3.14159265358979323846 * k / size;
+        m_cos[k] = static_cast<float>(std::cos(w));
+        m_sin[k] = static_cast<float>(std::sin(w));
+    }
+}
+
+void Fft::forward(float* re, float* im) const {
+    transform(re, im, 1.0f);
+}
+
+void Fft::inverse(float* re, float* im) const {
+    transform(re, im, -1.0f);
+    const float scale = 1.0f / static_cast<float>(m_size);
+    for (int i = 0; i < m_size; ++i) {
+        re[i] *= scale;
+        im[i] *= scale;
+    }
+}
+
+// sign = +1 uses e^{-jwt} twiddles (forward), -1 conjugates them (inverse).
+void Fft::transform(float* re, float* im, float sign) const {
+    const int n = m_size;
+
+    for (int i = 0; i < n; ++i) {
+        int j = m_bitRev[i];
+        if (j > i) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+
+    for (int len = 2; len <= n; len <<= 1) {
+        const int half   = len >> 1;
+        const int stride = n / len;
+        for (int start = 0; start < n; start += len) {
+            float* r0 = re + start;
+            float* i0 = im + start;
+            float* r1 = r0 + half;
+            float* i1 = i0 + half;
+            for (int k = 0; k < half; ++k) {
+                float wr = m_cos[k * stride];
+                float wi = m_sin[k * stride] * sign;
+                float tr = r1[k] * wr - i1[k] * wi;
+                float ti = r1[k] * wi + i1[k] * wr;
+                r1[k] = r0[k] - tr;
+                i1[k] = i0[k] - ti;
+                r0[k] += tr;
+                i0[k] += ti;
+            }
+        }
+    }
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,107 @@
+#include "dsp/HalfBand.h"
+#include "dsp/DirectFir.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace gearboxfx {
+
+static constexpr double kPi = 3.14159265358979323846;
+
+namespace {
+
+// Zeroth-order modified Bessel function of the first kind (power series).
+double besselI0(double x) {
+    double sum = 1.0, term = 1.0, q = x * x / 4.0;
+    for (int k = 1; k < 50 && term > 1e-12 * sum; ++k) {
+        term *= q / (static_cast<double>(k) * k);
+        sum  += term;
+    }
+    return sum;
+}
+
+} // anonymous namespace
+
+void HalfBandStage::prepare(int numTaps, int maxInputSize) {
+    // Force 4k + 3 so the centre index is odd and both end taps are non-zero.
+    numTaps      = std::max(3, numTaps);
+    numTaps     += (3 - numTaps % 4 + 4) % 4;
+    m_numTaps    = numTaps;
+    m_center     = (numTaps - 1) / 2;
+    m_branchTaps = (numTaps + 1) / 2;
+    m_maxInput   = std::max(1, maxInputSize);
+
+    // Kaiser window, beta for ~80 dB stopband attenuation.
+    const double beta = 0.1102 * (80.0 - 8.7);
+    const double i0b  = besselI0(beta);
+
+    std::vector<double> branch(m_branchTaps);
+    double sum = 0.0;
+    for (int i = 0; i < m_branchTaps; ++i) {
+        int    n = 2 * i;                        // even taps of the full filter
+        double t = 0.5 * (n - m_center);         // odd offset / 2
+        double r = static_cast<double>(n - m_center) / m_center;
+        double w = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / i0b;
+        branch[i] = 0.5 * std::sin(kPi * t) / (kPi * t) * w;
+        sum += branch[i];
+    }
+
+    // Exact unity DC gain: the branch must sum to 0.5 (the centre tap is the other half).
+    m_branchRev.resize(m_branchTaps);
+    m_branchRevX2.resize(m_branchTaps);
+    for (int i = 0; i < m_branchTaps; ++i) {
+        double h = branch[m_branchTaps - 1 - i] * 0.5 / sum;
+        m_branchRev[i]   = static_cast<float>(h);
+        m_branchRevX2[i] = static_cast<float>(2.0 * h);
+    }
+
+    m_upBuf.assign((m_branchTaps - 1) + m_maxInput, 0.0f);
+    m_downEven.assign((m_branchTaps - 1) + m_maxInput, 0.0f);
+    m_downOdd.assign((m_center + 1) / 2 + m_maxInput, 0.0f);
+    m_tmp.assign(m_maxInput, 0.0f);
+}
+
+void HalfBandStage::reset() {
+    std::fill(m_upBuf.begin(),    m_upBuf.end(),    0.0f);
+    std::fill(m_downEven.begin(), m_downEven.end(), 0.0f);
+    std::fill(m_downOdd.begin(),  m_downOdd.end(),  0.0f);
+}
+
+void HalfBandStage::upsample(const float* in, float* out, int n) {
+    const int hist  = m_branchTaps - 1;
+    const int delay = (m_center - 1) / 2;
+    float*    buf   = m_upBuf.data();
+    float*    tmp   = m_tmp.data();
+
+    std::memcpy(buf + hist, in, n * sizeof(float));
+    firBlock(buf, m_branchRevX2.data(), m_branchTaps, tmp, n);
+
+    const float* delayed = buf + hist - delay;
+    for (int m = 0; m < n; ++m) {
+        out[2 * m]     = tmp[m];
+        out[2 * m + 1] = delayed[m];
+    }
+
+    std::memmove(buf, buf + n, hist * sizeof(float));
+}
+
+void HalfBandStage::downsample(const float* in, float* out, int n) {
+    const int histE = m_branchTaps - 1;
+    const int histO = (m_center + 1) / 2;
+    float*    even  = m_downEven.data();
+    float*    odd   = m_downOdd.data();
+
+    for (int m = 0; m < n; ++m) {
+        even[histE + m] = in[2 * m];
+        odd [histO + m] = in[2 * m + 1];
+    }
+
+    firBlock(even, m_branchRev.data(), m_branchTaps, out, n);
+    for (int m = 0; m < n; ++m)
+        out[m] += 0.5f * odd[m];
+
+    std::memmove(even, even + n, histE * sizeof(float));
+    std::memmove(odd,  odd  + n, histO * sizeof(float));
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,155 @@
+#include "dsp/Lfo.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gearboxfx {
+
+static constexpr double kPi = 3.14159265358979323846;
+
+namespace {
+
+constexpr int kHarmonics = 15;
+
+struct Wavetables {
+    float sine[Lfo::kTableSize + 1];
+    float triangle[Lfo::kTableSize + 1];
+    float square[Lfo::kTableSize + 1];
+
+    Wavetables() {
+        double sqPeak = 0.0;
+        for (int i = 0; i <= Lfo::kTableSize; ++i) {
+            const double x = static_cast<double>(i) / Lfo::kTableSize;
+            double tri = 0.0, sq = 0.0;
+            for (int k = 1; k <= kHarmonics; k += 2) {
+                // Lanczos sigma factor keeps the square's Gibbs ripple down
+                double sigma = std::sin(kPi * k / (kHarmonics + 1)) / (kPi * k / (kHarmonics + 1));
+                tri -= std::cos(2.0 * kPi * k * x) / (k * k);
+                sq  += sigma * std::sin(2.0 * kPi * k * x) / k;
+            }
+            sine[i]     = static_cast<float>(std::sin(2.0 * kPi * x));
+            triangle[i] = static_cast<float>(tri * 8.0 / (kPi * kPi));
+            square[i]   = static_cast<float>(sq);
+            sqPeak = std::max(sqPeak, std::abs(sq));
+        }
+        for (float& v : square) v = static_cast<float>(v / sqPeak);
+        // Guarantee exact extremes on the triangle (the series converges slowly)
+        double triPeak = 0.0;
+        for (float v : triangle) triPeak = std::max(triPeak, static_cast<double>(std::abs(v)));
+        for (float& v : triangle) v = static_cast<float>(v / triPeak);
+    }
+};
+
+const Wavetables& wavetables() {
+    static const Wavetables t;
+    return t;
+}
+
+float lookup(const float* table, float phase) {
+    const float pos  = phase * Lfo::kTableSize;
+    const int   i    = std::min(static_cast<int>(pos), Lfo::kTableSize - 1);
+    const float frac = pos - static_cast<float>(i);
+    return table[i] + frac * (table[i + 1] - table[i]);
+}
+
+} // anonymous namespace
+
+void Lfo::prepare(double sampleRate) {
+    m_sampleRate = sampleRate > 0 ? sampleRate : 48000.0;
+    wavetables();  // build the tables here rather than on the audio thread
+    setRate(m_rate);
+    reset(m_phase);
+}
+
+void Lfo::reset(float phase) {
+    m_phase     = phase - std::floor(phase);
+    m_countdown = 0;
+    m_randPrev  = 0.0f;
+    m_randNext  = 0.0f;
+    m_value = m_target = valueAt(m_phase);
+    m_step  = 0.0f;
+}
+
+void Lfo::setRate(float hz) {
+    m_rate      = hz;
+    m_increment = static_cast<float>(hz / m_sampleRate);
+}
+
+void Lfo::setControlInterval(int samples) {
+    m_interval  = std::max(1, samples);
+    m_countdown = std::min(m_countdown, m_interval);
+}
+
+void Lfo::setPhase(float phase) {
+    m_phase = phase - std::floor(phase);
+}
+
+void Lfo::syncTo(double beat, double beatsPerCycle, double bpm) {
+    m_increment = static_cast<float>(bpm / (60.0 * m_sampleRate * beatsPerCycle));
+
+    // m_phase runs ahead of the output by the part of the ramp still pending.
+    double p = beat / beatsPerCycle + static_cast<double>(m_countdown) * m_increment;
+    float  target = static_cast<float>(p - std::floor(p));
+    if (target < m_phase - 0.5f) newCycle();
+    m_phase = target;
+}
+
+float Lfo::valueAt(float phase) const {
+    const Wavetables& t = wavetables();
+    switch (m_shape) {
+        default:
+        case LfoShape::Sine:       return lookup(t.sine, phase);
+        case LfoShape::Triangle:   return lookup(t.triangle, phase);
+        case LfoShape::Square:     return lookup(t.square, phase);
+        case LfoShape::SampleHold: return m_randNext;
+        case LfoShape::Random: {
+            const float w = phase * phase * (3.0f - 2.0f * phase);
+            return m_randPrev + w * (m_randNext - m_randPrev);
+        }
+    }
+}
+
+void Lfo::newCycle() {
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+    m_randPrev = m_randNext;
+    m_randNext = static_cast<float>(m_seed >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+void Lfo::advance(float cycles) {
+    m_phase += cycles;
+    if (m_phase >= 1.0f) {
+        m_phase -= std::floor(m_phase);
+        newCycle();
+    }
+}
+
+float Lfo::tick(int numSamples) {
+    const float v = valueAt(m_phase);
+    advance(m_increment * static_cast<float>(numSamples));
+    return v;
+}
+
+void Lfo::process(float* out, int numSamples) {
+    int s = 0;
+    while (s < numSamples) {
+        if (m_countdown == 0) {
+            m_value     = m_target;
+            m_target    = valueAt(m_phase);
+            m_step      = (m_target - m_value) / static_cast<float>(m_interval);
+            m_countdown = m_interval;
+            advance(m_increment * static_cast<float>(m_interval));
+        }
+
+        const int   run  = std::min(m_countdown, numSamples - s);
+        const int   done = m_interval - m_countdown;
+        const float base = m_value + m_step * static_cast<float>(done);
+        for (int i = 0; i < run; ++i)
+            out[s + i] = base + m_step * static_cast<float>(i + 1);
+
+        m_countdown -= run;
+        s += run;
+    }
+}
+
+} // namespace gearboxfx
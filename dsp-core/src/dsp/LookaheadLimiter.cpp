@@ -0,0 +1,169 @@
+#include "dsp/LookaheadLimiter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gearboxfx {
+
+static constexpr double kPi = 3.14159265358979323846;
+
+namespace {
+
+double besselI0(double x) {
+    double sum = 1.0, term = 1.0, q = x * x / 4.0;
+    for (int k = 1; k < 50 && term > 1e-12 * sum; ++k) {
+        term *= q / (static_cast<double>(k) * k);
+        sum  += term;
+    }
+    return sum;
+}
+
+} // anonymous namespace
+
+void LookaheadLimiter::prepare(double sampleRate, int maxLookahead) {
+    m_sampleRate   = sampleRate > 0 ? sampleRate : 48000.0;
+    m_maxLookahead = std::max(1, maxLookahead);
+
+    // Kaiser-windowed sinc, phase p estimates x(n - kTruePeakDelay - p/4).
+    const double beta = 6.0, half = kTruePeakTaps / 2 + 0.5;
+    for (int p = 1; p <= 3; ++p) {
+        double sum = 0.0;
+        for (int k = 0; k < kTruePeakTaps; ++k) {
+            double t = k - kTruePeakDelay - p * 0.25;
+            double r = t / half;
+            double w = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / besselI0(beta);
+            double h = std::sin(kPi * t) / (kPi * t) * w;
+            m_phase[p - 1][k] = static_cast<float>(h);
+            sum += h;
+        }
+        for (int k = 0; k < kTruePeakTaps; ++k)
+            m_phase[p - 1][k] = static_cast<float>(m_phase[p - 1][k] / sum);
+    }
+
+    m_delayLen = m_maxLookahead - 1 + kTruePeakDelay + 1;
+    for (auto& d : m_delay) d.assign(m_delayLen, 0.0f);
+    m_dqIndex.assign(m_maxLookahead + 1, 0);
+    m_dqValue.assign(m_maxLookahead + 1, 1.0f);
+    m_box.assign(m_maxLookahead, 1.0f);
+
+    m_requestedLookahead.store(
+        std::min(m_requestedLookahead.load(std::memory_order_relaxed), m_maxLookahead),
+        std::memory_order_relaxed);
+    reset();
+}
+
+void LookaheadLimiter::reset() {
+    m_lookahead = m_requestedLookahead.load(std::memory_order_relaxed);
+    m_fadeLeft  = 0;
+    for (auto& h : m_hist) std::fill(std::begin(h), std::end(h), 0.0f);
+    for (auto& d : m_delay) std::fill(d.begin(), d.end(), 0.0f);
+    m_histPos  = 0;
+    m_delayPos = 0;
+    m_dqHead   = 0;
+    m_dqCount  = 0;
+    m_counter  = 0;
+    std::fill(m_box.begin(), m_box.end(), 1.0f);
+    m_boxPos = 0;
+    m_boxSum = static_cast<double>(m_lookahead);
+    m_gain   = 1.0f;
+}
+
+void LookaheadLimiter::setLookahead(int samples) {
+    samples = std::max(1, std::min(samples, m_maxLookahead));
+    m_requestedLookahead.store(samples, std::memory_order_relaxed);
+}
+
+// Audio thread. The delay line and true-peak history are sized for the
+// maximum lookahead and are kept; only the window and box filter restart,
+// seeded with the current gain so the gain curve stays continuous.
+void LookaheadLimiter::applyLookahead(int samples) {
+    m_fadeFromLag = m_lookahead - 1 + kTruePeakDelay;
+    m_fadeLeft    = kLookaheadFade;
+    m_lookahead   = samples;
+    m_dqHead  = 0;
+    m_dqCount = 0;
+    std::fill(m_box.begin(), m_box.begin() + samples, m_gain);
+    m_boxPos = 0;
+    m_boxSum = static_cast<double>(m_gain) * samples;
+}
+
+void LookaheadLimiter::setReleaseMs(float ms) {
+    m_releaseCoeff = static_cast<float>(std::exp(-1.0 / (m_sampleRate * ms * 0.001)));
+}
+
+void LookaheadLimiter::process(float* const* channels, int numChannels, int numSamples) {
+    const int requested = m_requestedLookahead.load(std::memory_order_relaxed);
+    if (requested != m_lookahead) applyLookahead(requested);
+
+    const int numCh  = std::min(2, numChannels);
+    const int L      = m_lookahead;
+    const int cap    = m_maxLookahead + 1;
+    const int outLag = L - 1 + kTruePeakDelay;  // samples between write and read
+    const float invL = 1.0f / static_cast<float>(L);
+    const float thresh = m_thresh.load(std::memory_order_relaxed);
+
+    for (int s = 0; s < numSamples; ++s) {
+        // ── True-peak detection (x[n - kTruePeakDelay] and the 3 points before it)
+        m_histPos = (m_histPos == 0) ? kTruePeakTaps - 1 : m_histPos - 1;
+        float peak = 0.0f;
+        for (int c = 0; c < numCh; ++c) {
+            float x = channels[c][s];
+            m_hist[c][m_histPos]                 = x;
+            m_hist[c][m_histPos + kTruePeakTaps] = x;
+            const float* h = m_hist[c] + m_histPos;  // h[k] = x[n - k]
+
+            float p0 = 0.0f, p1 = 0.0f, p2 = 0.0f;
+            for (int k = 0; k < kTruePeakTaps; ++k) {
+                p0 += m_phase[0][k] * h[k];
+                p1 += m_phase[1][k] * h[k];
+                p2 += m_phase[2][k] * h[k];
+            }
+            peak = std::max({peak, std::abs(h[kTruePeakDelay]),
+                             std::abs(p0), std::abs(p1), std::abs(p2)});
+        }
+        const float required = (peak > thresh) ? thresh / peak : 1.0f;
+
+        // ── Sliding-window minimum (monotonic deque)
+        const std::uint32_t n = m_counter++;
+        while (m_dqCount > 0 && m_dqValue[(m_dqHead + m_dqCount - 1) % cap] >= required)
+            --m_dqCount;
+        int tail = (m_dqHead + m_dqCount) % cap;
+        m_dqIndex[tail] = n;
+        m_dqValue[tail] = required;
+        ++m_dqCount;
+        if (n - m_dqIndex[m_dqHead] >= static_cast<std::uint32_t>(L)) {
+            m_dqHead = (m_dqHead + 1) % cap;
+            --m_dqCount;
+        }
+        const float windowMin = m_dqValue[m_dqHead];
+
+        // ── Box filter over the window minima
+        m_boxSum += static_cast<double>(windowMin) - m_box[m_boxPos];
+        m_box[m_boxPos] = windowMin;
+        m_boxPos = (m_boxPos + 1 == L) ? 0 : m_boxPos + 1;
+        const float target = std::min(1.0f, static_cast<float>(m_boxSum) * invL);
+
+        // ── Release (instant down, smoothed up — slower rises keep it safe)
+        m_gain = (target < m_gain) ? target : target + m_releaseCoeff * (m_gain - target);
+
+        // ── Delay the audio to line up with its gain, apply, clamp
+        int readPos = m_delayPos - outLag;
+        if (readPos < 0) readPos += m_delayLen;
+        int   fadePos = readPos;
+        float fade    = 1.0f;  // weight of the new tap
+        if (m_fadeLeft > 0) {
+            fadePos = m_delayPos - m_fadeFromLag;
+            if (fadePos < 0) fadePos += m_delayLen;
+            fade = 1.0f - static_cast<float>(m_fadeLeft--) / (kLookaheadFade + 1);
+        }
+        for (int c = 0; c < numCh; ++c) {
+            float delayed = m_delay[c][readPos];
+            if (fade < 1.0f) delayed = m_delay[c][fadePos] + fade * (delayed - m_delay[c][fadePos]);
+            m_delay[c][m_delayPos] = channels[c][s];
+            float y = delayed * m_gain;
+            channels[c][s] = std::min(thresh, std::max(-thresh, y));
+        }
+        m_delayPos = (m_delayPos + 1 == m_delayLen) ? 0 : m_delayPos + 1;
+    }
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,43 @@
+#include "dsp/ModulatedDelay.h"
+#include <algorithm>
+
+namespace gearboxfx {
+
+void ModulatedDelay::prepare(int maxDelaySamples) {
+    int size = 1;
+    while (size < maxDelaySamples + 2) size <<= 1;
+    for (auto& b : m_buf) b.assign(size, 0.0f);
+    m_mask     = size - 1;
+    m_writePos = 0;
+}
+
+void ModulatedDelay::reset() {
+    for (auto& b : m_buf) std::fill(b.begin(), b.end(), 0.0f);
+    m_writePos = 0;
+}
+
+float ModulatedDelay::read(int ch, float delaySamples) const {
+    const float* buf = m_buf[ch].data();
+    const int    d   = static_cast<int>(delaySamples);
+    const float  fr  = delaySamples - static_cast<float>(d);
+    const int    i0  = (m_writePos - d) & m_mask;
+    const int    i1  = (m_writePos - d - 1) & m_mask;
+    return buf[i0] + fr * (buf[i1] - buf[i0]);
+}
+
+float ModulatedDelay::tapSum(int ch, const float* delays, const float* weights) const {
+    const float* buf = m_buf[ch].data();
+    float acc[kLanes];
+    for (int j = 0; j < kLanes; ++j) {
+        const int   d  = static_cast<int>(delays[j]);
+        const float fr = delays[j] - static_cast<float>(d);
+        const float y0 = buf[(m_writePos - d) & m_mask];
+        const float y1 = buf[(m_writePos - d - 1) & m_mask];
+        acc[j] = weights[j] * (y0 + fr * (y1 - y0));
+    }
+    float sum = 0.0f;
+    for (int j = 0; j < kLanes; ++j) sum += acc[j];
+    return sum;
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,187 @@
+#include "dsp/PhaseVocoder.h"
+#include "dsp/FastMath.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace gearboxfx {
+
+static constexpr double kPi = 3.14159265358979323846;
+
+void PhaseVocoder::prepare() {
+    for (int i = 0; i < kNumSizes; ++i)
+        m_fft[i].prepare(kMinFftSize << i);
+
+    const int bins = kMaxFftSize / 2 + 1;
+    m_window.assign(kMaxFftSize, 0.0f);
+    m_re.assign(kMaxFftSize, 0.0f);
+    m_im.assign(kMaxFftSize, 0.0f);
+    m_mag.assign(bins, 0.0f);
+    m_phase.assign(bins, 0.0f);
+    m_freq.assign(bins, 0.0f);
+    m_outMag.assign(bins, 0.0f);
+    m_outPhase.assign(bins, 0.0f);
+    m_peaks.assign(bins, 0);
+
+    for (auto& ch : m_ch) {
+        ch.inFifo.assign(kMaxFftSize, 0.0f);
+        ch.outFifo.assign(kMaxFftSize, 0.0f);
+        ch.accum.assign(2 * kMaxFftSize, 0.0f);
+        ch.lastPhase.assign(bins, 0.0f);
+        ch.synthPhase.assign(bins, 0.0f);
+    }
+
+    m_size = 0;  // force configure() to rebuild the window
+    configure(2048, 4);
+}
+
+void PhaseVocoder::configure(int fftSize, int overlap) {
+    fftSize = std::max(kMinFftSize, std::min(kMaxFftSize, Fft::nextPowerOfTwo(fftSize)));
+    overlap = std::max(2, std::min(kMaxOverlap, Fft::nextPowerOfTwo(overlap)));
+
+    if (fftSize != m_size) {
+        // Periodic sqrt-Hann: analysis * synthesis = Hann, which overlap-adds
+        // to overlap/2 at any power-of-two overlap >= 2.
+        for (int i = 0; i < fftSize; ++i)
+            m_window[i] = static_cast<float>(std::sin(kPi * i / fftSize));
+    }
+    m_size = fftSize;
+    m_hop  = fftSize / overlap;
+    reset();
+}
+
+void PhaseVocoder::reset() {
+    for (auto& ch : m_ch) {
+        std::fill(ch.inFifo.begin(), ch.inFifo.end(), 0.0f);
+        std::fill(ch.outFifo.begin(), ch.outFifo.end(), 0.0f);
+        std::fill(ch.accum.begin(), ch.accum.end(), 0.0f);
+        std::fill(ch.lastPhase.begin(), ch.lastPhase.end(), 0.0f);
+        std::fill(ch.synthPhase.begin(), ch.synthPhase.end(), 0.0f);
+        ch.rover = m_size - m_hop;
+    }
+}
+
+const Fft& PhaseVocoder::fft() const {
+    int i = 0;
+    while ((kMinFftSize << i) < m_size) ++i;
+    return m_fft[i];
+}
+
+void PhaseVocoder::copyChannelState(int from, int to) {
+    const Channel& a = m_ch[from];
+    Channel&       b = m_ch[to];
+    const int bins = m_size / 2 + 1;
+    std::copy(a.inFifo.begin(),  a.inFifo.begin()  + m_size,     b.inFifo.begin());
+    std::copy(a.outFifo.begin(), a.outFifo.begin() + m_size,     b.outFifo.begin());
+    std::copy(a.accum.begin(),   a.accum.begin()   + 2 * m_size, b.accum.begin());
+    std::copy(a.lastPhase.begin(),  a.lastPhase.begin()  + bins, b.lastPhase.begin());
+    std::copy(a.synthPhase.begin(), a.synthPhase.begin() + bins, b.synthPhase.begin());
+    b.rover = a.rover;
+}
+
+void PhaseVocoder::process(int chIndex, const float* in, float* out, int n) {
+    Channel& ch = m_ch[chIndex];
+    const int start = m_size - m_hop;  // the FIFO keeps the frame's overlap
+
+    // A frame runs once its last input is in and its first hop is played
+    // out over the next hop samples: the oldest input of the frame comes
+    // out m_size samples after it went in.
+    for (int s = 0; s < n; ++s) {
+        const float x = in[s];
+        out[s] = ch.outFifo[ch.rover - start];
+        ch.inFifo[ch.rover] = x;
+        if (++ch.rover >= m_size) {
+            ch.rover = start;
+            processFrame(ch);
+        }
+    }
+}
+
+void PhaseVocoder::processFrame(Channel& ch) {
+    const int   N     = m_size;
+    const int   H     = m_hop;
+    const int   bins  = N / 2 + 1;
+    const float ratio = m_ratio;
+    float* re = m_re.data();
+    float* im = m_im.data();
+    const float* w = m_window.data();
+
+    // ── Analysis
+    for (int i = 0; i < N; ++i) {
+        re[i] = ch.inFifo[i] * w[i];
+        im[i] = 0.0f;
+    }
+    fft().forward(re, im);
+
+    const float invTwoPi = 0.159154943091895f;
+    const float hopBins  = static_cast<float>(H) / static_cast<float>(N);  // expected advance per bin, cycles
+    for (int k = 0; k < bins; ++k) {
+        m_mag[k]   = std::sqrt(re[k] * re[k] + im[k] * im[k]);
+        m_phase[k] = fastmath::atan2(im[k], re[k]) * invTwoPi;
+    }
+    for (int k = 0; k < bins; ++k) {
+        float dp = m_phase[k] - ch.lastPhase[k] - static_cast<float>(k) * hopBins;
+        dp -= std::floor(dp + 0.5f);
+        m_freq[k]       = static_cast<float>(k) + dp / hopBins;  // true frequency, in bins
+        ch.lastPhase[k] = m_phase[k];
+    }
+
+    // ── Peaks
+    float maxMag = 0.0f;
+    for (int k = 0; k < bins; ++k) maxMag = std::max(maxMag, m_mag[k]);
+    const float floorMag = maxMag * 1e-4f;  // -80 dB re. the frame peak
+
+    int numPeaks = 0;
+    for (int k = 1; k < bins - 1; ++k)
+        if (m_mag[k] > floorMag && m_mag[k] > m_mag[k - 1] && m_mag[k] >= m_mag[k + 1])
+            m_peaks[numPeaks++] = k;
+
+    // ── Move each peak's region, locking its bins' phases to the peak
+    std::fill(m_outMag.begin(), m_outMag.begin() + bins, 0.0f);
+    std::fill(m_outPhase.begin(), m_outPhase.begin() + bins, 0.0f);
+
+    for (int p = 0; p < numPeaks; ++p) {
+        const int   k0   = m_peaks[p];
+        const int   lo   = (p == 0) ? 0 : (m_peaks[p - 1] + k0 + 1) / 2;
+        const int   hi   = (p == numPeaks - 1) ? bins - 1 : (k0 + m_peaks[p + 1]) / 2;
+        const float f    = m_freq[k0] * ratio;
+        const int   sh   = static_cast<int>(std::lround(m_freq[k0] * (ratio - 1.0f)));
+        const int   dest = k0 + sh;
+        if (dest <= 0 || dest >= bins - 1) continue;
+
+        const float peakPhase = ch.synthPhase[dest] + f * hopBins;
+        for (int k = lo; k <= hi; ++k) {
+            const int d = k + sh;
+            if (d < 0 || d >= bins || m_mag[k] <= m_outMag[d]) continue;
+            m_outMag[d]   = m_mag[k];
+            m_outPhase[d] = peakPhase + (m_phase[k] - m_phase[k0]);
+        }
+    }
+    for (int k = 0; k < bins; ++k) {
+        float ph = m_outPhase[k];
+        ch.synthPhase[k] = ph - std::floor(ph);
+    }
+
+    // ── Synthesis
+    for (int k = 0; k < bins; ++k) {
+        re[k] = m_outMag[k] * fastmath::cos2pi(m_outPhase[k]);
+        im[k] = m_outMag[k] * fastmath::sin2pi(m_outPhase[k]);
+    }
+    for (int k = bins; k < N; ++k) {
+        re[k] =  re[N - k];
+        im[k] = -im[N - k];
+    }
+    im[0] = 0.0f;
+    im[N / 2] = 0.0f;
+    fft().inverse(re, im);
+
+    const float norm = 2.0f * static_cast<float>(H) / static_cast<float>(N);  // 2 / overlap
+    for (int i = 0; i < N; ++i)
+        ch.accum[i] += re[i] * w[i] * norm;
+
+    std::memcpy(ch.outFifo.data(), ch.accum.data(), H * sizeof(float));
+    std::memmove(ch.accum.data(), ch.accum.data() + H, N * sizeof(float));
+    std::memmove(ch.inFifo.data(), ch.inFifo.data() + H, (N - H) * sizeof(float));
+}
+
+} // namespace gearboxfx
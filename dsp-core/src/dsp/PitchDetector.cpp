@@ -0,0 +1,120 @@
+#include "dsp/PitchDetector.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gearboxfx {
+
+static constexpr double kPi = 3.14159265358979323846;
+
+void PitchDetector::prepare(double sampleRate, float minHz, float maxHz) {
+    m_sampleRate = sampleRate > 0 ? sampleRate : 48000.0;
+    m_decim      = std::max(1, static_cast<int>(std::lround(m_sampleRate / kTargetRate)));
+
+    const double rate = m_sampleRate / m_decim;
+    m_minLag = std::max(2, static_cast<int>(std::floor(rate / maxHz)));
+    m_maxLag = static_cast<int>(std::ceil(rate / minHz));
+    m_window = m_maxLag;
+    m_lpCoeff = static_cast<float>(std::exp(-2.0 * kPi * 1.25 * maxHz / m_sampleRate));
+
+    int size = 1;
+    while (size < m_window + m_maxLag + 2) size <<= 1;
+    m_ring.assign(2 * size, 0.0f);
+    m_mask = size - 1;
+    m_diff.assign(m_maxLag + 2, 0.0);
+    m_cmnd.assign(m_maxLag + 2, 1.0f);
+    reset();
+}
+
+void PitchDetector::reset() {
+    std::fill(m_ring.begin(), m_ring.end(), 0.0f);
+    std::fill(m_diff.begin(), m_diff.end(), 0.0);
+    m_lp1 = m_lp2 = 0.0f;
+    m_decimCount = 0;
+    m_pos = 0;
+    m_filled = 0;
+    m_hopCount = 0;
+    m_period = 0.0f;
+    m_confidence = 0.0f;
+}
+
+void PitchDetector::push(const float* x, int n) {
+    // Filter state in locals: x may alias the members as far as the compiler
+    // knows, which would put a store and reload in the recursion.
+    const float a = m_lpCoeff;
+    float lp1 = m_lp1, lp2 = m_lp2;
+    int   count = m_decimCount;
+    for (int i = 0; i < n; ++i) {
+        lp1 = x[i] + a * (lp1 - x[i]);
+        lp2 = lp1 + a * (lp2 - lp1);
+        if (++count == m_decim) {
+            count = 0;
+            pushDecimated(lp2);
+        }
+    }
+    m_lp1 = lp1;
+    m_lp2 = lp2;
+    m_decimCount = count;
+}
+
+void PitchDetector::pushDecimated(float z) {
+    // Each sample is stored at i and i + size, so the lags below index one
+    // contiguous run without wrapping and the loop vectorizes.
+    const int size = m_mask + 1;
+    m_ring[m_pos] = m_ring[m_pos + size] = z;
+    const int    old     = (m_pos - m_window) & m_mask;
+    const float  zOld    = m_ring[old];
+    const float* histNew = &m_ring[m_pos + size];
+    const float* histOld = &m_ring[old + size];
+    double*      diff    = m_diff.data();
+
+    // d(tau) over the last m_window samples: add the newest pair, drop the oldest
+    for (int tau = 1; tau <= m_maxLag + 1; ++tau) {
+        const float dNew = z    - histNew[-tau];
+        const float dOld = zOld - histOld[-tau];
+        diff[tau] += static_cast<double>(dNew) * dNew - static_cast<double>(dOld) * dOld;
+    }
+    m_pos = (m_pos + 1) & m_mask;
+
+    if (m_filled < m_window + m_maxLag + 1) {
+        ++m_filled;
+        return;
+    }
+    if (++m_hopCount >= kHop) {
+        m_hopCount = 0;
+        estimate();
+    }
+}
+
+void PitchDetector::estimate() {
+    // Cumulative mean normalised difference
+    double running = 0.0;
+    for (int tau = 1; tau <= m_maxLag + 1; ++tau) {
+        const double d = std::max(0.0, m_diff[tau]);
+        running += d;
+        m_cmnd[tau] = running > 0.0 ? static_cast<float>(d * tau / running) : 1.0f;
+    }
+
+    int best = -1;
+    for (int tau = m_minLag; tau <= m_maxLag; ++tau) {
+        if (m_cmnd[tau] < kThreshold) {
+            while (tau + 1 <= m_maxLag && m_cmnd[tau + 1] < m_cmnd[tau]) ++tau;
+            best = tau;
+            break;
+        }
+    }
+    if (best < 0) {
+        m_period = 0.0f;
+        m_confidence = 0.0f;
+        return;
+    }
+
+    // Parabolic interpolation around the dip
+    const float y0 = m_cmnd[best - 1], y1 = m_cmnd[best], y2 = m_cmnd[best + 1];
+    const float den = y0 - 2.0f * y1 + y2;
+    const float off = (den > 1e-9f) ? 0.5f * (y0 - y2) / den : 0.0f;
+
+    m_period     = (static_cast<float>(best) + std::max(-0.5f, std::min(0.5f, off))) * m_decim;
+    m_confidence = 1.0f - y1;
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,155 @@
+#include "dsp/PsolaShifter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gearboxfx {
+
+static constexpr double kPi = 3.14159265358979323846;
+
+void PsolaShifter::prepare(double sampleRate) {
+    sampleRate  = sampleRate > 0 ? sampleRate : 48000.0;
+    m_maxRadius = static_cast<int>(sampleRate * kMaxRadiusMs * 0.001);
+    m_detector.prepare(sampleRate);
+
+    for (int i = 0; i <= kTableSize; ++i)
+        m_window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * kPi * i / kTableSize));
+
+    // History must reach back past the oldest mark a grain can pick
+    const long long longest = m_detector.maxPeriod() + 1;
+    long long size = 1;
+    while (size < (kMaxMarks + 2) * longest + 4 * m_maxRadius) size <<= 1;
+    for (auto& b : m_in)  b.assign(static_cast<size_t>(size), 0.0f);
+    for (auto& b : m_acc) b.assign(static_cast<size_t>(size), 0.0f);
+    m_mono.assign(static_cast<size_t>(size), 0.0f);
+    m_weight.assign(static_cast<size_t>(size), 0.0f);
+    m_grainWindow.assign(static_cast<size_t>(2 * m_maxRadius), 0.0f);
+    m_grainRadius = 0;
+    m_mask = size - 1;
+    reset();
+}
+
+void PsolaShifter::reset() {
+    m_detector.reset();
+    for (auto& b : m_in)  std::fill(b.begin(), b.end(), 0.0f);
+    for (auto& b : m_acc) std::fill(b.begin(), b.end(), 0.0f);
+    std::fill(m_mono.begin(), m_mono.end(), 0.0f);
+    std::fill(m_weight.begin(), m_weight.end(), 0.0f);
+    m_now = 0;
+    std::fill(std::begin(m_marks), std::end(m_marks), 0LL);
+    m_markHead = 0;
+    m_synth = 0.0;
+}
+
+// Snap the predicted mark to the largest sample within +-period/4.
+void PsolaShifter::addMark(long long predicted, int period, long long limit) {
+    const long long lo = predicted - period / 4;
+    const long long hi = std::min(limit, predicted + period / 4);
+    long long best = predicted;
+    float bestVal = -1e30f;
+    for (long long t = lo; t <= hi; ++t) {
+        float v = m_mono[static_cast<size_t>(t & m_mask)];
+        if (v > bestVal) { bestVal = v; best = t; }
+    }
+    // Keep marks moving forward even on flat input
+    best = std::max(best, m_marks[m_markHead] + 1);
+    m_markHead = (m_markHead + 1) % kMaxMarks;
+    m_marks[m_markHead] = best;
+}
+
+long long PsolaShifter::nearestMark(long long pos) const {
+    long long best = m_marks[m_markHead];
+    for (long long m : m_marks)
+        if (std::llabs(m - pos) < std::llabs(best - pos)) best = m;
+    return best;
+}
+
+// Hann over [-r, r) from the table; grains of one radius share it.
+void PsolaShifter::setGrainRadius(int r) {
+    if (r == m_grainRadius) return;
+    m_grainRadius = r;
+    const float scale = static_cast<float>(kTableSize) / (2.0f * r);
+    for (int i = 0; i < 2 * r; ++i) {
+        float pos = static_cast<float>(i) * scale;
+        int   k   = static_cast<int>(pos);
+        m_grainWindow[i] = m_window[k] + (pos - static_cast<float>(k)) * (m_window[k + 1] - m_window[k]);
+    }
+}
+
+void PsolaShifter::addGrain(long long synth, int period, int numCh) {
+    const long long a = nearestMark(synth);
+    const int r = std::min(period, m_maxRadius);
+    setGrainRadius(r);
+
+    // Split at the ring ends so each run is a plain, vectorizable loop
+    const long long size = m_mask + 1;
+    const float* w = m_grainWindow.data();
+    for (int i = 0; i < 2 * r;) {
+        const long long dst = (synth - r + i) & m_mask;
+        const long long src = (a - r + i) & m_mask;
+        const int run = static_cast<int>(std::min<long long>(2 * r - i, size - std::max(dst, src)));
+        for (int c = 0; c < numCh; ++c) {
+            float*       acc = &m_acc[c][static_cast<size_t>(dst)];
+            const float* x   = &m_in[c][static_cast<size_t>(src)];
+            for (int j = 0; j < run; ++j) acc[j] += x[j] * w[i + j];
+        }
+        float* sum = &m_weight[static_cast<size_t>(dst)];
+        for (int j = 0; j < run; ++j) sum[j] += w[i + j];
+        i += run;
+    }
+}
+
+void PsolaShifter::process(const float* const* in, float* const* out, int numCh, int n) {
+    numCh = std::min(numCh, kChannels);
+    const long long size = m_mask + 1;
+
+    // Store the block and its channel average, in runs that don't wrap
+    const float gain = 1.0f / static_cast<float>(numCh);
+    for (int s = 0; s < n;) {
+        const long long w   = (m_now + s) & m_mask;
+        const int       run = static_cast<int>(std::min<long long>(n - s, size - w));
+        float* mono = &m_mono[static_cast<size_t>(w)];
+        std::copy(in[0] + s, in[0] + s + run, mono);
+        for (int c = 1; c < numCh; ++c)
+            for (int j = 0; j < run; ++j) mono[j] += in[c][s + j];
+        for (int j = 0; j < run; ++j) mono[j] *= gain;
+        for (int c = 0; c < numCh; ++c)
+            std::copy(in[c] + s, in[c] + s + run, &m_in[c][static_cast<size_t>(w)]);
+        m_detector.push(mono, run);
+        s += run;
+    }
+
+    // One period for the whole block
+    const float detected = m_detector.period();
+    const int   period   = detected > 0.0f ? static_cast<int>(detected + 0.5f) : m_maxRadius;
+
+    // Marks and grains up to a full radius before the end of the block. A
+    // grain at synth writes [synth - r, synth + r), so everything overlapping
+    // the output slots of this block (which end 2 radii back) is in.
+    m_now += n;
+    const long long limit = m_now - m_maxRadius;
+    while (m_marks[m_markHead] + period <= limit)
+        addMark(m_marks[m_markHead] + period, period, limit);
+    while (static_cast<long long>(m_synth) <= limit) {
+        addGrain(static_cast<long long>(m_synth), period, numCh);
+        m_synth += static_cast<double>(period) / m_ratio;
+    }
+
+    // Read the block latencySamples() back, normalised by the summed window
+    for (int s = 0; s < n;) {
+        const long long r   = (m_now - n + s - latencySamples()) & m_mask;
+        const int       run = static_cast<int>(std::min<long long>(n - s, size - r));
+        float* sum = &m_weight[static_cast<size_t>(r)];
+        for (int j = 0; j < run; ++j) sum[j] = 1.0f / std::max(1.0f, sum[j]);
+        for (int c = 0; c < numCh; ++c) {
+            float* acc = &m_acc[c][static_cast<size_t>(r)];
+            for (int j = 0; j < run; ++j) {
+                out[c][s + j] = acc[j] * sum[j];
+                acc[j] = 0.0f;
+            }
+        }
+        std::fill(sum, sum + run, 0.0f);
+        s += run;
+    }
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,189 @@
+#include "dsp/RecurrentModel.h"
+#include "dsp/FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gearboxfx {
+
+namespace {
+
+// Accepts a flat array or an array of rows; returns false on non-numeric data.
+bool flatten(const nlohmann::json& j, std::vector<float>& out) {
+    out.clear();
+    if (!j.is_array()) return false;
+    for (auto& v : j) {
+        if (v.is_number()) {
+            out.push_back(v.get<float>());
+        } else if (v.is_array()) {
+            for (auto& w : v) {
+                if (!w.is_number()) return false;
+                out.push_back(w.get<float>());
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool fail(std::string* error, const std::string& msg) {
+    if (error) *error = msg;
+    return false;
+}
+
+} // anonymous namespace
+
+void RecurrentModel::clear() {
+    m_type   = Type::None;
+    m_hidden = m_gates = m_rows = 0;
+    m_arena.clear();
+    m_source = nullptr;
+}
+
+bool RecurrentModel::load(const nlohmann::json& j, std::string* error) {
+    clear();
+
+    std::string type = j.value("type", "");
+    Type t = (type == "lstm") ? Type::Lstm : (type == "gru") ? Type::Gru : Type::None;
+    if (t == Type::None)
+        return fail(error, "unknown model type '" + type + "' (expected lstm or gru)");
+
+    const int H = j.value("hidden_size", 0);
+    if (H <= 0 || H > kMaxHiddenSize)
+        return fail(error, "hidden_size out of range");
+    if (j.value("input_size", 1) != 1)
+        return fail(error, "only input_size 1 is supported");
+
+    const int G = (t == Type::Lstm) ? 4 : 3;
+    const int n = G * H;
+
+    std::vector<float> wIh, wHh, bIh, bHh, dense;
+    if (!j.contains("weight_ih") || !flatten(j["weight_ih"], wIh) || (int)wIh.size() != n)
+        return fail(error, "weight_ih must have gates*hidden_size entries");
+    if (!j.contains("weight_hh") || !flatten(j["weight_hh"], wHh) || (int)wHh.size() != n * H)
+        return fail(error, "weight_hh must be gates*hidden_size x hidden_size");
+    if (j.contains("bias_ih") && (!flatten(j["bias_ih"], bIh) || (int)bIh.size() != n))
+        return fail(error, "bias_ih must have gates*hidden_size entries");
+    if (j.contains("bias_hh") && (!flatten(j["bias_hh"], bHh) || (int)bHh.size() != n))
+        return fail(error, "bias_hh must have gates*hidden_size entries");
+    if (!j.contains("dense_weight") || !flatten(j["dense_weight"], dense) || (int)dense.size() != H)
+        return fail(error, "dense_weight must have hidden_size entries");
+    bIh.resize(n, 0.0f);
+    bHh.resize(n, 0.0f);
+
+    const int rows = (n + kLanes - 1) / kLanes * kLanes;
+
+    // Arena: wIh | wHhT | bIh | bHh | dense | zx | zh | h | c
+    m_arena.assign(rows + H * rows + rows + rows + H + rows + rows + H + H, 0.0f);
+    float* p = m_arena.data();
+    m_wIh   = p; p += rows;
+    m_wHhT  = p; p += H * rows;
+    m_bIh   = p; p += rows;
+    m_bHh   = p; p += rows;
+    m_dense = p; p += H;
+    m_zx    = p; p += rows;
+    m_zh    = p; p += rows;
+    m_h     = p; p += H;
+    m_c     = p;
+
+    for (int r = 0; r < n; ++r) {
+        m_wIh[r] = wIh[r];
+        for (int k = 0; k < H; ++k)
+            m_wHhT[k * rows + r] = wHh[r * H + k];
+    }
+
+    // LSTM sums both biases up front; GRU keeps b_hh apart (it sits inside r * (...)).
+    for (int r = 0; r < n; ++r) {
+        if (t == Type::Lstm) { m_bIh[r] = bIh[r] + bHh[r]; m_bHh[r] = 0.0f; }
+        else                 { m_bIh[r] = bIh[r];          m_bHh[r] = bHh[r]; }
+    }
+    std::copy(dense.begin(), dense.end(), m_dense);
+
+    m_type      = t;
+    m_hidden    = H;
+    m_gates     = G;
+    m_rows      = rows;
+    m_denseBias = j.value("dense_bias", 0.0f);
+    m_skip      = j.value("skip", false);
+    m_source    = j;
+    return true;
+}
+
+void RecurrentModel::reset() {
+    if (!isLoaded()) return;
+    std::fill(m_h, m_h + m_hidden, 0.0f);
+    std::fill(m_c, m_c + m_hidden, 0.0f);
+}
+
+void RecurrentModel::copyStateFrom(const RecurrentModel& other) {
+    if (!isLoaded() || other.m_hidden != m_hidden) return;
+    std::copy(other.m_h, other.m_h + m_hidden, m_h);
+    std::copy(other.m_c, other.m_c + m_hidden, m_c);
+}
+
+// z[r] = b[r] + sum_k W[r][k] * h[k], computed as H axpy passes over the
+// transposed columns so the lane loop runs over contiguous gate rows.
+static inline void recurrentProduct(float* z, const float* b, const float* wT,
+                                    const float* h, int hidden, int rows) {
+    for (int r = 0; r < rows; ++r) z[r] = b[r];
+    for (int k = 0; k < hidden; ++k) {
+        const float  hk  = h[k];
+        const float* col = wT + k * rows;
+        for (int r = 0; r < rows; ++r)
+            z[r] += hk * col[r];
+    }
+}
+
+void RecurrentModel::stepLstm(float x) {
+    const int H = m_hidden;
+    float* z = m_zx;
+
+    recurrentProduct(z, m_bIh, m_wHhT, m_h, H, m_rows);
+    for (int r = 0; r < m_rows; ++r)
+        z[r] += m_wIh[r] * x;
+
+    for (int k = 0; k < H; ++k) {
+        float i = fastmath::sigmoid(z[k]);
+        float f = fastmath::sigmoid(z[H + k]);
+        float g = fastmath::tanh(z[2 * H + k]);
+        float o = fastmath::sigmoid(z[3 * H + k]);
+        m_c[k] = f * m_c[k] + i * g;
+        m_h[k] = o * fastmath::tanh(m_c[k]);
+    }
+}
+
+void RecurrentModel::stepGru(float x) {
+    const int H = m_hidden;
+
+    recurrentProduct(m_zh, m_bHh, m_wHhT, m_h, H, m_rows);
+    for (int r = 0; r < m_rows; ++r)
+        m_zx[r] = m_bIh[r] + m_wIh[r] * x;
+
+    for (int k = 0; k < H; ++k) {
+        float r  = fastmath::sigmoid(m_zx[k]     + m_zh[k]);
+        float u  = fastmath::sigmoid(m_zx[H + k] + m_zh[H + k]);
+        float nn = fastmath::tanh(m_zx[2 * H + k] + r * m_zh[2 * H + k]);
+        m_h[k] = (1.0f - u) * nn + u * m_h[k];
+    }
+}
+
+void RecurrentModel::process(const float* in, float* out, int numSamples) {
+    if (!isLoaded()) {
+        if (in != out)
+            std::copy(in, in + numSamples, out);
+        return;
+    }
+
+    for (int s = 0; s < numSamples; ++s) {
+        const float x = in[s];
+        if (m_type == Type::Lstm) stepLstm(x);
+        else                      stepGru(x);
+
+        float y = m_denseBias;
+        for (int k = 0; k < m_hidden; ++k)
+            y += m_dense[k] * m_h[k];
+        out[s] = m_skip ? y + x : y;
+    }
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,111 @@
+#include "dsp/Svf.h"
+#include <cmath>
+
+namespace gearboxfx {
+
+static constexpr float kPi = 3.14159265358979f;
+
+// ── Coefficients (Simper, "Linear Trap Optimised 2") ─────────────────────────
+
+SvfCoeffs SvfCoeffs::lowpass(float freqHz, float q, float sr) {
+    SvfCoeffs c;
+    c.g  = std::tan(kPi * freqHz / sr);
+    c.k  = 1.0f / q;
+    c.m0 = 0.0f; c.m1 = 0.0f; c.m2 = 1.0f;
+    return c;
+}
+
+SvfCoeffs SvfCoeffs::highpass(float freqHz, float q, float sr) {
+    SvfCoeffs c;
+    c.g  = std::tan(kPi * freqHz / sr);
+    c.k  = 1.0f / q;
+    c.m0 = 1.0f; c.m1 = -c.k; c.m2 = -1.0f;
+    return c;
+}
+
+// Matches the Audio EQ Cookbook peaking filter.
+SvfCoeffs SvfCoeffs::bell(float freqHz, float q, float gainDb, float sr) {
+    const float A = std::pow(10.0f, gainDb / 40.0f);
+    SvfCoeffs c;
+    c.g  = std::tan(kPi * freqHz / sr);
+    c.k  = 1.0f / (q * A);
+    c.m0 = 1.0f; c.m1 = c.k * (A * A - 1.0f); c.m2 = 0.0f;
+    return c;
+}
+
+// q = 1/sqrt(2) gives the Cookbook shelf with slope S = 1.
+SvfCoeffs SvfCoeffs::lowShelf(float freqHz, float q, float gainDb, float sr) {
+    const float A = std::pow(10.0f, gainDb / 40.0f);
+    SvfCoeffs c;
+    c.g  = std::tan(kPi * freqHz / sr) / std::sqrt(A);
+    c.k  = 1.0f / q;
+    c.m0 = 1.0f; c.m1 = c.k * (A - 1.0f); c.m2 = A * A - 1.0f;
+    return c;
+}
+
+SvfCoeffs SvfCoeffs::highShelf(float freqHz, float q, float gainDb, float sr) {
+    const float A = std::pow(10.0f, gainDb / 40.0f);
+    SvfCoeffs c;
+    c.g  = std::tan(kPi * freqHz / sr) * std::sqrt(A);
+    c.k  = 1.0f / q;
+    c.m0 = A * A; c.m1 = c.k * (1.0f - A) * A; c.m2 = 1.0f - A * A;
+    return c;
+}
+
+SvfCoeffs SvfCoeffs::step(const SvfCoeffs& from, const SvfCoeffs& to, int n) {
+    const float inv = 1.0f / static_cast<float>(n);
+    SvfCoeffs d;
+    d.g  = (to.g  - from.g)  * inv;
+    d.k  = (to.k  - from.k)  * inv;
+    d.m0 = (to.m0 - from.m0) * inv;
+    d.m1 = (to.m1 - from.m1) * inv;
+    d.m2 = (to.m2 - from.m2) * inv;
+    return d;
+}
+
+// ── Processing ───────────────────────────────────────────────────────────────
+
+void svfBlock(SvfState& s, const float* in, float* out, int n, const SvfCoeffs& c) {
+    const float a1 = 1.0f / (1.0f + c.g * (c.g + c.k));
+    const float a2 = c.g * a1;
+    const float a3 = c.g * a2;
+    float ic1 = s.ic1, ic2 = s.ic2;
+
+    for (int i = 0; i < n; ++i) {
+        const float v0 = in[i];
+        const float v3 = v0 - ic2;
+        const float v1 = a1 * ic1 + a2 * v3;
+        const float v2 = ic2 + a2 * ic1 + a3 * v3;
+        ic1 = 2.0f * v1 - ic1;
+        ic2 = 2.0f * v2 - ic2;
+        out[i] = c.m0 * v0 + c.m1 * v1 + c.m2 * v2;
+    }
+    s.ic1 = ic1;
+    s.ic2 = ic2;
+}
+
+void svfBlockRamp(SvfState& s, const float* in, float* out, int n,
+                  const SvfCoeffs& c, const SvfCoeffs& dc) {
+    float ic1 = s.ic1, ic2 = s.ic2;
+
+    for (int i = 0; i < n; ++i) {
+        const float t  = static_cast<float>(i + 1);
+        const float g  = c.g + dc.g * t;
+        const float k  = c.k + dc.k * t;
+        const float a1 = 1.0f / (1.0f + g * (g + k));
+        const float a2 = g * a1;
+        const float a3 = g * a2;
+
+        const float v0 = in[i];
+        const float v3 = v0 - ic2;
+        const float v1 = a1 * ic1 + a2 * v3;
+        const float v2 = ic2 + a2 * ic1 + a3 * v3;
+        ic1 = 2.0f * v1 - ic1;
+        ic2 = 2.0f * v2 - ic2;
+        out[i] = (c.m0 + dc.m0 * t) * v0 + (c.m1 + dc.m1 * t) * v1 + (c.m2 + dc.m2 * t) * v2;
+    }
+    s.ic1 = ic1;
+    s.ic2 = ic2;
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,128 @@
+#include "effects/OversampledNode.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gearboxfx {
+
+static constexpr int kFirstStageTaps = 47;
+static constexpr int kLaterStageTaps = 19;
+
+OversampledNode::OversampledNode(std::shared_ptr<EffectNode> inner, int factor)
+    : m_inner(std::move(inner))
+{
+    m_numStages = factor >= 8 ? 3 : factor >= 4 ? 2 : 1;
+
+    setTypeId(m_inner->typeId());
+    setId(m_inner->id());
+    setEnabled(m_inner->isEnabled());
+
+    for (auto& [name, def] : m_inner->paramDefs()) {
+        registerParam(name, def);
+        setParam(name, m_inner->getParam(name));
+    }
+}
+
+void OversampledNode::onPrepare(double sampleRate, int maxBlockSize) {
+    const int f = factor();
+    m_inner->prepare(sampleRate * f, maxBlockSize * f);
+
+    for (int c = 0; c < 2; ++c) {
+        for (int s = 0; s < m_numStages; ++s) {
+            int taps = (s == 0) ? kFirstStageTaps : kLaterStageTaps;
+            m_up[c][s].prepare(taps, maxBlockSize << s);
+            m_down[c][s].prepare(taps, maxBlockSize << s);
+        }
+    }
+
+    m_osIn.resize(2, maxBlockSize * f);
+    m_osOut.resize(2, maxBlockSize * f);
+    m_scratch.resize(2, maxBlockSize * f);
+    for (auto& h : m_alignHist) std::fill(std::begin(h), std::end(h), 0.0f);
+}
+
+void OversampledNode::onParamChanged(const std::string& name, float value) {
+    m_inner->setParam(name, value);
+}
+
+void OversampledNode::reset() {
+    for (int c = 0; c < 2; ++c)
+        for (int s = 0; s < m_numStages; ++s) {
+            m_up[c][s].reset();
+            m_down[c][s].reset();
+        }
+    for (auto& h : m_alignHist) std::fill(std::begin(h), std::end(h), 0.0f);
+    m_inner->reset();
+}
+
+// Each stage delays by delay() samples at its output rate, once on the way up
+// and once on the way down: 2 * delay * 2^(stages - s - 1) at the top rate.
+int OversampledNode::oversampledDelay() const {
+    int total = m_inner->latencySamples();
+    for (int s = 0; s < m_numStages; ++s)
+        total += m_up[0][s].delay() << (m_numStages - s);
+    return total;
+}
+
+int OversampledNode::alignmentDelay() const {
+    const int f = factor();
+    return (f - oversampledDelay() % f) % f;
+}
+
+int OversampledNode::latencySamples() const {
+    return (oversampledDelay() + alignmentDelay()) / factor();
+}
+
+void OversampledNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
+    const int numCh = std::min(2, output.numChannels);
+    const int osLen = numSamples * factor();
+
+    // Up: the last stage must land in m_osIn, so alternate backwards from it.
+    for (int c = 0; c < numCh; ++c) {
+        const float* src = input[std::min(c, input.numChannels - 1)];
+        int n = numSamples;
+        for (int s = 0; s < m_numStages; ++s) {
+            float* dst = ((m_numStages - 1 - s) % 2 == 0) ? m_osIn.getWritePointer(c)
+                                                          : m_scratch.getWritePointer(c);
+            m_up[c][s].upsample(src, dst, n);
+            src = dst;
+            n  *= 2;
+        }
+    }
+
+    AudioBufferView inView  = m_osIn.view();
+    AudioBufferView outView = m_osOut.view();
+    inView.numChannels  = outView.numChannels = numCh;
+    inView.numSamples   = outView.numSamples  = osLen;
+    m_inner->process(inView, outView, osLen);
+
+    // Alignment delay (a few samples at the top rate), in place on m_osOut
+    if (const int pad = alignmentDelay(); pad > 0) {
+        for (int c = 0; c < numCh; ++c) {
+            float* y = m_osOut.getWritePointer(c);
+            float  held[kMaxFactor];
+            std::memcpy(held, y + osLen - pad, pad * sizeof(float));
+            std::memmove(y + pad, y, (osLen - pad) * sizeof(float));
+            std::memcpy(y, m_alignHist[c], pad * sizeof(float));
+            std::memcpy(m_alignHist[c], held, pad * sizeof(float));
+        }
+    }
+
+    // Down: m_osIn is free again and serves as the second scratch buffer.
+    for (int c = 0; c < numCh; ++c) {
+        const float* src = m_osOut.getReadPointer(c);
+        int n = osLen / 2;
+        for (int s = m_numStages - 1; s >= 0; --s) {
+            float* dst = (s == 0)     ? output[c]
+                       : (s % 2 == 1) ? m_scratch.getWritePointer(c)
+                                      : m_osIn.getWritePointer(c);
+            m_down[c][s].downsample(src, dst, n);
+            src = dst;
+            n  /= 2;
+        }
+    }
+
+    for (int c = numCh; c < output.numChannels; ++c)
+        std::memcpy(output[c], output[numCh - 1], numSamples * sizeof(float));
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,118 @@
+#include "effects/amp/NeuralAmpNode.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+namespace gearboxfx {
+
+NeuralAmpNode::NeuralAmpNode() {
+    registerParam("input_db",  {0.0f, -24.0f, 24.0f, "Input",  "dB"});
+    registerParam("output_db", {0.0f, -24.0f, 24.0f, "Output", "dB"});
+}
+
+void NeuralAmpNode::onPrepare(double /*sampleRate*/, int /*maxBlockSize*/) {
+    m_inGain  = std::pow(10.0f, getParam("input_db")  / 20.0f);
+    m_outGain = std::pow(10.0f, getParam("output_db") / 20.0f);
+    reset();
+}
+
+void NeuralAmpNode::onParamChanged(const std::string& /*name*/, float /*value*/) {
+    m_inGain  = std::pow(10.0f, getParam("input_db")  / 20.0f);
+    m_outGain = std::pow(10.0f, getParam("output_db") / 20.0f);
+}
+
+void NeuralAmpNode::reset() {
+    if (Models* m = m_models.current())
+        for (auto& ch : m->channel) ch.reset();
+}
+
+bool NeuralAmpNode::loadModel(const nlohmann::json& model) {
+    auto models = std::make_unique<Models>();
+    std::string error;
+    if (!models->channel[0].load(model, &error)) {
+        m_error = error;
+        return false;
+    }
+    models->channel[1].load(model);
+
+    m_error.clear();
+    m_modelPath.clear();
+    m_modelSource = model;
+    m_models.publish(std::move(models));
+    return true;
+}
+
+bool NeuralAmpNode::loadModelFile(const std::string& path) {
+    std::filesystem::path full(path);
+    if (full.is_relative() && !dataDir().empty())
+        full = std::filesystem::path(dataDir()) / full;
+
+    std::ifstream f(full);
+    if (!f.is_open()) {
+        m_error = "cannot open '" + full.string() + "'";
+        return false;
+    }
+
+    nlohmann::json j;
+    try {
+        f >> j;
+    } catch (const nlohmann::json::parse_error& e) {
+        m_error = e.what();
+        return false;
+    }
+
+    if (!loadModel(j)) return false;
+    m_modelPath = path;
+    return true;
+}
+
+void NeuralAmpNode::loadData(const nlohmann::json& j) {
+    if (j.contains("model_path") && j["model_path"].is_string())
+        loadModelFile(j["model_path"].get<std::string>());
+    else if (j.contains("model") && j["model"].is_object())
+        loadModel(j["model"]);
+}
+
+nlohmann::json NeuralAmpNode::saveData() const {
+    if (!m_modelPath.empty()) return {{"model_path", m_modelPath}};
+    if (hasModel())           return {{"model", m_modelSource}};
+    return nullptr;
+}
+
+void NeuralAmpNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
+    m_models.acquire();  // a new model starts from zero state
+    Models* models = m_models.current();
+    const int numCh = std::min(2, output.numChannels);
+
+    // Inference is the expensive part: run it once when both channels carry
+    // the same (mono) signal, as they do for a guitar input.
+    bool dualMono = numCh == 2 && input.numChannels >= 2 &&
+        std::memcmp(input[0], input[1], numSamples * sizeof(float)) == 0;
+    const int runCh = dualMono ? 1 : numCh;
+
+    for (int c = 0; c < runCh; ++c) {
+        const float* in  = input[std::min(c, input.numChannels - 1)];
+        float*       out = output[c];
+
+        for (int s = 0; s < numSamples; ++s)
+            out[s] = in[s] * m_inGain;
+
+        if (models)
+            models->channel[c].process(out, out, numSamples);
+
+        for (int s = 0; s < numSamples; ++s)
+            out[s] *= m_outGain;
+    }
+
+    // Keep the idle channel's state in step so a later stereo block starts clean.
+    if (dualMono && models)
+        models->channel[1].copyStateFrom(models->channel[0]);
+
+    for (int c = runCh; c < output.numChannels; ++c)
+        std::memcpy(output[c], output[runCh - 1], numSamples * sizeof(float));
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,229 @@
+#include "effects/cab/ShortIRCabNode.h"
+#include "dsp/Fft.h"
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+namespace gearboxfx {
+
+static constexpr double kPi = 3.14159265358979323846;
+
+namespace {
+
+// Audio EQ Cookbook biquad, double precision (only used to synthesize the built-in IR).
+struct Biquad {
+    double b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+    double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+    double process(double x) {
+        double y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        x2 = x1; x1 = x;
+        y2 = y1; y1 = y;
+        return y;
+    }
+
+    static Biquad make(double b0, double b1, double b2, double a0, double a1, double a2) {
+        Biquad q;
+        q.b0 = b0 / a0; q.b1 = b1 / a0; q.b2 = b2 / a0;
+        q.a1 = a1 / a0; q.a2 = a2 / a0;
+        return q;
+    }
+
+    static Biquad highpass(double fc, double q, double sr) {
+        double w = 2.0 * kPi * fc / sr, c = std::cos(w), al = std::sin(w) / (2.0 * q);
+        return make((1 + c) / 2, -(1 + c), (1 + c) / 2, 1 + al, -2 * c, 1 - al);
+    }
+
+    static Biquad lowpass(double fc, double q, double sr) {
+        double w = 2.0 * kPi * fc / sr, c = std::cos(w), al = std::sin(w) / (2.0 * q);
+        return make((1 - c) / 2, 1 - c, (1 - c) / 2, 1 + al, -2 * c, 1 - al);
+    }
+
+    static Biquad peaking(double fc, double q, double gainDb, double sr) {
+        double A = std::pow(10.0, gainDb / 40.0);
+        double w = 2.0 * kPi * fc / sr, c = std::cos(w), al = std::sin(w) / (2.0 * q);
+        return make(1 + al * A, -2 * c, 1 - al * A, 1 + al / A, -2 * c, 1 - al / A);
+    }
+};
+
+} // anonymous namespace
+
+ShortIRCabNode::ShortIRCabNode() {
+    registerParam("taps",     {256.0f, 32.0f, 1024.0f, "Taps",  ""});
+    registerParam("level_db", {  0.0f, -24.0f,  12.0f, "Level", "dB"});
+}
+
+void ShortIRCabNode::onPrepare(double /*sampleRate*/, int maxBlockSize) {
+    for (int c = 0; c < 2; ++c)
+        m_fir[c].prepare(kMaxTaps, maxBlockSize);
+    m_taps     = static_cast<int>(getParam("taps") + 0.5f);
+    m_levelLin = std::pow(10.0f, getParam("level_db") / 20.0f);
+    rebuildImpulse();
+}
+
+void ShortIRCabNode::onParamChanged(const std::string& /*name*/, float /*value*/) {
+    m_taps     = static_cast<int>(getParam("taps") + 0.5f);
+    m_levelLin = std::pow(10.0f, getParam("level_db") / 20.0f);
+    if (!m_minPhaseIr.empty())
+        rebuildKernel();
+}
+
+void ShortIRCabNode::setImpulseResponse(const float* ir, int length, double irSampleRate) {
+    m_userIr.assign(ir, ir + std::max(0, length));
+    m_userIrRate = irSampleRate;
+    if (!m_minPhaseIr.empty())  // otherwise onPrepare() builds it
+        rebuildImpulse();
+}
+
+void ShortIRCabNode::loadData(const nlohmann::json& j) {
+    if (!j.contains("ir") || !j["ir"].is_array()) return;
+    auto ir = j["ir"].get<std::vector<float>>();
+    setImpulseResponse(ir.data(), static_cast<int>(ir.size()), j.value("ir_sample_rate", 0.0));
+}
+
+nlohmann::json ShortIRCabNode::saveData() const {
+    if (m_userIr.empty()) return nullptr;
+    return {{"ir", m_userIr}, {"ir_sample_rate", m_userIrRate}};
+}
+
+void ShortIRCabNode::rebuildImpulse() {
+    double sr = m_sampleRate > 0 ? m_sampleRate : 48000.0;
+
+    std::vector<float> ir;
+    if (m_userIr.empty()) {
+        ir = makeDefaultIr(sr, kMaxTaps);
+    } else if (m_userIrRate <= 0.0 || std::abs(m_userIrRate - sr) < 0.5) {
+        ir.assign(m_userIr.begin(),
+                  m_userIr.begin() + std::min<size_t>(m_userIr.size(), kMaxIrLength));
+    } else {
+        // Linear-interpolation resample to the node rate (cab IRs are band-limited
+        // well below Nyquist, so this is transparent in practice).
+        double step = m_userIrRate / sr;
+        int    len  = std::min(kMaxIrLength,
+                               static_cast<int>(m_userIr.size() / step));
+        ir.resize(std::max(1, len));
+        for (int i = 0; i < len; ++i) {
+            double pos = i * step;
+            size_t i0  = static_cast<size_t>(pos);
+            size_t i1  = std::min(i0 + 1, m_userIr.size() - 1);
+            double fr  = pos - static_cast<double>(i0);
+            ir[i] = static_cast<float>(m_userIr[i0] * (1.0 - fr) + m_userIr[i1] * fr);
+        }
+    }
+
+    m_minPhaseIr = makeMinimumPhase(ir, kMaxTaps);
+    rebuildKernel();
+}
+
+void ShortIRCabNode::rebuildKernel() {
+    const int taps = std::max(1, std::min(m_taps, kMaxTaps));
+    const int fade = std::max(8, taps / 8);
+
+    auto kernel = std::make_unique<Kernel>();
+    kernel->h.resize(taps);
+    for (int k = 0; k < taps; ++k) {
+        float w = 1.0f;
+        int   fromEnd = taps - 1 - k;
+        if (fromEnd < fade)  // half-Hann fade-out over the last taps
+            w = 0.5f - 0.5f * std::cos(static_cast<float>(kPi) * fromEnd / fade);
+        kernel->h[k] = m_minPhaseIr[k] * w * m_levelLin;
+    }
+    m_kernel.publish(std::move(kernel));
+}
+
+// Built-in 4x12-style response: 75 Hz high-pass, low resonance bump,
+// low-mid scoop, presence peak and a steep roll-off above ~4.5 kHz.
+// Normalized to unity gain at 1 kHz.
+std::vector<float> ShortIRCabNode::makeDefaultIr(double sampleRate, int length) {
+    Biquad stages[] = {
+        Biquad::highpass(75.0,   0.707,       sampleRate),
+        Biquad::peaking (110.0,  1.2,   4.0,  sampleRate),
+        Biquad::peaking (400.0,  1.0,  -2.5,  sampleRate),
+        Biquad::peaking (2200.0, 1.4,   3.0,  sampleRate),
+        Biquad::lowpass (4500.0, 0.707,       sampleRate),
+        Biquad::lowpass (5000.0, 0.9,         sampleRate),
+    };
+
+    std::vector<float> ir(length);
+    for (int n = 0; n < length; ++n) {
+        double x = (n == 0) ? 1.0 : 0.0;
+        for (auto& st : stages) x = st.process(x);
+        ir[n] = static_cast<float>(x);
+    }
+
+    double w = 2.0 * kPi * 1000.0 / sampleRate, re = 0.0, im = 0.0;
+    for (int n = 0; n < length; ++n) {
+        re += ir[n] * std::cos(w * n);
+        im -= ir[n] * std::sin(w * n);
+    }
+    double mag = std::sqrt(re * re + im * im);
+    if (mag > 1e-9)
+        for (auto& v : ir) v = static_cast<float>(v / mag);
+    return ir;
+}
+
+// Homomorphic minimum-phase conversion: fold the real cepstrum of log|H| onto
+// positive quefrencies, then exponentiate back. Zero-padding by 4x keeps
+// cepstral aliasing well below the float noise floor for cabinet IRs.
+std::vector<float> ShortIRCabNode::makeMinimumPhase(const std::vector<float>& ir, int outLength) {
+    const int n = Fft::nextPowerOfTwo(std::max<int>(static_cast<int>(ir.size()), outLength)) * 4;
+
+    Fft fft;
+    fft.prepare(n);
+
+    std::vector<float> re(n, 0.0f), im(n, 0.0f);
+    std::copy(ir.begin(), ir.end(), re.begin());
+    fft.forward(re.data(), im.data());
+
+    for (int k = 0; k < n; ++k) {
+        float mag = std::sqrt(re[k] * re[k] + im[k] * im[k]);
+        re[k] = std::log(std::max(mag, 1e-7f));
+        im[k] = 0.0f;
+    }
+    fft.inverse(re.data(), im.data());  // re = real cepstrum
+
+    for (int k = 1; k < n / 2; ++k) re[k] *= 2.0f;
+    for (int k = n / 2 + 1; k < n; ++k) re[k] = 0.0f;
+    std::fill(im.begin(), im.end(), 0.0f);
+    fft.forward(re.data(), im.data());  // complex log spectrum of the min-phase IR
+
+    for (int k = 0; k < n; ++k) {
+        float mag = std::exp(re[k]);
+        float ph  = im[k];
+        re[k] = mag * std::cos(ph);
+        im[k] = mag * std::sin(ph);
+    }
+    fft.inverse(re.data(), im.data());
+
+    return std::vector<float>(re.begin(), re.begin() + outLength);
+}
+
+void ShortIRCabNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
+    if (m_kernel.acquire()) {
+        const Kernel& k = *m_kernel.current();
+        for (int c = 0; c < 2; ++c)
+            m_fir[c].setKernel(k.h.data(), static_cast<int>(k.h.size()));
+    }
+
+    const int numCh = std::min(2, output.numChannels);
+
+    // Mono sources are usually duplicated onto both channels; filter once and
+    // copy, keeping the second filter's history in step.
+    bool dualMono = numCh == 2 && input.numChannels >= 2 &&
+        std::memcmp(input[0], input[1], numSamples * sizeof(float)) == 0;
+
+    if (dualMono) {
+        m_fir[1].pushHistory(input[1], numSamples);
+        m_fir[0].process(input[0], output[0], numSamples);
+        std::memcpy(output[1], output[0], numSamples * sizeof(float));
+    } else {
+        for (int c = 0; c < numCh; ++c)
+            m_fir[c].process(input[std::min(c, input.numChannels - 1)], output[c], numSamples);
+    }
+
+    for (int c = numCh; c < output.numChannels; ++c)
+        std::memcpy(output[c], output[numCh - 1], numSamples * sizeof(float));
+}
+
+} // namespace gearboxfx
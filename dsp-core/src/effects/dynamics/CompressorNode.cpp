@@ -1,4 +1,5 @@
 #include "effects/dynamics/CompressorNode.h"
+#include "dsp/FastMath.h"
 #include <cmath>
 #include <algorithm>
 
@@ -13,7 +14,8 @@ CompressorNode::CompressorNode() {
     registerParam("knee_db",      {  6.0f,   0.0f,  24.0f, "Knee",      "dB"});
 }
 
-void CompressorNode::onPrepare(double /*sampleRate*/, int /*maxBlockSize*/) {
+void CompressorNode::onPrepare(double /*sampleRate*/, int maxBlockSize) {
+    m_envBuf.assign(maxBlockSize, 0.0f);
     m_envelope = -96.0f;
     recalcCoeffs();
 }
@@ -25,6 +27,7 @@ void CompressorNode::onParamChanged(const std::string& /*name*/, float /*value*/
 void CompressorNode::recalcCoeffs() {
     float makeupDb = getParam("makeup_db");
     m_makeupLin    = std::pow(10.0f, makeupDb / 20.0f);
+    m_thresholdDb  = getParam("threshold_db");
     m_ratio        = getParam("ratio");
     m_kneeDb       = getParam("knee_db");
 
@@ -35,50 +38,64 @@ void CompressorNode::recalcCoeffs() {
     m_releaseCoeff  = static_cast<float>(std::exp(-1.0 / (sr * releaseMs * 0.001)));
 }
 
-// Soft-knee gain computation (in dB domain).
-float CompressorNode::computeGainDb(float inputDb) const {
-    float threshDb = getParam("threshold_db");
-    float diff     = inputDb - threshDb;
-    float halfKnee = m_kneeDb * 0.5f;
+void CompressorNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
+    static constexpr float kEpsSq = 1e-20f;  // -200 dB detector floor
 
-    float gainDb;
-    if (diff < -halfKnee) {
-        gainDb = 0.0f;  // below knee: no compression
-    } else if (diff < halfKnee) {
-        // Within knee: smooth transition
-        float x = (diff + halfKnee) / m_kneeDb;
-        gainDb  = (1.0f / m_ratio - 1.0f) * x * x * m_kneeDb * 0.5f;
-    } else {
-        gainDb = (1.0f / m_ratio - 1.0f) * diff;
-    }
-    return gainDb;
-}
+    const int numCh = input.numChannels;
+    float*    env   = m_envBuf.data();
 
-void CompressorNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
-    static constexpr float kEps = 1e-10f;
+    // Detector: mean square across channels → dB (10*log10, no sqrt needed)
+    std::fill(env, env + numSamples, 0.0f);
+    for (int c = 0; c < numCh; ++c) {
+        const float* x = input[c];
+        for (int s = 0; s < numSamples; ++s)
+            env[s] += x[s] * x[s];
+    }
+    const float invCh = 1.0f / static_cast<float>(std::max(1, numCh));
+    for (int s = 0; s < numSamples; ++s)
+        env[s] = 0.5f * fastmath::linearToDb(env[s] * invCh + kEpsSq);
 
+    // Envelope follower in dB domain — the only serial part
+    float e      = m_envelope;
+    float maxEnv = e;
     for (int s = 0; s < numSamples; ++s) {
-        // Sum of squares across channels for level detection
-        float sumSq = 0.0f;
-        for (int c = 0; c < input.numChannels; ++c) {
-            float x = input[c][s];
-            sumSq += x * x;
-        }
-        float rms = std::sqrt(sumSq / std::max(1, input.numChannels));
-        float rmsDb = 20.0f * std::log10(rms + kEps);
-
-        // Envelope follower in dB domain
-        if (rmsDb > m_envelope)
-            m_envelope = rmsDb + m_attackCoeff  * (m_envelope - rmsDb);
-        else
-            m_envelope = rmsDb + m_releaseCoeff * (m_envelope - rmsDb);
+        float level = env[s];
+        float coeff = (level > e) ? m_attackCoeff : m_releaseCoeff;
+        e      = level + coeff * (e - level);
+        env[s] = e;
+        maxEnv = std::max(maxEnv, e);
+    }
+    m_envelope = e;
 
-        float gainDb  = computeGainDb(m_envelope);
-        float gainLin = std::pow(10.0f, gainDb / 20.0f) * m_makeupLin;
+    const float halfKnee = m_kneeDb * 0.5f;
 
+    // Steady state: envelope never reached the knee → fixed makeup gain
+    if (maxEnv < m_thresholdDb - halfKnee) {
+        m_gainReductionDb.store(0.0f, std::memory_order_relaxed);
         for (int c = 0; c < output.numChannels; ++c)
-            output[c][s] = input[c][s] * gainLin;
+            for (int s = 0; s < numSamples; ++s)
+                output[c][s] = input[c][s] * m_makeupLin;
+        return;
     }
+
+    // Soft-knee gain computer, branch-free:
+    //   g = slope * (x^2 / (2*knee) + max(0, diff - knee/2)),  x = clamp(diff + knee/2, 0, knee)
+    // which is 0 below the knee, the quadratic inside it and slope * diff above it.
+    const float slope    = 1.0f / m_ratio - 1.0f;
+    const float invTwoK  = m_kneeDb > 1e-6f ? 0.5f / m_kneeDb : 0.0f;
+    float deepest = 0.0f;
+    for (int s = 0; s < numSamples; ++s) {
+        float diff = env[s] - m_thresholdDb;
+        float x    = std::min(m_kneeDb, std::max(0.0f, diff + halfKnee));
+        float g    = slope * (x * x * invTwoK + std::max(0.0f, diff - halfKnee));
+        env[s]     = fastmath::dbToLinear(g) * m_makeupLin;
+        deepest    = std::min(deepest, g);
+    }
+    m_gainReductionDb.store(deepest, std::memory_order_relaxed);
+
+    for (int c = 0; c < output.numChannels; ++c)
+        for (int s = 0; s < numSamples; ++s)
+            output[c][s] = input[c][s] * env[s];
 }
 
 } // namespace gearboxfx
@@ -1,5 +1,7 @@
 #include "effects/dynamics/NoiseGateNode.h"
 #include <cmath>
+#include <algorithm>
+#include <cstring>
 
 namespace gearboxfx {
 
@@ -9,7 +11,8 @@ NoiseGateNode::NoiseGateNode() {
     registerParam("release_ms",   {100.0f,  10.0f, 2000.0f,"Release",   "ms"});
 }
 
-void NoiseGateNode::onPrepare(double /*sampleRate*/, int /*maxBlockSize*/) {
+void NoiseGateNode::onPrepare(double /*sampleRate*/, int maxBlockSize) {
+    m_target.assign(maxBlockSize, 0.0f);
     m_envelope = 0.0f;
     m_gate     = 0.0f;
     recalcCoeffs();
@@ -32,6 +35,14 @@ void NoiseGateNode::recalcCoeffs() {
 }
 
 void NoiseGateNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
+    static constexpr float kSmooth = 0.01f;
+    static constexpr float kSnap   = 1e-5f;  // land on the target (the float ramp stalls ~3e-6 below 1)
+    static constexpr float kClosedDb = -96.0f;
+
+    float* target = m_target.data();
+
+    // Detector + envelope; remember whether the gate wants to move at all.
+    bool anyOpen = false, anyClosed = false;
     for (int s = 0; s < numSamples; ++s) {
         // Compute peak envelope from all channels
         float peak = 0.0f;
@@ -44,13 +55,40 @@ void NoiseGateNode::process(AudioBufferView input, AudioBufferView output, int n
         else
             m_envelope = peak + m_releaseCoeff * (m_envelope - peak);
 
-        // Smooth gate state
-        float target = (m_envelope > m_threshold) ? 1.0f : 0.0f;
-        m_gate += 0.01f * (target - m_gate);
+        bool open  = m_envelope > m_threshold;
+        target[s]  = open ? 1.0f : 0.0f;
+        anyOpen   |= open;
+        anyClosed |= !open;
+    }
 
+    // Steady states: fully open → copy, fully closed → silence.
+    if (m_gate == 1.0f && !anyClosed) {
+        m_gainReductionDb.store(0.0f, std::memory_order_relaxed);
+        for (int c = 0; c < output.numChannels; ++c)
+            if (output[c] != input[c])
+                std::memcpy(output[c], input[c], numSamples * sizeof(float));
+        return;
+    }
+    if (m_gate == 0.0f && !anyOpen) {
+        m_gainReductionDb.store(kClosedDb, std::memory_order_relaxed);
         for (int c = 0; c < output.numChannels; ++c)
-            output[c][s] = input[c][s] * m_gate;
+            std::memset(output[c], 0, numSamples * sizeof(float));
+        return;
     }
+
+    // Smooth gate state (reuses the target buffer for the per-sample gain)
+    float g = m_gate;
+    for (int s = 0; s < numSamples; ++s) {
+        g += kSmooth * (target[s] - g);
+        g  = (std::abs(target[s] - g) < kSnap) ? target[s] : g;
+        target[s] = g;
+    }
+    m_gate = g;
+    m_gainReductionDb.store(std::max(kClosedDb, 20.0f * std::log10(g + 1e-9f)), std::memory_order_relaxed);
+
+    for (int c = 0; c < output.numChannels; ++c)
+        for (int s = 0; s < numSamples; ++s)
+            output[c][s] = input[c][s] * target[s];
 }
 
 } // namespace gearboxfx
@@ -11,17 +11,23 @@ DistortionNode::DistortionNode() {
     registerParam("tone",       {0.5f, 0.0f, 1.0f, "Tone",       ""});
     registerParam("level",      {0.8f, 0.0f, 1.0f, "Level",      ""});
     registerParam("asymmetry",  {0.3f, 0.0f, 1.0f, "Asymmetry",  ""});
+    registerParam("antialias",  {0.0f, 0.0f, 2.0f, "Anti-alias", ""});
 }
 
-void DistortionNode::onPrepare(double /*sampleRate*/, int /*maxBlockSize*/) {
+void DistortionNode::onPrepare(double /*sampleRate*/, int maxBlockSize) {
     m_hpState[0] = m_hpState[1] = 0.0f;
     m_hpPrev [0] = m_hpPrev [1] = 0.0f;
     m_lpState[0] = m_lpState[1] = 0.0f;
+    for (auto& a : m_adaa) a.prepare(maxBlockSize);
     recalcThresholds();
     recalcLpFilter();
 }
 
-void DistortionNode::onParamChanged(const std::string& /*name*/, float /*value*/) {
+void DistortionNode::onParamChanged(const std::string& name, float /*value*/) {
+    if (name == "antialias") {
+        m_adaaOrder = static_cast<int>(getParam("antialias") + 0.5f);
+        for (auto& a : m_adaa) a.reset();
+    }
     recalcThresholds();
     recalcLpFilter();
     m_gain      = getParam("gain");
@@ -61,8 +67,13 @@ void DistortionNode::process(AudioBufferView input, AudioBufferView output, int
     // Pre-gain: drive harder into clipper
     float driveGain = 1.0f + m_gain * 30.0f;
 
+    AsymClipShaper clipper;
+    clipper.pos = posT;
+    clipper.neg = negT;
+
     for (int c = 0; c < output.numChannels; ++c) {
         int ch = (c < 2) ? c : 1;
+        float* out = output[c];
 
         for (int s = 0; s < numSamples; ++s) {
             // High-pass at input (DC blocker)
@@ -72,19 +83,20 @@ void DistortionNode::process(AudioBufferView input, AudioBufferView output, int
             m_hpState[ch] = hp;
 
             // Drive into hard clipper
-            float driven = hp * driveGain;
-            float clipped;
-            if (driven > posT)
-                clipped = posT;
-            else if (driven < -negT)
-                clipped = -negT;
-            else
-                clipped = driven;
+            out[s] = hp * driveGain;
+        }
 
-            // 1-pole LP tone filter
-            m_lpState[ch] = lpOneMinA * clipped + lpA * m_lpState[ch];
+        if (m_adaaOrder == 0) {
+            for (int s = 0; s < numSamples; ++s)
+                out[s] = std::min(posT, std::max(-negT, out[s]));
+        } else {
+            m_adaa[ch].process(out, numSamples, m_adaaOrder, clipper);
+        }
 
-            output[c][s] = m_lpState[ch] * m_level;
+        for (int s = 0; s < numSamples; ++s) {
+            // 1-pole LP tone filter
+            m_lpState[ch] = lpOneMinA * out[s] + lpA * m_lpState[ch];
+            out[s] = m_lpState[ch] * m_level;
         }
     }
 }
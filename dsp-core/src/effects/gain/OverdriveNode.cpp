@@ -1,4 +1,5 @@
 #include "effects/gain/OverdriveNode.h"
+#include "dsp/FastMath.h"
 #include <cmath>
 
 namespace gearboxfx {
@@ -9,14 +10,20 @@ OverdriveNode::OverdriveNode() {
     registerParam("gain",  {0.5f, 0.0f, 1.0f, "Gain",  ""});
     registerParam("tone",  {0.5f, 0.0f, 1.0f, "Tone",  ""});
     registerParam("level", {0.7f, 0.0f, 1.0f, "Level", ""});
+    registerParam("antialias", {0.0f, 0.0f, 2.0f, "Anti-alias", ""});
 }
 
-void OverdriveNode::onPrepare(double /*sampleRate*/, int /*maxBlockSize*/) {
+void OverdriveNode::onPrepare(double /*sampleRate*/, int maxBlockSize) {
     m_toneState[0] = m_toneState[1] = 0.0f;
+    for (auto& a : m_adaa) a.prepare(maxBlockSize);
     recalcToneFilter();
 }
 
-void OverdriveNode::onParamChanged(const std::string& /*name*/, float /*value*/) {
+void OverdriveNode::onParamChanged(const std::string& name, float /*value*/) {
+    if (name == "antialias") {
+        m_adaaOrder = static_cast<int>(getParam("antialias") + 0.5f);
+        for (auto& a : m_adaa) a.reset();
+    }
     recalcToneFilter();
     m_gain  = getParam("gain");
     m_tone  = getParam("tone");
@@ -40,17 +47,28 @@ void OverdriveNode::process(AudioBufferView input, AudioBufferView output, int n
     float invPiHalf   = 2.0f / kPi;
     float a           = m_toneCoeff;
     float oneMinusA   = 1.0f - a;
+    AtanShaper shaper;
 
     for (int c = 0; c < output.numChannels; ++c) {
         int ch = (c < 2) ? c : 1;
         float& state = m_toneState[ch];
+        float* out   = output[c];
+
+        for (int s = 0; s < numSamples; ++s)
+            out[s] = input[c][s] * driveAmount;
+
+        // Soft arctan saturation
+        if (m_adaaOrder == 0) {
+            for (int s = 0; s < numSamples; ++s)
+                out[s] = invPiHalf * fastmath::atan(out[s]);
+        } else {
+            m_adaa[ch].process(out, numSamples, m_adaaOrder, shaper);
+        }
 
         for (int s = 0; s < numSamples; ++s) {
-            float pre  = input[c][s] * driveAmount;
-            float clip = invPiHalf * std::atan(pre);   // soft arctan saturation
             // 1-pole IIR tone filter
-            state = oneMinusA * clip + a * state;
-            output[c][s] = state * m_level;
+            state  = oneMinusA * out[s] + a * state;
+            out[s] = state * m_level;
         }
     }
 }
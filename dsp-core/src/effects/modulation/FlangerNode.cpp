@@ -4,8 +4,6 @@
 
 namespace gearboxfx {
 
-static constexpr float kTwoPi = 6.28318530717959f;
-
 FlangerNode::FlangerNode() {
     registerParam("rate",     {0.3f, 0.1f,  5.0f,  "Rate",     "Hz"});
     registerParam("depth",    {0.8f, 0.0f,  1.0f,  "Depth",    ""});
@@ -13,34 +11,22 @@ FlangerNode::FlangerNode() {
     registerParam("mix",      {0.5f, 0.0f,  1.0f,  "Mix",      ""});
 }
 
-void FlangerNode::onPrepare(double sampleRate, int /*maxBlockSize*/) {
-    for (int c = 0; c < 2; ++c)
-        m_delayBuf[c].assign(kMaxDelaySamp, 0.0f);
-    m_writePos   = 0;
-    m_lfoPhase   = 0.0f;
-    float rate   = getParam("rate");
-    m_lfoIncrement = rate / static_cast<float>(sampleRate);
+void FlangerNode::onPrepare(double sampleRate, int maxBlockSize) {
+    m_delay.prepare(static_cast<int>(std::ceil(kMaxDelayMs * 0.001 * sampleRate)));
+    m_lfoBuf.assign(maxBlockSize, 0.0f);
+    m_lfo.prepare(sampleRate);
+    m_lfo.setRate(getParam("rate"));
+    m_lfo.reset();
 }
 
 void FlangerNode::onParamChanged(const std::string& /*name*/, float /*value*/) {
-    double sr    = m_sampleRate > 0 ? m_sampleRate : 48000.0;
-    m_lfoIncrement = getParam("rate") / static_cast<float>(sr);
-}
-
-float FlangerNode::readDelayLinear(const std::vector<float>& buf, float delaySamps) const {
-    int   d0  = static_cast<int>(delaySamps);
-    float fr  = delaySamps - static_cast<float>(d0);
-    int   i0  = (m_writePos - d0 + kMaxDelaySamp)     % kMaxDelaySamp;
-    int   i1  = (m_writePos - d0 - 1 + kMaxDelaySamp) % kMaxDelaySamp;
-    return buf[i0] * (1.0f - fr) + buf[i1] * fr;
+    m_lfo.setRate(getParam("rate"));
 }
 
 void FlangerNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
-    float rate     = getParam("rate");
     float depth    = getParam("depth");
     float feedback = getParam("feedback");
     float mix      = getParam("mix");
-    (void)rate;
 
     double sr   = m_sampleRate > 0 ? m_sampleRate : 48000.0;
     // Flanger delay range: 1ms – 7ms, modulated around center 4ms
@@ -49,24 +35,23 @@ void FlangerNode::process(AudioBufferView input, AudioBufferView output, int num
 
     float dryGain = 1.0f - mix;
     float wetGain = mix;
+    float maxDel  = m_delay.maxDelay();
+
+    m_lfo.process(m_lfoBuf.data(), numSamples);
 
     for (int s = 0; s < numSamples; ++s) {
-        float lfo = std::sin(kTwoPi * m_lfoPhase);
-        float del = center + modAmp * lfo;
-        del = std::max(1.0f, std::min(del, static_cast<float>(kMaxDelaySamp - 2)));
+        float del = center + modAmp * m_lfoBuf[s];
+        del = std::max(1.0f, std::min(del, maxDel));
 
         for (int c = 0; c < output.numChannels; ++c) {
             int ch  = (c < 2) ? c : 1;
-            float wet = readDelayLinear(m_delayBuf[ch], del);
+            float wet = m_delay.read(ch, del);
             output[c][s] = input[c][s] * dryGain + wet * wetGain;
             // Write input + feedback into delay buffer
-            m_delayBuf[ch][m_writePos] = input[c][s] + wet * feedback;
+            m_delay.push(ch, input[c][s] + wet * feedback);
         }
 
-        m_lfoPhase += m_lfoIncrement;
-        if (m_lfoPhase >= 1.0f) m_lfoPhase -= 1.0f;
-
-        m_writePos = (m_writePos + 1) % kMaxDelaySamp;
+        m_delay.advance();
     }
 }
 
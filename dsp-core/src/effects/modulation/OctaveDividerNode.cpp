@@ -0,0 +1,90 @@
+#include "effects/modulation/OctaveDividerNode.h"
+#include <cmath>
+#include <algorithm>
+
+namespace gearboxfx {
+
+static constexpr double kPi = 3.14159265358979323846;
+
+static constexpr float kMinHz      = 40.0f;
+static constexpr float kMaxHz      = 1500.0f;
+static constexpr float kStartHz    = 300.0f;  // until the first period is measured
+static constexpr float kHysteresis = 0.1f;    // of the envelope
+
+OctaveDividerNode::OctaveDividerNode() {
+    registerParam("sub", {0.5f, 0.0f, 1.0f, "Sub Octave", ""});
+    registerParam("up",  {0.0f, 0.0f, 1.0f, "Octave Up",  ""});
+    registerParam("dry", {1.0f, 0.0f, 1.0f, "Dry",        ""});
+}
+
+float OctaveDividerNode::trackingCoeff(float hz) const {
+    return static_cast<float>(std::exp(-2.0 * kPi * hz / m_sr));
+}
+
+void OctaveDividerNode::onPrepare(double sampleRate, int /*maxBlockSize*/) {
+    m_sr       = sampleRate > 0 ? sampleRate : 48000.0;
+    m_envCoeff = static_cast<float>(std::exp(-1.0 / (m_sr * 0.010)));
+    m_dcCoeff  = trackingCoeff(20.0f);
+    for (auto& v : m_voice) {
+        v = Voice{};
+        v.coeff = trackingCoeff(kStartHz);
+    }
+}
+
+void OctaveDividerNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
+    const float sub = getParam("sub");
+    const float up  = getParam("up");
+    const float dry = getParam("dry");
+    const int   minPeriod = static_cast<int>(m_sr / kMaxHz);
+    const int   maxPeriod = static_cast<int>(m_sr / kMinHz);
+
+    const int numCh = std::min(2, output.numChannels);
+    for (int c = 0; c < numCh; ++c) {
+        const float* in  = input[std::min(c, input.numChannels - 1)];
+        float*       out = output[c];
+        Voice&       v   = m_voice[c];
+
+        for (int s = 0; s < numSamples; ++s) {
+            const float x = in[s];
+
+            // Tracking low-pass isolates the fundamental
+            v.lp1 = x     + v.coeff * (v.lp1 - x);
+            v.lp2 = v.lp1 + v.coeff * (v.lp2 - v.lp1);
+            const float f = v.lp2;
+
+            const float ax = std::abs(f);
+            v.env = ax + m_envCoeff * (v.env - ax);
+
+            // Schmitt trigger; each rising crossing toggles the flip-flop
+            // and re-tunes the tracking filters to 1.5x the measured pitch.
+            // The count saturates past the window so silence cannot overflow it.
+            if (v.sinceCross <= maxPeriod) ++v.sinceCross;
+            const float h = kHysteresis * v.env;
+            if (!v.high && f > h) {
+                v.high = true;
+                v.flip = -v.flip;
+                if (v.sinceCross >= minPeriod && v.sinceCross <= maxPeriod)
+                    v.coeff = trackingCoeff(1.5f * static_cast<float>(m_sr) / v.sinceCross);
+                v.sinceCross = 0;
+            } else if (v.high && f < -h) {
+                v.high = false;
+            }
+
+            // Sub: enveloped square at f/2, rounded by the same tracking pole
+            const float sq = v.flip * v.env;
+            v.subLp = sq + v.coeff * (v.subLp - sq);
+
+            // Up: |f| has its fundamental at 2f; subtract its running mean
+            v.upLp = ax + m_dcCoeff * (v.upLp - ax);
+            const float oct = 2.0f * (ax - v.upLp);
+
+            out[s] = dry * x + sub * 2.0f * v.subLp + up * oct;
+        }
+    }
+
+    for (int c = numCh; c < output.numChannels; ++c)
+        for (int s = 0; s < numSamples; ++s)
+            output[c][s] = output[numCh - 1][s];
+}
+
+} // namespace gearboxfx
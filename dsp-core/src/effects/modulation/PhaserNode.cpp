@@ -1,11 +1,11 @@
 #include "effects/modulation/PhaserNode.h"
+#include "dsp/FastMath.h"
 #include <cmath>
 #include <algorithm>
 
 namespace gearboxfx {
 
 static constexpr float kPi    = 3.14159265358979f;
-static constexpr float kTwoPi = 6.28318530717959f;
 
 PhaserNode::PhaserNode() {
     registerParam("rate",     {0.5f, 0.1f, 5.0f, "Rate",     "Hz"});
@@ -16,18 +16,21 @@ PhaserNode::PhaserNode() {
 
 void PhaserNode::onPrepare(double sampleRate, int /*maxBlockSize*/) {
     for (int st = 0; st < kNumStages; ++st)
-        for (int ch = 0; ch < 2; ++ch) {
+        for (int ch = 0; ch < 2; ++ch)
             m_apState[st][ch] = 0.0f;
-            m_xPrev[st][ch]   = 0.0f;
-        }
     m_feedbackState[0] = m_feedbackState[1] = 0.0f;
-    m_lfoPhase     = 0.0f;
-    m_lfoIncrement = getParam("rate") / static_cast<float>(sampleRate);
+    m_lfo.prepare(sampleRate);
+    m_lfo.setRate(getParam("rate"));
+    m_lfo.reset();
+    m_gain = 0.0f;  // G at fc = 0; the first control point ramps from here
 }
 
 void PhaserNode::onParamChanged(const std::string& /*name*/, float /*value*/) {
-    double sr      = m_sampleRate > 0 ? m_sampleRate : 48000.0;
-    m_lfoIncrement = getParam("rate") / static_cast<float>(sr);
+    m_lfo.setRate(getParam("rate"));
+}
+
+void PhaserNode::setControlInterval(int samples) {
+    m_interval = std::max(1, samples);
 }
 
 void PhaserNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
@@ -41,33 +44,41 @@ void PhaserNode::process(AudioBufferView input, AudioBufferView output, int numS
     float dryGain = 1.0f - mix;
     float wetGain = mix;
 
-    for (int s = 0; s < numSamples; ++s) {
-        float lfo = 0.5f * (1.0f + std::sin(kTwoPi * m_lfoPhase));  // [0, 1]
+    const int interval = m_interval;
+
+    for (int start = 0; start < numSamples; start += interval) {
+        const int run = std::min(interval, numSamples - start);
+
+        float lfo = 0.5f * (1.0f + m_lfo.tick(run));  // [0, 1]
         float fc  = freqMin + (freqMax - freqMin) * lfo * depth;
-        // First-order all-pass coefficient: k = (tan(π*fc/sr) - 1) / (tan(π*fc/sr) + 1)
-        float tanFc = std::tan(kPi * fc / static_cast<float>(sr));
-        float k     = (tanFc - 1.0f) / (tanFc + 1.0f);
-
-        m_lfoPhase += m_lfoIncrement;
-        if (m_lfoPhase >= 1.0f) m_lfoPhase -= 1.0f;
-
-        for (int c = 0; c < output.numChannels; ++c) {
-            int ch = (c < 2) ? c : 1;
-
-            // Input with feedback from last all-pass output
-            float x = input[c][s] + m_feedbackState[ch] * feedback;
-
-            // Chain kNumStages first-order all-pass filters
-            // Direct Form I: y[n] = k*x[n] + x[n-1] - k*y[n-1]
-            for (int st = 0; st < kNumStages; ++st) {
-                float y = k * x + m_xPrev[st][ch] - k * m_apState[st][ch];
-                m_xPrev[st][ch]   = x;
-                m_apState[st][ch] = y;
-                x = y;
-            }
+        float g      = fastmath::tan(kPi * fc / static_cast<float>(sr));
+        float gEnd   = g / (1.0f + g);
+        float gStep  = (gEnd - m_gain) / static_cast<float>(run);
+        float gStart = m_gain;
+        m_gain       = gEnd;
 
-            m_feedbackState[ch] = x;
-            output[c][s] = input[c][s] * dryGain + x * wetGain;
+        for (int i = 0; i < run; ++i) {
+            const int   s = start + i;
+            const float G = gStart + gStep * static_cast<float>(i + 1);
+
+            for (int c = 0; c < output.numChannels; ++c) {
+                int ch = (c < 2) ? c : 1;
+
+                // Input with feedback from last all-pass output
+                float x = input[c][s] + m_feedbackState[ch] * feedback;
+
+                // Chain kNumStages TPT all-passes: lp = s + G*(x - s), y = 2*lp - x
+                for (int st = 0; st < kNumStages; ++st) {
+                    float& z = m_apState[st][ch];
+                    float  v = (x - z) * G;
+                    float  lp = v + z;
+                    z = lp + v;
+                    x = 2.0f * lp - x;
+                }
+
+                m_feedbackState[ch] = x;
+                output[c][s] = input[c][s] * dryGain + x * wetGain;
+            }
         }
     }
 }
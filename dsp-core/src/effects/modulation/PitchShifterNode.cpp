@@ -1,22 +1,49 @@
 #include "effects/modulation/PitchShifterNode.h"
 #include <cmath>
 #include <algorithm>
+#include <cstring>
 
 namespace gearboxfx {
 
-static constexpr float kPi = 3.14159265358979f;
+static constexpr double kPi = 3.14159265358979323846;
 
 PitchShifterNode::PitchShifterNode() {
     registerParam("semitones", {0.0f, -12.0f, 12.0f, "Semitones", "st"});
     registerParam("mix",       {1.0f,  0.0f,  1.0f,  "Mix",       ""});
+    registerParam("mode",      {0.0f,  0.0f,  2.0f,  "Mode",      ""});  // 0=granular, 1=phase vocoder, 2=PSOLA
+    registerParam("fft_size",  {2048.0f, 512.0f, 4096.0f, "FFT Size", ""});
+    registerParam("overlap",   {4.0f,  2.0f,  8.0f,  "Overlap",   ""});
 }
 
-void PitchShifterNode::onPrepare(double /*sampleRate*/, int /*maxBlockSize*/) {
+void PitchShifterNode::onPrepare(double sampleRate, int maxBlockSize) {
     for (int c = 0; c < 2; ++c)
         m_buf[c].assign(kBufSize, 0.0f);
     m_writePos  = 0;
     m_readPos[0] = 0.0f;
     m_readPos[1] = static_cast<float>(kGrainSize) * 0.5f;  // offset by half grain
+
+    for (int i = 0; i <= kGrainSize; ++i)
+        m_window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * kPi * i / kGrainSize));
+
+    m_vocoder.prepare();
+    m_vocoder.configure(static_cast<int>(getParam("fft_size")), static_cast<int>(getParam("overlap")));
+    for (auto& w : m_wet) w.assign(maxBlockSize, 0.0f);
+    m_dualMono = true;
+    m_psola.prepare(sampleRate);
+
+    const int maxDelay = std::max(4096, m_psola.latencySamples());  // vocoder: fft_size <= 4096
+    const int dryLen   = Fft::nextPowerOfTwo(maxDelay + maxBlockSize);
+    for (auto& d : m_dry) d.assign(dryLen, 0.0f);
+    m_dryMask = dryLen - 1;
+    m_dryPos  = 0;
+}
+
+// From the params rather than m_vocoder: a size change is only applied by
+// the next vocoder block.
+int PitchShifterNode::latencySamples() const {
+    if (mode() == 2) return m_psola.latencySamples();
+    if (mode() != 1) return 0;
+    return Fft::nextPowerOfTwo(static_cast<int>(getParam("fft_size")));
 }
 
 float PitchShifterNode::readHermite(const std::vector<float>& buf, float pos) const {
@@ -39,6 +66,15 @@ float PitchShifterNode::readHermite(const std::vector<float>& buf, float pos) co
 }
 
 void PitchShifterNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
+    if (mode() == 1)
+        processVocoder(input, output, numSamples);
+    else if (mode() == 2)
+        processPsola(input, output, numSamples);
+    else
+        processGranular(input, output, numSamples);
+}
+
+void PitchShifterNode::processGranular(AudioBufferView input, AudioBufferView output, int numSamples) {
     float semitones = getParam("semitones");
     float mix       = getParam("mix");
 
@@ -46,10 +82,11 @@ void PitchShifterNode::process(AudioBufferView input, AudioBufferView output, in
     float dryGain = 1.0f - mix;
     float wetGain = mix;
 
-    // Hann window function over [0, kGrainSize)
-    auto hannWin = [](float pos) -> float {
-        float t = pos / static_cast<float>(kGrainSize);
-        return 0.5f * (1.0f - std::cos(2.0f * kPi * t));
+    // Hann window over [0, kGrainSize), from the table
+    auto hannWin = [this](float pos) -> float {
+        int   i  = static_cast<int>(pos);
+        float fr = pos - static_cast<float>(i);
+        return m_window[i] + fr * (m_window[i + 1] - m_window[i]);
     };
 
     for (int s = 0; s < numSamples; ++s) {
@@ -92,4 +129,67 @@ void PitchShifterNode::process(AudioBufferView input, AudioBufferView output, in
     }
 }
 
+void PitchShifterNode::processVocoder(AudioBufferView input, AudioBufferView output, int numSamples) {
+    float semitones = getParam("semitones");
+
+    // Size changes are applied here, on the audio thread, between blocks.
+    int fftSize = static_cast<int>(getParam("fft_size"));
+    int overlap = static_cast<int>(getParam("overlap") + 0.5f);
+    if (Fft::nextPowerOfTwo(fftSize) != m_vocoder.fftSize() ||
+        Fft::nextPowerOfTwo(overlap) != m_vocoder.overlap())
+        m_vocoder.configure(fftSize, overlap);
+    m_vocoder.setPitchRatio(std::pow(2.0f, semitones / 12.0f));
+
+    // The FFTs are the expensive part: run them once when both channels
+    // carry the same signal, as they do for a guitar input.
+    const int numCh = std::min(2, output.numChannels);
+    bool dualMono = numCh == 2 && input.numChannels >= 2 &&
+        std::memcmp(input[0], input[1], numSamples * sizeof(float)) == 0;
+    if (!dualMono && m_dualMono && numCh == 2)
+        m_vocoder.copyChannelState(0, 1);
+    m_dualMono = dualMono;
+
+    const int runCh = dualMono ? 1 : numCh;
+    for (int c = 0; c < runCh; ++c)
+        m_vocoder.process(c, input[std::min(c, input.numChannels - 1)], m_wet[c].data(), numSamples);
+
+    const float* wet[2] = { m_wet[0].data(), m_wet[1].data() };
+    mixDelayedDry(input, output, wet, runCh, numSamples, m_vocoder.latencySamples());
+}
+
+void PitchShifterNode::processPsola(AudioBufferView input, AudioBufferView output, int numSamples) {
+    m_psola.setPitchRatio(std::pow(2.0f, getParam("semitones") / 12.0f));
+
+    const int numCh = std::min(2, output.numChannels);
+    const float* in[2]  = { input[0], input[std::min(1, input.numChannels - 1)] };
+    float*       wet[2] = { m_wet[0].data(), m_wet[1].data() };
+    m_psola.process(in, wet, numCh, numSamples);
+
+    mixDelayedDry(input, output, wet, numCh, numSamples, m_psola.latencySamples());
+}
+
+// output = dry delayed by `delay` samples * (1 - mix) + wet * mix. The dry
+// history is written first, so input and output may alias.
+void PitchShifterNode::mixDelayedDry(AudioBufferView input, AudioBufferView output,
+                                     const float* const* wet, int numWet, int numSamples, int delay) {
+    const float mix     = getParam("mix");
+    const float dryGain = 1.0f - mix;
+    const float wetGain = mix;
+
+    for (int c = 0; c < 2; ++c) {
+        const float* in  = input[std::min(c, input.numChannels - 1)];
+        float*       dry = m_dry[c].data();
+        for (int s = 0; s < numSamples; ++s)
+            dry[(m_dryPos + s) & m_dryMask] = in[s];
+    }
+
+    for (int c = 0; c < output.numChannels; ++c) {
+        const float* dry = m_dry[c < 2 ? c : 1].data();
+        const float* w   = wet[std::min(c, numWet - 1)];
+        for (int s = 0; s < numSamples; ++s)
+            output[c][s] = dry[(m_dryPos - delay + s) & m_dryMask] * dryGain + w[s] * wetGain;
+    }
+    m_dryPos = (m_dryPos + numSamples) & m_dryMask;
+}
+
 } // namespace gearboxfx
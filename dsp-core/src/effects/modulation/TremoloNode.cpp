@@ -4,58 +4,47 @@
 
 namespace gearboxfx {
 
-static constexpr float kTwoPi = 6.28318530717959f;
-
 TremoloNode::TremoloNode() {
     registerParam("rate",     { 5.0f,  0.1f, 20.0f, "Rate",     "Hz"});
     registerParam("depth",    { 0.7f,  0.0f,  1.0f, "Depth",    ""});
-    registerParam("waveform", { 0.0f,  0.0f,  2.0f, "Waveform", ""});  // 0=sine,1=tri,2=square
-}
-
-void TremoloNode::onPrepare(double /*sampleRate*/, int /*maxBlockSize*/) {
-    m_phase = 0.0f;
-    recalcIncrement();
+    registerParam("waveform", { 0.0f,  0.0f,  4.0f, "Waveform", ""});  // 0=sine,1=tri,2=square,3=s&h,4=random
+    registerParam("sync",     { 0.0f,  0.0f,  6.0f, "Sync",     ""});  // 0=free, else note division
 }
 
-void TremoloNode::onParamChanged(const std::string& name, float /*value*/) {
-    if (name == "rate")      recalcIncrement();
-    if (name == "depth")     m_depth    = getParam("depth");
-    if (name == "waveform")  m_waveform = static_cast<int>(getParam("waveform") + 0.5f);
+void TremoloNode::onPrepare(double sampleRate, int maxBlockSize) {
+    m_gainBuf.assign(maxBlockSize, 1.0f);
+    m_lfo.prepare(sampleRate);
+    updateLfo();
+    m_lfo.reset();
 }
 
-void TremoloNode::recalcIncrement() {
-    double sr   = m_sampleRate > 0 ? m_sampleRate : 48000.0;
-    m_rate      = getParam("rate");
-    m_increment = m_rate / static_cast<float>(sr);
+void TremoloNode::onParamChanged(const std::string& /*name*/, float /*value*/) {
+    updateLfo();
 }
 
-float TremoloNode::computeLfo(float phase) const {
-    switch (m_waveform) {
-        default:
-        case 0:  // Sine
-            return std::sin(kTwoPi * phase);
-        case 1:  // Triangle
-            return (phase < 0.5f) ? (4.0f * phase - 1.0f) : (3.0f - 4.0f * phase);
-        case 2:  // Square
-            return (phase < 0.5f) ? 1.0f : -1.0f;
-    }
+void TremoloNode::updateLfo() {
+    m_depth    = getParam("depth");
+    m_division = static_cast<int>(getParam("sync") + 0.5f);
+    m_lfo.setShape(static_cast<LfoShape>(static_cast<int>(getParam("waveform") + 0.5f)));
+    m_lfo.setRate(getParam("rate"));
 }
 
 void TremoloNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
-    m_depth    = getParam("depth");
-    m_waveform = static_cast<int>(getParam("waveform") + 0.5f);
+    if (m_division > 0 && m_clock)
+        m_lfo.syncTo(m_clock->beat.load(std::memory_order_relaxed), TempoClock::divisionBeats(m_division),
+                     m_clock->bpm.load(std::memory_order_relaxed));
 
-    for (int s = 0; s < numSamples; ++s) {
-        float lfo = computeLfo(m_phase);
-        // Map lfo [-1,1] → gain [1-depth, 1]
-        float gain = 1.0f - m_depth * (1.0f - lfo) * 0.5f;
+    float* gain = m_gainBuf.data();
+    m_lfo.process(gain, numSamples);
 
-        for (int c = 0; c < output.numChannels; ++c)
-            output[c][s] = input[c][s] * gain;
+    // Map lfo [-1,1] → gain [1-depth, 1]
+    const float depth = m_depth;
+    for (int s = 0; s < numSamples; ++s)
+        gain[s] = 1.0f - depth * (1.0f - gain[s]) * 0.5f;
 
-        m_phase += m_increment;
-        if (m_phase >= 1.0f) m_phase -= 1.0f;
-    }
+    for (int c = 0; c < output.numChannels; ++c)
+        for (int s = 0; s < numSamples; ++s)
+            output[c][s] = input[c][s] * gain[s];
 }
 
 } // namespace gearboxfx
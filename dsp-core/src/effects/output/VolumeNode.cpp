@@ -7,47 +7,52 @@ namespace gearboxfx {
 VolumeNode::VolumeNode() {
     registerParam("volume_db",           {0.0f, -60.0f, 12.0f, "Volume",    "dB"});
     registerParam("limiter_threshold_db", {0.0f, -18.0f,  0.0f, "Limiter",  "dB"});
+    registerParam("lookahead_ms",         {1.5f,   0.5f,  5.0f, "Lookahead", "ms"});
+}
+
+void VolumeNode::onPrepare(double sampleRate, int /*maxBlockSize*/) {
+    m_limiter.prepare(sampleRate, static_cast<int>(std::ceil(kMaxLookaheadMs * 0.001 * sampleRate)));
+    m_limiter.setReleaseMs(kReleaseMs);
+    recalcGains();
+    m_limiter.reset();
 }
 
 void VolumeNode::onParamChanged(const std::string& /*name*/, float /*value*/) {
     recalcGains();
 }
 
+int VolumeNode::lookaheadSamples() const {
+    double sr = m_sampleRate > 0 ? m_sampleRate : 48000.0;
+    return std::max(1, static_cast<int>(std::lround(getParam("lookahead_ms") * 0.001 * sr)));
+}
+
+// Control thread: only atomic stores, the limiter applies a new lookahead
+// itself at the start of its next block.
 void VolumeNode::recalcGains() {
     float volDb   = getParam("volume_db");
     float limDb   = getParam("limiter_threshold_db");
-    m_linearGain  = std::pow(10.0f, volDb  / 20.0f);
-    m_limThresh   = std::pow(10.0f, limDb  / 20.0f);
+    m_linearGain.store(std::pow(10.0f, volDb / 20.0f), std::memory_order_relaxed);
+    m_limiter.setThreshold(std::pow(10.0f, limDb / 20.0f));
+    m_limiter.setLookahead(lookaheadSamples());
 }
 
 void VolumeNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
-    float gain   = m_linearGain;
-    float thresh = m_limThresh;
-
-    // Limiter time constants (~1ms attack, ~100ms release @ 48kHz)
-    double sr        = m_sampleRate > 0 ? m_sampleRate : 48000.0;
-    float  attackC   = std::exp(-1.0 / (0.001 * sr));
-    float  releaseC  = std::exp(-1.0 / (0.100 * sr));
-
-    for (int s = 0; s < numSamples; ++s) {
-        for (int c = 0; c < output.numChannels; ++c) {
-            int ch = (c < 2) ? c : 1;
-            float x = input[c][s] * gain;
-
-            // Peak envelope follower
-            float absX = std::abs(x);
-            float coeff = (absX > m_envState[ch]) ? attackC : releaseC;
-            m_envState[ch] = absX + coeff * (m_envState[ch] - absX);
-
-            // Soft-knee gain reduction above threshold
-            if (m_envState[ch] > thresh && thresh > 0.0f) {
-                float reduction = thresh / m_envState[ch];
-                x *= reduction;
-            }
-
-            output[c][s] = x;
-        }
+    const float gain = m_linearGain.load(std::memory_order_relaxed);
+    for (int c = 0; c < output.numChannels; ++c) {
+        const float* in  = input[std::min(c, input.numChannels - 1)];
+        float*       out = output[c];
+        for (int s = 0; s < numSamples; ++s)
+            out[s] = in[s] * gain;
     }
+
+    // Gain is linked across the first two channels; any extra channels
+    // follow channel 1 like the rest of the stereo nodes.
+    const int numCh = std::min(2, output.numChannels);
+    float* chans[2] = { output[0], output[numCh - 1] };
+    m_limiter.process(chans, numCh, numSamples);
+
+    for (int c = numCh; c < output.numChannels; ++c)
+        std::copy(output[numCh - 1], output[numCh - 1] + numSamples, output[c]);
 }
 
 } // namespace gearboxfx
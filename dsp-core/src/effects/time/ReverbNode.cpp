@@ -9,7 +9,7 @@ float ReverbNode::CombFilter::process(float x) {
     float out  = buf[pos];
     store      = out * (1.0f - damp) + store * damp;  // damping lowpass
     buf[pos]   = x + store * feedback;
-    pos        = (pos + 1) % static_cast<int>(buf.size());
+    if (++pos >= len) pos = 0;  // len may have shrunk below pos
     return out;
 }
 
@@ -18,7 +18,7 @@ float ReverbNode::AllpassFilter::process(float x) {
     float buffered = buf[pos];
     float out      = buffered - x;
     buf[pos]       = x + buffered * feedback;
-    pos            = (pos + 1) % static_cast<int>(buf.size());
+    if (++pos >= len) pos = 0;
     return out;
 }
 
@@ -35,9 +35,25 @@ void ReverbNode::onPrepare(double sampleRate, int /*maxBlockSize*/) {
     m_preDelayBuf[0].assign(static_cast<int>(sampleRate * 0.2), 0.0f);
     m_preDelayBuf[1].assign(static_cast<int>(sampleRate * 0.2), 0.0f);
     m_preDelayPos = 0;
+
+    constexpr float kMaxSizeScale = 1.5f;  // size = 1
+    for (int ch = 0; ch < 2; ++ch) {
+        for (int i = 0; i < kNumCombs; ++i)
+            m_combs[ch][i].allocate(combLength(i, kMaxSizeScale, sampleRate));
+        for (int i = 0; i < kNumAllpass; ++i)
+            m_allpass[ch][i].allocate(allpassLength(i, kMaxSizeScale, sampleRate));
+    }
     rebuildFilters();
 }
 
+int ReverbNode::combLength(int i, float sizeScale, double sampleRate) {
+    return std::max(64, static_cast<int>(kCombBaseMs[i] * sizeScale * sampleRate / 1000.0));
+}
+
+int ReverbNode::allpassLength(int i, float sizeScale, double sampleRate) {
+    return std::max(8, static_cast<int>(kAllpassBaseMs[i] * sizeScale * sampleRate / 1000.0));
+}
+
 void ReverbNode::onParamChanged(const std::string& /*name*/, float /*value*/) {
     rebuildFilters();
 }
@@ -58,18 +74,15 @@ void ReverbNode::rebuildFilters() {
     float sizeScale = 0.5f + m_size * 1.0f;  // [0.5, 1.5]
     float feedbackBase = 0.6f + m_decay * 0.35f;  // [0.6, 0.95]
 
+    // Buffers are not touched: this also runs on the control thread
     for (int ch = 0; ch < 2; ++ch) {
         for (int i = 0; i < kNumCombs; ++i) {
-            int len = static_cast<int>(kCombBaseMs[i] * sizeScale * sr / 1000.0);
-            len = std::max(len, 64);
-            m_combs[ch][i].resize(len);
+            m_combs[ch][i].setLength(combLength(i, sizeScale, sr));
             m_combs[ch][i].feedback = feedbackBase;
             m_combs[ch][i].damp     = m_damping * 0.5f;
         }
         for (int i = 0; i < kNumAllpass; ++i) {
-            int len = static_cast<int>(kAllpassBaseMs[i] * sizeScale * sr / 1000.0);
-            len = std::max(len, 8);
-            m_allpass[ch][i].resize(len);
+            m_allpass[ch][i].setLength(allpassLength(i, sizeScale, sr));
             m_allpass[ch][i].feedback = 0.5f;
         }
     }
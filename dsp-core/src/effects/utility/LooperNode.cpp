@@ -0,0 +1,424 @@
+#include "effects/utility/LooperNode.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace gearboxfx {
+
+bool parseLooperCommand(const std::string& name, LooperCommand& cmd) {
+    static const std::pair<const char*, LooperCommand> kNames[] = {
+        {"record", LooperCommand::Record}, {"play", LooperCommand::Play},
+        {"overdub", LooperCommand::Overdub}, {"stop", LooperCommand::Stop},
+        {"undo", LooperCommand::Undo}, {"redo", LooperCommand::Redo},
+        {"clear", LooperCommand::Clear},
+    };
+    for (const auto& [n, c] : kNames) {
+        if (name == n) {
+            cmd = c;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* looperStateName(LooperState state) {
+    switch (state) {
+    case LooperState::Empty:       return "Empty";
+    case LooperState::Recording:   return "Recording";
+    case LooperState::Playing:     return "Playing";
+    case LooperState::Overdubbing: return "Overdubbing";
+    case LooperState::Stopped:     return "Stopped";
+    }
+    return "?";
+}
+
+LooperNode::LooperNode() {
+    registerParam("level", {1.0f, 0.0f, 1.0f, "Loop Level", ""});
+}
+
+LooperNode::~LooperNode() {
+    stopWorker();
+}
+
+// Storage is released here and set up again by the next Record command.
+void LooperNode::onPrepare(double sampleRate, int /*maxBlockSize*/) {
+    release();
+    LooperCommand stale;
+    while (m_commands.pop(stale)) {}
+
+    const double sr = sampleRate > 0 ? sampleRate : 48000.0;
+    m_ramChunks  = std::max(1, static_cast<int>(m_memorySeconds * sr / kChunkFrames));
+    m_numTouched = 0;
+    m_pass   = 0;
+    m_undone = false;
+
+    m_numFree = 0;
+    for (int b = 0; b < kStreamBuffers; ++b) releaseBuffer(b);
+    m_readyHead = m_readyCount = m_inFlight = 0;
+    m_recBuffer = m_playBuffer = -1;
+    m_playChunk = -1;
+    m_spilling  = false;
+
+    m_length = m_pos = 0;
+    m_publishedLength.store(0, std::memory_order_release);
+    m_state.store(LooperState::Empty, std::memory_order_release);
+}
+
+bool LooperNode::command(LooperCommand cmd) {
+    if (cmd == LooperCommand::Record && !m_allocated)
+        allocate();
+    return m_commands.push(cmd);
+}
+
+size_t LooperNode::allocatedBytes() const {
+    return sizeof(float) * (m_pool.size() + m_stream.size() + m_scratch.size()) +
+           sizeof(int) * (m_cur.size() + m_alt.size() + m_touched.size()) +
+           sizeof(unsigned) * m_forkPass.size();
+}
+
+// Control thread. The audio thread touches none of this until it pops the
+// Record command pushed after it, so the queue publishes it.
+void LooperNode::allocate() {
+    m_pool.assign(static_cast<size_t>(2) * m_ramChunks * kChunkFloats, 0.0f);
+    m_cur.resize(m_ramChunks);
+    m_alt.resize(m_ramChunks);
+    for (int k = 0; k < m_ramChunks; ++k) {
+        m_cur[k] = 2 * k;
+        m_alt[k] = 2 * k + 1;
+    }
+    m_forkPass.assign(m_ramChunks, 0u);
+    m_touched.assign(m_ramChunks, 0);
+
+    m_stream.assign(static_cast<size_t>(kStreamBuffers) * kChunkFloats, 0.0f);
+    m_scratch.assign(kChunkFloats, 0.0f);
+    m_maxChunks = m_ramChunks;
+
+    if (m_spillEnabled)
+        startWorker();
+    m_allocated = true;
+}
+
+void LooperNode::release() {
+    stopWorker();
+    for (auto* v : {&m_pool, &m_stream, &m_scratch})
+        std::vector<float>().swap(*v);
+    for (auto* v : {&m_cur, &m_alt, &m_touched})
+        std::vector<int>().swap(*v);
+    std::vector<unsigned>().swap(m_forkPass);
+    m_allocated = false;
+}
+
+// ── Disk worker ──────────────────────────────────────────────────────────────
+
+void LooperNode::startWorker() {
+    m_file = m_spillPath.empty() ? std::tmpfile() : std::fopen(m_spillPath.c_str(), "w+b");
+    if (!m_file) return;  // no spill: recording stops at the RAM budget
+
+    m_maxChunks += static_cast<long long>(kMaxSpillSeconds * m_sampleRate / kChunkFrames);
+    m_running.store(true, std::memory_order_release);
+    m_worker = std::thread([this] { workerLoop(); });
+}
+
+void LooperNode::stopWorker() {
+    if (m_worker.joinable()) {
+        m_running.store(false, std::memory_order_release);
+        m_worker.join();
+    }
+    SpillRequest r;
+    while (m_toDisk.pop(r))   {}
+    while (m_fromDisk.pop(r)) {}
+    m_diskPending.store(0, std::memory_order_release);
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+void LooperNode::workerLoop() {
+    const size_t bytes = sizeof(float) * kChunkFloats;
+    while (m_running.load(std::memory_order_acquire)) {
+        SpillRequest r;
+        if (!m_toDisk.pop(r)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        float* data = m_stream.data() + static_cast<size_t>(r.buffer) * kChunkFloats;
+        std::fseek(m_file, static_cast<long>((r.chunk - m_ramChunks) * static_cast<long long>(bytes)), SEEK_SET);
+        if (r.write) {
+            std::fwrite(data, 1, bytes, m_file);
+        } else {
+            size_t got = std::fread(data, 1, bytes, m_file) / sizeof(float);
+            std::fill(data + got, data + kChunkFloats, 0.0f);
+        }
+        m_fromDisk.push(r);  // never full: at most kStreamBuffers requests exist
+        m_diskPending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+// Audio thread: hand a request to the disk thread.
+bool LooperNode::requestDisk(const SpillRequest& r) {
+    m_diskPending.fetch_add(1, std::memory_order_relaxed);
+    if (m_toDisk.push(r)) return true;
+    m_diskPending.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+}
+
+// Audio thread: collect finished requests.
+void LooperNode::drainDisk() {
+    SpillRequest r;
+    while (m_fromDisk.pop(r)) {
+        if (r.write) {
+            releaseBuffer(r.buffer);
+            continue;
+        }
+        --m_inFlight;
+        if (r.gen == m_gen && m_readyCount < kStreamBuffers) {
+            m_ready[(m_readyHead + m_readyCount) % kStreamBuffers] = {r.buffer, r.chunk};
+            ++m_readyCount;
+        } else {
+            releaseBuffer(r.buffer);
+        }
+    }
+}
+
+// Keep the next spilled chunks (in loop order) on their way from disk.
+void LooperNode::readAhead() {
+    if (m_length <= static_cast<long long>(m_ramChunks) * kChunkFrames) return;
+    const long long last = (m_length - 1) / kChunkFrames;
+    while (m_numFree > 0 && m_inFlight + m_readyCount < kStreamBuffers - 1) {
+        int b = m_free[--m_numFree];
+        if (!requestDisk({b, m_fetchChunk, false, m_gen})) {
+            releaseBuffer(b);
+            break;
+        }
+        ++m_inFlight;
+        m_fetchChunk = (m_fetchChunk >= last) ? m_ramChunks : m_fetchChunk + 1;
+    }
+}
+
+void LooperNode::restartReadAhead() {
+    ++m_gen;
+    while (m_readyCount > 0) {
+        releaseBuffer(m_ready[m_readyHead].buffer);
+        m_readyHead = (m_readyHead + 1) % kStreamBuffers;
+        --m_readyCount;
+    }
+    if (m_playBuffer >= 0) releaseBuffer(m_playBuffer);
+    m_playBuffer = -1;
+    m_playChunk  = -1;
+    m_fetchChunk = m_ramChunks;
+}
+
+// ── Chunk access ─────────────────────────────────────────────────────────────
+
+float* LooperNode::recordTarget(long long chunk) {
+    if (chunk < m_ramChunks)
+        return m_pool.data() + static_cast<size_t>(m_cur[chunk]) * kChunkFloats;
+    if (chunk >= m_maxChunks)
+        return nullptr;
+    if (m_recBuffer < 0) {
+        if (m_numFree == 0) {
+            m_underruns.fetch_add(1, std::memory_order_relaxed);
+            return m_scratch.data();  // the disk is behind; this chunk is lost
+        }
+        m_recBuffer = m_free[--m_numFree];
+    }
+    return m_stream.data() + static_cast<size_t>(m_recBuffer) * kChunkFloats;
+}
+
+void LooperNode::flushRecordBuffer(long long chunk) {
+    if (m_recBuffer < 0) return;
+    if (!requestDisk({m_recBuffer, chunk, true, m_gen}))
+        releaseBuffer(m_recBuffer);
+    m_recBuffer = -1;
+}
+
+float* LooperNode::playSource(long long chunk) {
+    if (chunk < m_ramChunks)
+        return m_pool.data() + static_cast<size_t>(m_cur[chunk]) * kChunkFloats;
+    if (chunk != m_playChunk) {
+        if (m_playBuffer >= 0) releaseBuffer(m_playBuffer);
+        m_playBuffer = -1;
+        m_playChunk  = chunk;
+        while (m_readyCount > 0) {
+            Ready r = m_ready[m_readyHead];
+            m_readyHead = (m_readyHead + 1) % kStreamBuffers;
+            --m_readyCount;
+            if (r.chunk == chunk) {
+                m_playBuffer = r.buffer;
+                break;
+            }
+            releaseBuffer(r.buffer);
+        }
+        if (m_playBuffer < 0) m_underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    return m_playBuffer >= 0 ? m_stream.data() + static_cast<size_t>(m_playBuffer) * kChunkFloats
+                             : nullptr;
+}
+
+// Copy-on-write: the first overdub write in a pass moves the chunk to its
+// spare slot, leaving the previous take in place for undo.
+float* LooperNode::fork(long long chunk) {
+    if (m_forkPass[chunk] != m_pass) {
+        float* pool = m_pool.data();
+        std::memcpy(pool + static_cast<size_t>(m_alt[chunk]) * kChunkFloats,
+                    pool + static_cast<size_t>(m_cur[chunk]) * kChunkFloats,
+                    sizeof(float) * kChunkFloats);
+        std::swap(m_cur[chunk], m_alt[chunk]);
+        m_forkPass[chunk] = m_pass;
+        m_touched[m_numTouched++] = static_cast<int>(chunk);
+    }
+    return m_pool.data() + static_cast<size_t>(m_cur[chunk]) * kChunkFloats;
+}
+
+void LooperNode::swapTouched() {
+    for (int i = 0; i < m_numTouched; ++i) {
+        int k = m_touched[i];
+        std::swap(m_cur[k], m_alt[k]);
+    }
+}
+
+// ── Transport ────────────────────────────────────────────────────────────────
+
+void LooperNode::closeLoop() {
+    if (m_pos % kChunkFrames != 0)
+        flushRecordBuffer(m_pos / kChunkFrames);
+    m_length = m_pos;
+    m_pos    = 0;
+    m_publishedLength.store(m_length, std::memory_order_release);
+    restartReadAhead();
+    m_state.store(m_length > 0 ? LooperState::Playing : LooperState::Empty, std::memory_order_release);
+}
+
+void LooperNode::clearLoop() {
+    if (m_recBuffer >= 0) releaseBuffer(m_recBuffer);
+    m_recBuffer = -1;
+    restartReadAhead();
+    m_length = m_pos = 0;
+    m_numTouched = 0;
+    m_undone = false;
+    m_publishedLength.store(0, std::memory_order_release);
+    m_state.store(LooperState::Empty, std::memory_order_release);
+}
+
+void LooperNode::applyCommand(LooperCommand cmd) {
+    LooperState st = m_state.load(std::memory_order_relaxed);
+    if (st == LooperState::Recording && cmd != LooperCommand::Record && cmd != LooperCommand::Clear) {
+        closeLoop();
+        st = m_state.load(std::memory_order_relaxed);
+        if (cmd == LooperCommand::Play) return;
+    }
+
+    switch (cmd) {
+    case LooperCommand::Record:
+        m_spilling = m_file != nullptr;  // set up by command() before the push
+        clearLoop();
+        m_state.store(LooperState::Recording, std::memory_order_release);
+        break;
+    case LooperCommand::Play:
+        if (st == LooperState::Stopped) {
+            m_pos = 0;
+            restartReadAhead();
+        }
+        if (st != LooperState::Empty)
+            m_state.store(LooperState::Playing, std::memory_order_release);
+        break;
+    case LooperCommand::Overdub:
+        if (st == LooperState::Empty || st == LooperState::Overdubbing) break;
+        if (st == LooperState::Stopped) {
+            m_pos = 0;
+            restartReadAhead();
+        }
+        ++m_pass;
+        m_numTouched = 0;
+        m_undone = false;
+        m_state.store(LooperState::Overdubbing, std::memory_order_release);
+        break;
+    case LooperCommand::Stop:
+        if (st != LooperState::Empty)
+            m_state.store(LooperState::Stopped, std::memory_order_release);
+        break;
+    case LooperCommand::Undo:
+    case LooperCommand::Redo:
+        if (st == LooperState::Overdubbing)
+            m_state.store(LooperState::Playing, std::memory_order_release);
+        if (m_undone == (cmd == LooperCommand::Redo)) {
+            swapTouched();
+            m_undone = !m_undone;
+        }
+        break;
+    case LooperCommand::Clear:
+        clearLoop();
+        break;
+    }
+}
+
+// ── Audio ────────────────────────────────────────────────────────────────────
+
+void LooperNode::process(AudioBufferView input, AudioBufferView output, int numSamples) {
+    LooperCommand cmd;
+    while (m_commands.pop(cmd))
+        applyCommand(cmd);
+    if (m_spilling) {
+        drainDisk();
+        readAhead();
+    }
+
+    const float  level = getParam("level");
+    const float* in[2] = { input[0], input[std::min(1, input.numChannels - 1)] };
+    const int    numCh = std::min(2, output.numChannels);
+
+    int s = 0;
+    while (s < numSamples) {
+        const LooperState st = m_state.load(std::memory_order_relaxed);
+        const long long chunk = m_pos / kChunkFrames;
+        const int       off   = static_cast<int>(m_pos % kChunkFrames);
+        int len = std::min(numSamples - s, kChunkFrames - off);
+
+        if (st == LooperState::Recording) {
+            float* dst = recordTarget(chunk);
+            if (!dst) {  // out of memory and disk: the loop closes here
+                closeLoop();
+                continue;
+            }
+            for (int c = 0; c < 2; ++c)
+                std::memcpy(dst + c * kChunkFrames + off, in[c] + s, sizeof(float) * len);
+            for (int c = 0; c < numCh; ++c)
+                if (output[c] != in[c]) std::memcpy(output[c] + s, in[c] + s, sizeof(float) * len);
+            m_pos += len;
+            if (m_pos % kChunkFrames == 0 && chunk >= m_ramChunks)
+                flushRecordBuffer(chunk);
+        } else if (st == LooperState::Playing || st == LooperState::Overdubbing) {
+            len = static_cast<int>(std::min<long long>(len, m_length - m_pos));
+            const bool overdub = st == LooperState::Overdubbing && chunk < m_ramChunks;
+            float* src = overdub ? fork(chunk) : playSource(chunk);
+
+            for (int c = 0; c < numCh; ++c) {
+                float* loop = src ? src + c * kChunkFrames + off : nullptr;
+                for (int i = 0; i < len; ++i) {
+                    const float x = in[c][s + i];
+                    const float y = loop ? loop[i] : 0.0f;
+                    if (overdub) loop[i] = y + x;
+                    output[c][s + i] = x + level * y;
+                }
+            }
+            // Mono output: the right plane still takes the overdub
+            if (overdub && numCh == 1) {
+                float* loop = src + kChunkFrames + off;
+                for (int i = 0; i < len; ++i) loop[i] += in[1][s + i];
+            }
+            m_pos += len;
+            if (m_pos >= m_length) m_pos = 0;
+        } else {
+            for (int c = 0; c < numCh; ++c)
+                if (output[c] != in[c]) std::memcpy(output[c] + s, in[c] + s, sizeof(float) * len);
+        }
+        s += len;
+    }
+
+    for (int c = numCh; c < output.numChannels; ++c)
+        std::memcpy(output[c], output[numCh - 1], sizeof(float) * numSamples);
+}
+
+} // namespace gearboxfx
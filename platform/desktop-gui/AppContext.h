@@ -1,6 +1,7 @@
 #pragma once
 #include "EffectEngine.h"
 #include "GuiAudioIO.h"
+#include "Telemetry.h"
 #include <string>
 
 namespace gearboxfx {
@@ -9,6 +10,7 @@ namespace gearboxfx {
 struct AppContext {
     EffectEngine* engine           = nullptr;
     GuiAudioIO*   audio            = nullptr;
+    Telemetry*    telemetry        = nullptr;
     std::string*  selectedEffectId = nullptr;  // ID of effect selected in ChainPanel
     std::string   presetsDir;
     double        sampleRate = 48000.0;
@@ -46,6 +46,9 @@ bool GearBoxApp::init(int width, int height, const char* title,
     ImGui_ImplGlfw_InitForOpenGL(m_window, true);
     ImGui_ImplOpenGL3_Init("#version 330");
 
+    m_telemetry.start(m_sampleRate);
+    m_engine.chain().profiler().setEnabled(true);  // feeds the DSP load readout
+
     spdlog::info("GearBoxApp: initialized ({}x{}, presets='{}')",
                  width, height, presetsDir);
     return true;
@@ -80,6 +83,7 @@ void GearBoxApp::render() {
     AppContext ctx;
     ctx.engine           = &m_engine;
     ctx.audio            = &m_audio;
+    ctx.telemetry        = &m_telemetry;
     ctx.selectedEffectId = &m_selectedEffectId;
     ctx.presetsDir       = m_presetsDir;
     ctx.sampleRate       = m_sampleRate;
@@ -89,12 +93,34 @@ void GearBoxApp::render() {
     m_presets.render(ctx);
     m_chain.render(ctx);
 
+    // Give new nodes their metering taps (and drop removed ones)
+    m_telemetry.sync(m_engine.chain());
+
     // Sync back mutable fields that panels may have changed
+    if (ctx.sampleRate != m_sampleRate)
+        m_telemetry.start(ctx.sampleRate);
     m_sampleRate = ctx.sampleRate;
+
+    const double now = glfwGetTime();
+    if (now - m_lastStatsDump >= kStatsDumpSeconds) {
+        dumpAudioStats();
+        m_lastStatsDump = now;
+    }
+}
+
+void GearBoxApp::dumpAudioStats() {
+    AudioIOStats::Snapshot snap = m_audio.stats().snapshot();
+    AudioIOStats::Snapshot delta = snap - m_statsAtDump;
+    m_statsAtDump = snap;
+    if (delta.callbacks == 0) return;
+    if (delta.xruns() > 0) spdlog::warn("audio: {}", delta.format());
+    else                   spdlog::info("audio: {}", delta.format());
 }
 
 void GearBoxApp::shutdown() {
     m_audio.stop();
+    dumpAudioStats();
+    m_telemetry.stop();
 
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
@@ -27,16 +27,23 @@ public:
 
 private:
     void render();
+    void dumpAudioStats();  // log the audio health counters since the last dump
+
+    static constexpr double kStatsDumpSeconds = 30.0;
 
     GLFWwindow* m_window = nullptr;
 
     EffectEngine   m_engine;
     GuiAudioIO     m_audio;
+    Telemetry      m_telemetry;
     std::string    m_selectedEffectId;
     std::string    m_presetsDir;
     double         m_sampleRate = 48000.0;
     int            m_blockSize  = 256;
 
+    double                 m_lastStatsDump = 0.0;
+    AudioIOStats::Snapshot m_statsAtDump;
+
     TransportPanel m_transport;
     PresetPanel    m_presets;
     ChainPanel     m_chain;
@@ -15,6 +15,7 @@ extern "C" {
 }
 
 #include "GuiAudioIO.h"
+#include "RtCheck.h"
 #include <portaudio.h>
 #include <spdlog/spdlog.h>
 #include <algorithm>
@@ -172,6 +173,7 @@ void GuiAudioIO::setEngine(EffectEngine* engine, double sampleRate, int blockSiz
         return;
     }
 
+    m_stats.setPeriod(sr, blockSize);
     Pa_StartStream(m_stream);
     spdlog::info("GuiAudioIO: PortAudio stream open at {}Hz, {}ch, block={}",
                  (int)sr, m_numCh.load(), blockSize);
@@ -208,13 +210,24 @@ void GuiAudioIO::closeStream() {
 int GuiAudioIO::paCallback(const void* /*in*/, void* out,
                             unsigned long frames,
                             const PaStreamCallbackTimeInfo* /*ti*/,
-                            PaStreamCallbackFlags /*flags*/,
+                            PaStreamCallbackFlags flags,
                             void* userData)
 {
-    return static_cast<GuiAudioIO*>(userData)->doCallback(out, frames);
+    return static_cast<GuiAudioIO*>(userData)->doCallback(out, frames, flags);
 }
 
-int GuiAudioIO::doCallback(void* outBuf, unsigned long frames) {
+int GuiAudioIO::doCallback(void* outBuf, unsigned long frames, PaStreamCallbackFlags flags) {
+    rtcheck::RealtimeScope realtime;  // the whole callback, not just processBlock
+    const std::int64_t begin = m_stats.callbackBegin();
+    if (flags & (paOutputUnderflow | paInputUnderflow)) m_stats.noteUnderflow();
+    if (flags & (paOutputOverflow  | paInputOverflow))  m_stats.noteOverflow();
+
+    int result = renderBlock(outBuf, frames);
+    m_stats.callbackEnd(begin);
+    return result;
+}
+
+int GuiAudioIO::renderBlock(void* outBuf, unsigned long frames) {
     auto* out   = static_cast<float*>(outBuf);
     int   numCh = m_numCh;
     int   nF    = static_cast<int>(frames);
@@ -227,6 +240,7 @@ int GuiAudioIO::doCallback(void* outBuf, unsigned long frames) {
     // Non-blocking chain lock: skip block (output silence) if GUI is modifying chain
     std::unique_lock<std::mutex> lock(m_chainMutex, std::try_to_lock);
     if (!lock.owns_lock()) {
+        m_stats.noteLockSkip();
         std::memset(out, 0, frames * static_cast<size_t>(numCh) * sizeof(float));
         return paContinue;
     }
@@ -1,6 +1,7 @@
 #pragma once
 #include "EffectEngine.h"
 #include "AudioBuffer.h"
+#include "AudioIOStats.h"
 #include <atomic>
 #include <mutex>
 #include <string>
@@ -42,6 +43,10 @@ public:
     bool     loop()        const { return m_loop.load(); }
     void     setLoop(bool l)    { m_loop.store(l); }
 
+    // Callback timing, xruns and lock skips (lock-free; read from any thread).
+    AudioIOStats&       stats()       { return m_stats; }
+    const AudioIOStats& stats() const { return m_stats; }
+
     // Acquire chain mutex before any structural chain modification (add/remove/move).
     // The returned lock is released automatically on destruction.
     std::unique_lock<std::mutex> lockChain() {
@@ -73,12 +78,15 @@ private:
     // Guards processBlock against concurrent structural chain changes
     std::mutex m_chainMutex;
 
+    AudioIOStats m_stats;
+
     void closeStream();
 
     static int paCallback(const void* in, void* out, unsigned long frames,
                           const PaStreamCallbackTimeInfo* ti,
                           PaStreamCallbackFlags flags, void* userData);
-    int doCallback(void* outBuf, unsigned long frames);
+    int doCallback(void* outBuf, unsigned long frames, PaStreamCallbackFlags flags);
+    int renderBlock(void* outBuf, unsigned long frames);
 };
 
 } // namespace gearboxfx
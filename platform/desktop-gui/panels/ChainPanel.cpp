@@ -2,11 +2,13 @@
 #include "EffectChain.h"
 #include "EffectNode.h"
 #include "effects/EffectNodeRegistry.h"
+#include "effects/utility/LooperNode.h"
 #include <imgui.h>
 #include <imgui-knobs.h>
 #include <algorithm>
 #include <cctype>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace gearboxfx {
@@ -18,6 +20,8 @@ static constexpr float kKnobSize = 48.0f;
 
 ImU32 categoryColor(const std::string& typeId) {
     if (typeId.compare(0, 8,  "dynamics")   == 0) return IM_COL32(50,  100, 200, 255); // blue
+    if (typeId.compare(0, 3,  "amp")        == 0) return IM_COL32(190,  50,  50, 255); // red
+    if (typeId.compare(0, 3,  "cab")        == 0) return IM_COL32(130,  85,  50, 255); // brown
     if (typeId.compare(0, 2,  "eq")         == 0) return IM_COL32(200, 180,  30, 255); // yellow
     if (typeId.compare(0, 4,  "gain")       == 0) return IM_COL32(210, 120,  30, 255); // orange
     if (typeId.compare(0, 10, "modulation") == 0) return IM_COL32(140,  60, 200, 255); // purple
@@ -55,6 +59,11 @@ const char* fmtForUnit(const std::string& unit) {
     return "%.2f";
 }
 
+// RMS dB → bar fill over a 60 dB range
+float meterFill(float db) {
+    return std::min(1.0f, std::max(0.0f, (db + 60.0f) / 60.0f));
+}
+
 } // anonymous namespace
 
 void ChainPanel::render(AppContext& ctx) {
@@ -145,8 +154,46 @@ void ChainPanel::render(AppContext& ctx) {
             ++col;
         }
 
+        // ── Looper transport, 4 buttons per row (commands queue to the node)
+        if (node->typeId() == "utility.looper") {
+            ImGui::Separator();
+            static const std::pair<const char*, LooperCommand> kButtons[] = {
+                {"Rec", LooperCommand::Record}, {"Play", LooperCommand::Play},
+                {"Dub", LooperCommand::Overdub}, {"Stop", LooperCommand::Stop},
+                {"Undo", LooperCommand::Undo},  {"Redo", LooperCommand::Redo},
+                {"Clear", LooperCommand::Clear},
+            };
+            auto looper = std::static_pointer_cast<LooperNode>(node);
+            int b = 0;
+            for (const auto& [label, cmd] : kButtons) {
+                if (b++ % 4 != 0) ImGui::SameLine();
+                if (ImGui::SmallButton(label)) looper->command(cmd);
+            }
+            LooperState st = looper->state();
+            ImVec4 stateCol = (st == LooperState::Recording || st == LooperState::Overdubbing)
+                                  ? ImVec4(0.9f, 0.3f, 0.3f, 1.0f) : ImVec4(0.7f, 0.7f, 0.7f, 1.0f);
+            ImGui::TextColored(stateCol, "%s  %.1f s", looperStateName(st), looper->lengthSeconds());
+            if (looper->spillUnderruns() > 0)
+                ImGui::TextColored(ImVec4(0.9f, 0.8f, 0.2f, 1.0f), "disk underruns %d",
+                                   looper->spillUnderruns());
+        }
+
         ImGui::Separator();
 
+        // ── Meters (computed on the telemetry thread) ────────────────────
+        Telemetry::NodeMeters meters;
+        if (ctx.telemetry && ctx.telemetry->meters(node.get(), meters)) {
+            ImGui::ProgressBar(meterFill(meters.input.rmsDb),  ImVec2(-1.0f, 4.0f), "");
+            ImGui::ProgressBar(meterFill(meters.output.rmsDb), ImVec2(-1.0f, 4.0f), "");
+            if (node->typeId().compare(0, 8, "dynamics") == 0)
+                ImGui::Text("GR %.1f dB", meters.gainReductionDb);
+            ImGui::PlotLines("##spectrum", meters.spectrumDb.data(), Telemetry::kBands,
+                             0, nullptr, -90.0f, 0.0f, ImVec2(-1.0f, 36.0f));
+            ImGui::PlotLines("##scope", meters.scope.data(), Telemetry::kScopeSize,
+                             0, nullptr, -1.0f, 1.0f, ImVec2(-1.0f, 36.0f));
+            ImGui::Separator();
+        }
+
         // ── Reorder + delete buttons ─────────────────────────────────────
         ImGui::BeginDisabled(i == 0);
         bool ml = ImGui::SmallButton(" < ");
@@ -5,7 +5,9 @@
 #include "TransportPanel.h"
 #include <imgui.h>
 #include <algorithm>
+#include <cfloat>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 
 namespace gearboxfx {
@@ -67,18 +69,93 @@ void TransportPanel::render(AppContext& ctx) {
     if (ImGui::Checkbox("Loop", &looping))
         ctx.audio->setLoop(looping);
 
+    // Tuner readout (note and cents off, green when within 5 cents)
+    ImGui::SameLine();
+    const Tuner& tuner = ctx.engine->tuner();
+    int note = tuner.note();
+    if (note < 0) {
+        ImGui::TextDisabled("Tuner: --");
+    } else {
+        float cents = tuner.cents();
+        ImVec4 col = (std::abs(cents) <= 5.0f) ? ImVec4(0.3f, 0.9f, 0.3f, 1.0f)
+                                                : ImVec4(0.9f, 0.8f, 0.2f, 1.0f);
+        ImGui::TextColored(col, "Tuner: %s%d %+.0f c", Tuner::noteName(note), note / 12 - 1, cents);
+    }
+
     // Progress bar
     float prog = ctx.audio->progress();
     ImGui::ProgressBar(prog, ImVec2(-1.0f, 0.0f));
 
     ImGui::Separator();
 
-    // ── Output volume ────────────────────────────────────────────────────────
+    // ── Output volume and tempo ──────────────────────────────────────────────
     float vol = ctx.engine->outputVolume();
-    ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
+    ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - 260.0f);
     if (ImGui::SliderFloat("##vol", &vol, 0.0f, 1.5f, "Vol: %.2f"))
         ctx.engine->setOutputVolume(vol);
 
+    // Synced modulation follows this; saved with the preset
+    ImGui::SameLine();
+    float bpm = static_cast<float>(ctx.engine->tempo());
+    ImGui::SetNextItemWidth(100.0f);
+    if (ImGui::DragFloat("##bpm", &bpm, 0.5f, static_cast<float>(TempoClock::kMinBpm),
+                         static_cast<float>(TempoClock::kMaxBpm), "%.1f BPM",
+                         ImGuiSliderFlags_AlwaysClamp))
+        ctx.engine->setTempo(bpm);
+
+    // DSP load: chain time over the block deadline, peak held with a slow fall
+    ImGui::SameLine();
+    ChainProfiler& prof = ctx.engine->chain().profiler();
+    prof.collect();
+    float load = static_cast<float>(prof.lastLoadPercent());
+    m_loadPeak = std::max(load, m_loadPeak * 0.97f);
+    ImVec4 loadCol = (m_loadPeak < 50.0f) ? ImVec4(0.7f, 0.7f, 0.7f, 1.0f)
+                   : (m_loadPeak < 80.0f) ? ImVec4(0.9f, 0.8f, 0.2f, 1.0f)
+                                          : ImVec4(0.9f, 0.3f, 0.3f, 1.0f);
+    ImGui::TextColored(loadCol, "DSP %3.0f%%", m_loadPeak);
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Effect chain time as a share of the audio block deadline");
+
+    // Xruns: DSP overruns, lock skips and driver under/overflows since launch
+    ImGui::SameLine();
+    AudioIOStats::Snapshot st = ctx.audio->stats().snapshot();
+    if (st.xruns() == 0) ImGui::TextDisabled("Xrun 0");
+    else                 ImGui::TextColored(ImVec4(0.9f, 0.3f, 0.3f, 1.0f), "Xrun %llu",
+                                            static_cast<unsigned long long>(st.xruns()));
+    if (ImGui::IsItemHovered()) {
+        ImGui::BeginTooltip();
+        ImGui::Text("DSP overruns  %llu   (callback longer than %.0f us)",
+                    static_cast<unsigned long long>(st.overruns), st.periodUs);
+        ImGui::Text("Lock skips    %llu   (chain busy, block silenced)",
+                    static_cast<unsigned long long>(st.lockSkips));
+        ImGui::Text("Underflows    %llu   Overflows %llu   (driver)",
+                    static_cast<unsigned long long>(st.underflows),
+                    static_cast<unsigned long long>(st.overflows));
+        ImGui::Text("Late callbacks %llu  (interval over %.1fx period)",
+                    static_cast<unsigned long long>(st.late), AudioIOStats::kLateFactor);
+        ImGui::Separator();
+
+        // Log-linear histograms, quarter-octave buckets from 1 us
+        auto plot = [](const char* label, const AudioIOStats::Histogram& h, double maxUs) {
+            float counts[AudioIOStats::kBuckets];
+            for (int b = 0; b < AudioIOStats::kBuckets; ++b)
+                counts[b] = static_cast<float>(h.count[b]);
+            char overlay[96];
+            std::snprintf(overlay, sizeof(overlay), "p50 %.0f  p99 %.0f  max %.0f us",
+                          h.percentileUs(50), h.percentileUs(99), maxUs);
+            ImGui::TextUnformatted(label);
+            ImGui::PlotHistogram("##h", counts, AudioIOStats::kBuckets, 0, overlay,
+                                 0.0f, FLT_MAX, ImVec2(320.0f, 50.0f));
+        };
+        ImGui::PushID("dur");
+        plot("Callback duration", st.duration, st.maxDurationUs);
+        ImGui::PopID();
+        ImGui::PushID("int");
+        plot("Callback interval", st.interval, st.maxIntervalUs);
+        ImGui::PopID();
+        ImGui::EndTooltip();
+    }
+
     // ── VU meter ─────────────────────────────────────────────────────────────
     float level = ctx.audio->outputLevel();
     ImVec2 vuPos = ImGui::GetCursorScreenPos();
@@ -8,7 +8,8 @@ public:
     void render(AppContext& ctx);
 
 private:
-    char m_loadedFile[512] = "";
+    char  m_loadedFile[512] = "";
+    float m_loadPeak = 0.0f;  // DSP load readout, %
 };
 
 } // namespace gearboxfx
@@ -15,6 +15,7 @@ extern "C" {
 
 #include "FileAudioIO.h"
 #include "AudioBuffer.h"
+#include "RtCheck.h"
 #include <portaudio.h>
 #include <spdlog/spdlog.h>
 #include <vector>
@@ -94,6 +95,7 @@ struct PaStreamData {
     int                      numChannels = 2;
     int                      bufferSize  = 256;
     bool                     done        = false;
+    AudioBuffer              inBuf, outBuf;  // planar scratch, bufferSize frames
 };
 
 static int paCallback(const void* inputBuffer, void* outputBuffer,
@@ -102,6 +104,7 @@ static int paCallback(const void* inputBuffer, void* outputBuffer,
                       PaStreamCallbackFlags /*statusFlags*/,
                       void* userData)
 {
+    rtcheck::RealtimeScope realtime;
     auto* data = static_cast<PaStreamData*>(userData);
     auto* out  = static_cast<float*>(outputBuffer);
     (void)inputBuffer;
@@ -116,31 +119,32 @@ static int paCallback(const void* inputBuffer, void* outputBuffer,
     int numCh    = data->numChannels;
     size_t frames = std::min(static_cast<size_t>(framesPerBuffer), framesLeft);
 
-    // De-interleave into planar buffers
-    AudioBuffer inBuf (numCh, static_cast<int>(framesPerBuffer));
-    AudioBuffer outBuf(numCh, static_cast<int>(framesPerBuffer));
-
+    // PortAudio delivers bufferSize frames as requested; split anything
+    // longer so the preallocated scratch buffers always fit.
     const float* src = data->samples + data->readPos * numCh;
-    for (size_t f = 0; f < frames; ++f)
-        for (int c = 0; c < numCh; ++c)
-            inBuf.getWritePointer(c)[f] = src[f * numCh + c];
+    for (unsigned long offset = 0; offset < framesPerBuffer; ) {
+        const int block = static_cast<int>(std::min<unsigned long>(framesPerBuffer - offset, data->bufferSize));
 
-    // Zero-pad the tail
-    for (size_t f = frames; f < framesPerBuffer; ++f)
-        for (int c = 0; c < numCh; ++c)
-            inBuf.getWritePointer(c)[f] = 0.0f;
+        // De-interleave into planar buffers, zero-padding past the end
+        for (int f = 0; f < block; ++f) {
+            const size_t frame = offset + f;
+            for (int c = 0; c < numCh; ++c)
+                data->inBuf.getWritePointer(c)[f] = (frame < frames) ? src[frame * numCh + c] : 0.0f;
+        }
 
-    auto inView  = inBuf.view();
-    auto outView = outBuf.view();
-    inView.numChannels  = outView.numChannels  = numCh;
-    inView.numSamples   = outView.numSamples   = static_cast<int>(framesPerBuffer);
+        auto inView  = data->inBuf.view();
+        auto outView = data->outBuf.view();
+        inView.numChannels  = outView.numChannels  = numCh;
+        inView.numSamples   = outView.numSamples   = block;
 
-    data->engine->processBlock(inView, outView, static_cast<int>(framesPerBuffer));
+        data->engine->processBlock(inView, outView, block);
 
-    // Re-interleave output
-    for (size_t f = 0; f < framesPerBuffer; ++f)
-        for (int c = 0; c < numCh; ++c)
-            out[f * numCh + c] = outBuf.getReadPointer(c)[f];
+        // Re-interleave output
+        for (int f = 0; f < block; ++f)
+            for (int c = 0; c < numCh; ++c)
+                out[(offset + f) * numCh + c] = data->outBuf.getReadPointer(c)[f];
+        offset += block;
+    }
 
     data->readPos += frames;
     if (data->readPos >= data->totalFrames) {
@@ -196,6 +200,7 @@ bool FileAudioIO::runFileToFile() {
     m_fmt.sampleRate  = sr;
     m_fmt.numChannels = static_cast<uint32_t>(numCh);
     m_fmt.bufferSize  = m_cfg.bufferSize;
+    m_positionSeconds = 0.0;
 
     m_engine.prepare(static_cast<double>(sr), static_cast<int>(m_cfg.bufferSize));
 
@@ -235,6 +240,7 @@ bool FileAudioIO::runFileToFile() {
                 dst[f * numCh + c] = outBuf.getReadPointer(c)[f];
 
         offset += block;
+        m_positionSeconds = static_cast<double>(offset) / sr;
 
         if (m_progressCb)
             m_progressCb(static_cast<float>(offset) / static_cast<float>(totalFrames));
@@ -291,6 +297,8 @@ bool FileAudioIO::runFileToSpeaker() {
     streamData.readPos     = 0;
     streamData.numChannels = numCh;
     streamData.bufferSize  = static_cast<int>(m_cfg.bufferSize);
+    streamData.inBuf.resize(numCh, streamData.bufferSize);
+    streamData.outBuf.resize(numCh, streamData.bufferSize);
 
     PaStream* stream = nullptr;
     PaStreamParameters outParams{};
@@ -37,6 +37,9 @@ public:
     // Callback for progress reporting: receives [0.0, 1.0]
     void setProgressCallback(std::function<void(float)> cb) { m_progressCb = cb; }
 
+    // Input time processed so far (FileToFile; valid inside the progress callback).
+    double positionSeconds() const { return m_positionSeconds; }
+
 private:
     bool runFileToFile();
     bool runFileToSpeaker();
@@ -45,6 +48,7 @@ private:
     FileSimConfig  m_cfg;
     AudioFormat    m_fmt;
     bool           m_running = false;
+    double         m_positionSeconds = 0.0;
 
     std::function<void(float)> m_progressCb;
 };
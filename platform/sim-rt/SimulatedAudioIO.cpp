@@ -0,0 +1,223 @@
+#include "SimulatedAudioIO.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+namespace gearboxfx {
+
+namespace {
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Absolute-deadline sleep on the steady clock's timeline.
+void sleepUntilNs(std::int64_t t) {
+#if defined(__linux__)
+    // steady_clock is CLOCK_MONOTONIC on Linux (libstdc++ and libc++).
+    timespec ts;
+    ts.tv_sec  = static_cast<time_t>(t / 1000000000);
+    ts.tv_nsec = static_cast<long>(t % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+#else
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(t)));
+#endif
+}
+
+void trySetRealtimePriority() {
+#if defined(__linux__)
+    sched_param sp{};
+    sp.sched_priority = sched_get_priority_max(SCHED_FIFO) - 10;
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+    if (err != 0)
+        spdlog::warn("SimulatedAudioIO: SCHED_FIFO refused ({}), running at normal priority", err);
+#else
+    spdlog::warn("SimulatedAudioIO: real-time priority is only supported on Linux");
+#endif
+}
+
+} // anonymous namespace
+
+SimulatedAudioIO::SimulatedAudioIO(EffectEngine& engine, SimRtConfig cfg)
+    : m_engine(engine), m_cfg(std::move(cfg))
+{
+    m_input = [this](AudioBufferView in, std::uint64_t frame) {
+        const double sr = static_cast<double>(m_fmt.sampleRate);
+        for (int s = 0; s < in.numSamples; ++s) {
+            const double ph = std::fmod(220.0 * static_cast<double>(frame + s) / sr, 1.0);
+            const float  x  = 0.25f * static_cast<float>(std::sin(2.0 * 3.141592653589793 * ph));
+            for (int c = 0; c < in.numChannels; ++c) in[c][s] = x;
+        }
+    };
+}
+
+SimulatedAudioIO::~SimulatedAudioIO() {
+    close();
+}
+
+bool SimulatedAudioIO::open(const AudioFormat& fmt) {
+    if (fmt.sampleRate == 0 || fmt.bufferSize == 0 || fmt.numChannels == 0) {
+        spdlog::error("SimulatedAudioIO: invalid format");
+        return false;
+    }
+    m_fmt = fmt;
+    m_in.resize(static_cast<int>(fmt.numChannels), static_cast<int>(fmt.bufferSize));
+    m_out.resize(static_cast<int>(fmt.numChannels), static_cast<int>(fmt.bufferSize));
+    m_engine.prepare(static_cast<double>(fmt.sampleRate), static_cast<int>(fmt.bufferSize));
+    m_stats.setPeriod(static_cast<double>(fmt.sampleRate), static_cast<int>(fmt.bufferSize));
+    return true;
+}
+
+void SimulatedAudioIO::start() {
+    if (m_in.numChannels() == 0) {
+        spdlog::error("SimulatedAudioIO: start() before open()");
+        return;
+    }
+    m_running.store(true);
+    m_report = Report{};
+
+    std::vector<std::thread> load;
+    for (int i = 0; i < m_cfg.contentionThreads; ++i)
+        load.emplace_back(&SimulatedAudioIO::contentionThread, this, i);
+
+    std::thread audio(&SimulatedAudioIO::audioThread, this);
+    audio.join();
+
+    m_running.store(false);
+    for (auto& t : load) t.join();
+}
+
+void SimulatedAudioIO::stop() {
+    m_running.store(false);
+}
+
+void SimulatedAudioIO::close() {
+    m_running.store(false);
+}
+
+// Spins for contentionDuty of every millisecond, sleeps the rest.
+void SimulatedAudioIO::contentionThread(int index) {
+    const std::int64_t slice = 1000000;
+    const auto busy = static_cast<std::int64_t>(slice * std::clamp(m_cfg.contentionDuty, 0.0, 1.0));
+    volatile std::uint64_t sink = static_cast<std::uint64_t>(index);
+    std::int64_t next = nowNs();
+    while (m_running.load(std::memory_order_relaxed)) {
+        while (nowNs() - next < busy) sink = sink * 6364136223846793005ull + 1;
+        next += slice;
+        if (busy < slice) sleepUntilNs(next);
+        else              next = nowNs();
+    }
+}
+
+void SimulatedAudioIO::audioThread() {
+    if (m_cfg.realtimePriority) trySetRealtimePriority();
+
+    const double        sr       = static_cast<double>(m_fmt.sampleRate);
+    const int           n        = static_cast<int>(m_fmt.bufferSize);
+    const std::int64_t  period   = static_cast<std::int64_t>(std::llround(n * 1e9 / sr));
+    const int           periods  = std::max(2, m_cfg.periods);
+    const std::uint64_t maxBlocks = (m_cfg.durationSeconds > 0.0)
+        ? static_cast<std::uint64_t>(std::ceil(m_cfg.durationSeconds * sr / n)) : UINT64_MAX;
+
+    std::mt19937 rng(m_cfg.seed);
+    std::uniform_real_distribution<double> jitter(0.0, std::max(0.0, m_cfg.jitterUs) * 1e3);
+
+    Report& r = m_report;
+    r.periodUs = period * 1e-3;
+    double latencySumMs = 0.0;
+    std::int64_t maxWake = 0;
+
+    // Tick k at t0 + k*period: block k (captured over the period before it)
+    // is ready. The device wants it at `slot`, which starts (periods - 1)
+    // periods later and slides back whenever a block misses it.
+    const std::int64_t t0 = nowNs() + period;
+    std::int64_t slot = t0 + (periods - 1) * period;
+
+    for (std::uint64_t k = 0; k < maxBlocks && m_running.load(std::memory_order_relaxed); ++k) {
+        const std::int64_t tick = t0 + static_cast<std::int64_t>(k) * period;
+        const std::int64_t wakeAt = tick + (m_cfg.jitterUs > 0.0 ? static_cast<std::int64_t>(jitter(rng)) : 0);
+        sleepUntilNs(wakeAt);
+
+        const std::int64_t woke = nowNs();
+        const std::int64_t wakeLatency = std::max<std::int64_t>(0, woke - tick);
+        ++r.wakeLatency.count[AudioIOStats::bucketFor(wakeLatency)];
+        maxWake = std::max(maxWake, wakeLatency);
+
+        const std::int64_t begin = m_stats.callbackBegin();
+        processOne(k);
+        m_stats.callbackEnd(begin);
+        const std::int64_t done = nowNs();
+
+        // Device side: wait whole periods for a late block, playing silence.
+        if (done > slot) {
+            const std::int64_t waited = (done - slot + period - 1) / period;
+            ++r.deadlineMisses;
+            r.underruns += static_cast<std::uint64_t>(waited);
+            slot += waited * period;
+        }
+        const double latencyMs = (slot - (tick - period)) * 1e-6
+                               + m_engine.latencySamples() * 1e3 / sr;
+        latencySumMs += latencyMs;
+        r.minLatencyMs = (r.blocks == 0) ? latencyMs : std::min(r.minLatencyMs, latencyMs);
+        r.maxLatencyMs = std::max(r.maxLatencyMs, latencyMs);
+        ++r.blocks;
+        slot += period;
+    }
+
+    r.maxWakeLatencyUs = maxWake * 1e-3;
+    r.meanLatencyMs    = r.blocks ? latencySumMs / static_cast<double>(r.blocks) : 0.0;
+    r.lockSkips        = m_stats.snapshot().lockSkips;
+}
+
+void SimulatedAudioIO::processOne(std::uint64_t block) {
+    const int n = static_cast<int>(m_fmt.bufferSize);
+    AudioBufferView in  = m_in.view();
+    AudioBufferView out = m_out.view();
+    m_input(in, block * static_cast<std::uint64_t>(n));
+
+    std::unique_lock<std::mutex> lock(m_chainMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        m_stats.noteLockSkip();
+        m_out.clear();
+        m_outputLevel.store(0.0f, std::memory_order_relaxed);
+        return;
+    }
+    m_engine.processBlock(in, out, n);
+
+    float peak = 0.0f;
+    for (int c = 0; c < out.numChannels; ++c)
+        for (int s = 0; s < n; ++s)
+            peak = std::max(peak, std::abs(out[c][s]));
+    m_outputLevel.store(peak, std::memory_order_relaxed);
+}
+
+std::string SimulatedAudioIO::Report::format() const {
+    char line[512];
+    std::snprintf(line, sizeof(line),
+                  "%llu blocks (period %.0f us) | deadline misses %llu, underrun periods %llu, "
+                  "lock skips %llu | wake-up jitter p50 %.0f p99 %.0f max %.0f us | "
+                  "round-trip latency min %.2f mean %.2f max %.2f ms",
+                  static_cast<unsigned long long>(blocks), periodUs,
+                  static_cast<unsigned long long>(deadlineMisses),
+                  static_cast<unsigned long long>(underruns),
+                  static_cast<unsigned long long>(lockSkips),
+                  std::min(wakeLatency.percentileUs(50), maxWakeLatencyUs),
+                  std::min(wakeLatency.percentileUs(99), maxWakeLatencyUs), maxWakeLatencyUs,
+                  minLatencyMs, meanLatencyMs, maxLatencyMs);
+    return line;
+}
+
+} // namespace gearboxfx
@@ -0,0 +1,101 @@
+#pragma once
+#include "IAudioIO.h"
+#include "EffectEngine.h"
+#include "AudioBuffer.h"
+#include "AudioIOStats.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace gearboxfx {
+
+struct SimRtConfig {
+    double   durationSeconds   = 0.0;    // 0 = run until stop()
+    int      periods           = 2;      // device buffer depth: a block is due (periods - 1) periods after its tick
+    double   jitterUs          = 0.0;    // each wake-up is delayed by a uniform [0, jitterUs]
+    int      contentionThreads = 0;      // background threads competing for the CPU
+    double   contentionDuty    = 1.0;    // share of each millisecond they spin, 0..1
+    bool     realtimePriority  = false;  // SCHED_FIFO for the audio thread (Linux, needs rights)
+    uint32_t seed              = 1;      // jitter sequence
+};
+
+// Headless IAudioIO for CI and build machines without a sound card.
+// A dedicated thread calls EffectEngine::processBlock once per block
+// period, woken by an absolute high-resolution timer (clock_nanosleep on
+// Linux) so the schedule does not drift. Optional jitter delays each
+// wake-up; contention threads load the CPU alongside it.
+//
+// A simulated playback device with `periods` buffers consumes one block per
+// period: block k, captured during the period before tick k, must be done
+// by tick k + (periods - 1). A late block is a deadline miss; the device
+// plays silence (an underrun) for each period it waited, and everything
+// after it plays that much later, as with a driver that does not drop
+// audio. Round-trip latency per block = play start - capture start, plus
+// the chain's own latency; nominally periods x the block period.
+//
+// Callback timing, deadline overruns and lock skips are also counted in an
+// AudioIOStats (readable live). report() is valid once start() returns.
+class SimulatedAudioIO : public IAudioIO {
+public:
+    struct Report {
+        std::uint64_t blocks         = 0;
+        std::uint64_t deadlineMisses = 0;
+        std::uint64_t underruns      = 0;  // device periods played as silence
+        std::uint64_t lockSkips      = 0;  // blocks silenced because the chain was locked
+        double        periodUs       = 0.0;
+        AudioIOStats::Histogram wakeLatency;  // wake-up time after the tick (jitter)
+        double        maxWakeLatencyUs = 0.0;
+        double        minLatencyMs = 0.0, meanLatencyMs = 0.0, maxLatencyMs = 0.0;  // round trip
+        std::string format() const;
+    };
+
+    // Fills one input block (audio thread; must not allocate or block).
+    // `frame` counts samples since start().
+    using InputGenerator = std::function<void(AudioBufferView, std::uint64_t frame)>;
+
+    explicit SimulatedAudioIO(EffectEngine& engine, SimRtConfig cfg = {});
+    ~SimulatedAudioIO() override;
+
+    // Prepares the engine for fmt.sampleRate / fmt.bufferSize.
+    bool open(const AudioFormat& fmt) override;
+    // Runs the audio thread; returns after durationSeconds or stop().
+    void start() override;
+    void stop() override;
+    void close() override;
+
+    const AudioFormat& format() const override { return m_fmt; }
+
+    // Default: a 220 Hz sine at -12 dBFS on every channel.
+    void setInputGenerator(InputGenerator gen) { m_input = std::move(gen); }
+
+    // Hold while changing the chain structure or loading a preset; the audio
+    // thread skips (silences) blocks rather than wait, like GuiAudioIO.
+    std::unique_lock<std::mutex> lockChain() { return std::unique_lock<std::mutex>(m_chainMutex); }
+
+    bool                isRunning() const { return m_running.load(); }
+    float               outputLevel() const { return m_outputLevel.load(std::memory_order_relaxed); }
+    const AudioIOStats& stats()     const { return m_stats; }
+    Report              report()    const { return m_report; }
+
+private:
+    void audioThread();
+    void contentionThread(int index);
+    void processOne(std::uint64_t block);
+
+    EffectEngine&  m_engine;
+    SimRtConfig    m_cfg;
+    AudioFormat    m_fmt;
+    InputGenerator m_input;
+
+    std::atomic<bool>  m_running{false};
+    std::atomic<float> m_outputLevel{0.0f};
+    std::mutex         m_chainMutex;
+    AudioIOStats       m_stats;
+    Report             m_report;
+
+    AudioBuffer m_in, m_out;  // audio thread only
+};
+
+} // namespace gearboxfx
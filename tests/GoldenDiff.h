@@ -0,0 +1,109 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+// Sample-by-sample comparison of a render against its reference.
+//
+// The inner loops run over kLanes independent accumulators with selects
+// only, so they vectorize without -ffast-math (a single running sum or max
+// would be a serial reduction). Bit-exactness is checked per chunk with
+// memcmp, which also tells -0 from +0 and one NaN payload from another.
+
+namespace golden {
+
+struct DiffStats {
+    double      refEnergy        = 0.0;  // sum of ref^2
+    double      errEnergy        = 0.0;  // sum of (test - ref)^2
+    double      maxAbsError      = 0.0;  // +inf where either side is NaN
+    std::size_t maxAbsIndex      = 0;
+    long long   firstDiff        = -1;   // first sample whose bits differ, -1 if none
+    int         maxAbsChannel    = 0;    // both set by merge()
+    int         firstDiffChannel = 0;
+
+    bool   exact() const { return firstDiff < 0; }
+
+    // +inf when identical, -inf for any error against silence
+    double snrDb() const {
+        if (errEnergy == 0.0) return std::numeric_limits<double>::infinity();
+        if (refEnergy == 0.0) return -std::numeric_limits<double>::infinity();
+        return 10.0 * std::log10(refEnergy / errEnergy);
+    }
+};
+
+inline DiffStats diff(const float* ref, const float* test, std::size_t n) {
+    constexpr std::size_t kLanes = 8;
+    constexpr std::size_t kChunk = 256;  // multiple of kLanes
+
+    DiffStats st;
+    float best = -1.0f;
+    for (std::size_t base = 0; base < n; base += kChunk) {
+        const std::size_t len = std::min(kChunk, n - base);
+        const float* r = ref  + base;
+        const float* t = test + base;
+
+        if (st.firstDiff < 0 && std::memcmp(r, t, len * sizeof(float)) != 0) {
+            std::size_t i = 0;
+            while (std::memcmp(r + i, t + i, sizeof(float)) == 0) ++i;
+            st.firstDiff = static_cast<long long>(base + i);
+        }
+
+        float sumR[kLanes] = {}, sumE[kLanes] = {}, peak[kLanes] = {};
+        const std::size_t body = len - len % kLanes;
+        for (std::size_t i = 0; i < body; i += kLanes) {
+            for (std::size_t l = 0; l < kLanes; ++l) {
+                const float d = t[i + l] - r[i + l];
+                float a = std::fabs(d);
+                a = (a == a) ? a : std::numeric_limits<float>::infinity();
+                sumR[l] += r[i + l] * r[i + l];
+                sumE[l] += d * d;
+                peak[l]  = (a > peak[l]) ? a : peak[l];
+            }
+        }
+        for (std::size_t i = body; i < len; ++i) {
+            const float d = t[i] - r[i];
+            float a = std::fabs(d);
+            a = (a == a) ? a : std::numeric_limits<float>::infinity();
+            sumR[0] += r[i] * r[i];
+            sumE[0] += d * d;
+            peak[0]  = (a > peak[0]) ? a : peak[0];
+        }
+
+        float chunkPeak = 0.0f;
+        for (std::size_t l = 0; l < kLanes; ++l) {
+            st.refEnergy += sumR[l];
+            st.errEnergy += sumE[l];
+            chunkPeak = std::max(chunkPeak, peak[l]);
+        }
+        if (chunkPeak > best) {
+            // Rare: only when the chunk raises the maximum, find where.
+            for (std::size_t i = 0; i < len; ++i) {
+                float a = std::fabs(t[i] - r[i]);
+                a = (a == a) ? a : std::numeric_limits<float>::infinity();
+                if (a == chunkPeak) { st.maxAbsIndex = base + i; break; }
+            }
+            best = chunkPeak;
+        }
+    }
+    st.maxAbsError = std::max(0.0f, best);
+    return st;
+}
+
+// Adds one channel's result (indices are per channel).
+inline void merge(DiffStats& into, const DiffStats& ch, int channel) {
+    into.refEnergy += ch.refEnergy;
+    into.errEnergy += ch.errEnergy;
+    if (ch.maxAbsError > into.maxAbsError) {
+        into.maxAbsError   = ch.maxAbsError;
+        into.maxAbsIndex   = ch.maxAbsIndex;
+        into.maxAbsChannel = channel;
+    }
+    if (ch.firstDiff >= 0 && (into.firstDiff < 0 || ch.firstDiff < into.firstDiff)) {
+        into.firstDiff        = ch.firstDiff;
+        into.firstDiffChannel = channel;
+    }
+}
+
+} // namespace golden
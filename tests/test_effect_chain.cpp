@@ -1,10 +1,17 @@
 #include <gtest/gtest.h>
 #include "EffectChain.h"
+#include "AudioIOStats.h"
 #include "EffectEngine.h"
+#include "ChainProfiler.h"
+#include "PerfCounters.h"
+#include "Telemetry.h"
 #include "AudioBuffer.h"
 #include "effects/EffectNodeRegistry.h"
+#include "dsp/Denormals.h"
+#include <chrono>
 #include <cmath>
 #include <numeric>
+#include <thread>
 
 using namespace gearboxfx;
 
@@ -153,3 +160,313 @@ TEST(EffectEngine, LoadPreset) {
     EXPECT_TRUE(ok);
     EXPECT_FALSE(engine.chain().nodes().empty());
 }
+
+TEST(EffectEngine, TempoComesFromThePreset) {
+    EffectEngine engine;
+    engine.prepare(48000.0, 256);
+    engine.setTempo(90.0);
+
+    // Presets without "bpm" reset to the default
+    ASSERT_TRUE(engine.loadPreset("presets/01_clean_boost.json"));
+    EXPECT_DOUBLE_EQ(engine.tempo(), TempoClock::kDefaultBpm);
+
+    engine.setTempo(1000.0);
+    EXPECT_DOUBLE_EQ(engine.tempo(), TempoClock::kMaxBpm);
+    engine.setTempo(96.0);
+    EXPECT_DOUBLE_EQ(engine.tempoClock().bpm, 96.0);
+    EXPECT_DOUBLE_EQ(engine.currentPreset().bpm, 96.0);  // saved with the preset
+
+    // The clock runs at the set tempo: 96 bpm is 1.6 beats per second
+    AudioBuffer in(2, 256), out(2, 256);
+    const double start = engine.tempoClock().beat;
+    for (int b = 0; b < 375; ++b) engine.processBlock(in.view(), out.view(), 256);
+    EXPECT_NEAR(engine.tempoClock().beat - start, 3.2, 1e-9);
+}
+
+TEST(EffectEngine, LooperCommandsReachTheChain) {
+    EffectEngine engine;
+    engine.prepare(48000.0, 256);
+    EXPECT_FALSE(engine.looperCommand(LooperCommand::Record));  // no looper yet
+
+    auto node = engine.registry().create("utility.looper");
+    node->setId("looper");
+    engine.chain().addNode(node);
+    auto looper = std::dynamic_pointer_cast<LooperNode>(node);
+    ASSERT_NE(looper, nullptr);
+
+    AudioBuffer in = makeTone(2, 256, 220.0f, 48000.0f), out(2, 256);
+    ASSERT_TRUE(engine.looperCommand(LooperCommand::Record));
+    for (int b = 0; b < 4; ++b) engine.processBlock(in.view(), out.view(), 256);
+    EXPECT_EQ(looper->state(), LooperState::Recording);
+
+    ASSERT_TRUE(engine.looperCommand(LooperCommand::Play));
+    engine.processBlock(in.view(), out.view(), 256);
+    EXPECT_EQ(looper->state(), LooperState::Playing);
+    EXPECT_NEAR(looper->lengthSeconds(), 4 * 256 / 48000.0, 1e-9);
+}
+
+TEST(EffectEngine, FlushesSubnormalsDuringProcessBlock) {
+    if (!ScopedFlushDenormals::supported()) GTEST_SKIP() << "no FTZ/DAZ control on this target";
+
+    EffectEngine engine;
+    engine.prepare(48000.0, 256);
+    auto cab = engine.registry().create("cab.short_ir");
+    cab->setId("cab");
+    cab->setParam("taps", 1024.0f);
+    engine.chain().addNode(cab);
+
+    // A decayed tail: every input sample subnormal. Without FTZ/DAZ each of
+    // the 1024 multiply-adds per sample takes the slow path.
+    AudioBuffer in(2, 256), out(2, 256);
+    for (int c = 0; c < 2; ++c)
+        for (int s = 0; s < 256; ++s)
+            in.getWritePointer(c)[s] = (s & 1 ? -1.0f : 1.0f) * 1e-40f;
+    for (int b = 0; b < 8; ++b)
+        engine.processBlock(in.view(), out.view(), 256);
+
+    for (int c = 0; c < 2; ++c)
+        for (int s = 0; s < 256; ++s)
+            ASSERT_EQ(out.getReadPointer(c)[s], 0.0f) << "channel " << c << " sample " << s;
+
+    // The caller's floating-point mode is restored afterwards.
+    volatile float tiny = 1e-38f;
+    EXPECT_GT(tiny * 0.25f, 0.0f);
+}
+
+TEST(EffectEngine, TunerReadsInputPitch) {
+    EffectEngine engine;
+    engine.prepare(48000.0, 256);
+
+    // A2 (MIDI 45) tuned 10 cents sharp, fed in real-time-sized blocks
+    const double f = 110.0 * std::pow(2.0, 10.0 / 1200.0);
+    AudioBuffer in(2, 256), out(2, 256);
+    long long n = 0;
+    for (int b = 0; b < 100 && engine.tuner().note() < 0; ++b) {
+        for (int i = 0; i < 40; ++i) {
+            for (int s = 0; s < 256; ++s, ++n)
+                for (int c = 0; c < 2; ++c)
+                    in.getWritePointer(c)[s] = static_cast<float>(0.3 * std::sin(2.0 * 3.141592653589793 * f * n / 48000.0));
+            engine.processBlock(in.view(), out.view(), 256);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    EXPECT_EQ(engine.tuner().note(), 45);
+    EXPECT_STREQ(Tuner::noteName(engine.tuner().note()), "A");
+    EXPECT_NEAR(engine.tuner().cents(), 10.0f, 2.0f);
+    EXPECT_NEAR(engine.tuner().frequency(), f, 0.5);
+}
+
+TEST(Telemetry, MetersNodeInputOutputAndSpectrum) {
+    EffectChain chain;
+    chain.prepare(48000.0, 256);
+    EffectNodeRegistry reg;
+    auto boost = reg.create("gain.clean_boost");
+    boost->setId("boost");
+    boost->setParam("gain_db", 6.0f);
+    chain.addNode(boost);
+    auto comp = reg.create("dynamics.compressor");
+    comp->setId("comp");
+    comp->setParam("threshold_db", -30.0f);
+    chain.addNode(comp);
+
+    Telemetry telemetry;
+    telemetry.start(48000.0);
+    telemetry.sync(chain);
+    ASSERT_NE(boost->telemetryTaps(), nullptr);
+
+    // 1 kHz at 0.25 peak (-15 dB RMS), paced roughly like a callback
+    AudioBuffer in(2, 256), out(2, 256);
+    long long n = 0;
+    for (int b = 0; b < 60; ++b) {
+        for (int s = 0; s < 256; ++s, ++n)
+            for (int c = 0; c < 2; ++c)
+                in.getWritePointer(c)[s] = static_cast<float>(0.25 * std::sin(2.0 * 3.141592653589793 * 1000.0 * n / 48000.0));
+        chain.process(in.view(), out.view(), 256);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    Telemetry::NodeMeters m;
+    ASSERT_TRUE(telemetry.meters(boost.get(), m));
+    EXPECT_NEAR(m.input.peakDb, -12.04f, 1.0f);
+    EXPECT_GT(m.output.peakDb, m.input.peakDb + 5.0f);
+
+    int loudest = static_cast<int>(std::max_element(m.spectrumDb.begin(), m.spectrumDb.end()) - m.spectrumDb.begin());
+    EXPECT_NEAR(std::log2(telemetry.bandHz(loudest) / 1000.0f), 0.0f, 0.2f);
+    EXPECT_NEAR(m.spectrumDb[loudest], 20.0f * std::log10(0.5f), 1.5f);  // 0.25 peak + 6 dB
+
+    ASSERT_TRUE(telemetry.meters(comp.get(), m));
+    EXPECT_LT(m.gainReductionDb, -5.0f);
+
+    // Removed nodes lose their taps
+    chain.removeNode("comp");
+    telemetry.sync(chain);
+    EXPECT_EQ(comp->telemetryTaps(), nullptr);
+    EXPECT_FALSE(telemetry.meters(comp.get(), m));
+}
+
+TEST(ChainProfiler, TimesEachNodeWhenEnabled) {
+    if (!ChainProfiler::kCompiledIn) GTEST_SKIP() << "built without GEARBOX_PROFILER";
+
+    EffectChain chain;
+    chain.prepare(48000.0, 256);
+    EffectNodeRegistry reg;
+    auto boost = reg.create("gain.clean_boost");
+    boost->setId("boost");
+    chain.addNode(boost);
+    auto reverb = reg.create("time.reverb");
+    reverb->setId("verb");
+    chain.addNode(reverb);
+
+    auto in  = makeTone(2, 256, 440.0f, 48000.0f);
+    AudioBuffer out(2, 256);
+    ChainProfiler& prof = chain.profiler();
+
+    // Disabled: nothing recorded
+    for (int b = 0; b < 10; ++b) chain.process(in.view(), out.view(), 256);
+    prof.collect();
+    EXPECT_EQ(prof.report(chain).chain.count, 0);
+
+    prof.setEnabled(true);
+    for (int b = 0; b < 100; ++b) chain.process(in.view(), out.view(), 256);
+    prof.collect();
+    auto rep = prof.report(chain);
+
+    ASSERT_EQ(rep.nodes.size(), 2u);
+    EXPECT_EQ(rep.nodes[0].id, "boost");
+    EXPECT_EQ(rep.chain.count, 100);
+    EXPECT_NEAR(rep.deadlineUs, 256e6 / 48000.0, 0.5);
+    double shares = 0.0;
+    for (auto& n : rep.nodes) {
+        EXPECT_EQ(n.time.count, 100);
+        EXPECT_LE(n.time.min, n.time.mean);
+        EXPECT_LE(n.time.mean, n.time.max);
+        EXPECT_LE(n.time.p99, n.time.max);
+        shares += n.share;
+    }
+    EXPECT_NEAR(shares, 1.0, 1e-9);
+    EXPECT_GT(rep.nodes[1].share, rep.nodes[0].share);  // reverb outweighs a gain stage
+    EXPECT_GT(rep.loadPercent.mean, 0.0);
+    EXPECT_NE(rep.format().find("verb"), std::string::npos);
+}
+
+TEST(ChainProfiler, ForgetsNodesWhenTheChainChanges) {
+    if (!ChainProfiler::kCompiledIn) GTEST_SKIP() << "built without GEARBOX_PROFILER";
+
+    EffectChain chain;
+    chain.prepare(48000.0, 256);
+    auto boost = EffectNodeRegistry().create("gain.clean_boost");
+    boost->setId("boost");
+    chain.addNode(boost);
+
+    auto in  = makeTone(2, 256, 440.0f, 48000.0f);
+    AudioBuffer out(2, 256);
+    ChainProfiler& prof = chain.profiler();
+    prof.setEnabled(true);
+
+    for (int b = 0; b < 20; ++b) chain.process(in.view(), out.view(), 256);
+    prof.collect();
+    for (int b = 0; b < 10; ++b) chain.process(in.view(), out.view(), 256);  // still queued
+
+    // Same object back at the same address: neither the collected window nor
+    // the queued blocks of the old chain may count for it.
+    chain.removeNode("boost");
+    chain.addNode(boost);
+    for (int b = 0; b < 5; ++b) chain.process(in.view(), out.view(), 256);
+    prof.collect();
+
+    auto rep = prof.report(chain);
+    ASSERT_EQ(rep.nodes.size(), 1u);
+    EXPECT_EQ(rep.nodes[0].time.count, 5);
+    EXPECT_EQ(rep.chain.count, 35);  // whole-chain times stay valid
+
+    chain.clear();
+    prof.collect();
+    EXPECT_TRUE(prof.report(chain).nodes.empty());
+}
+
+TEST(ChainProfiler, HardwareCountersPerNodeType) {
+    if (!ChainProfiler::kCompiledIn) GTEST_SKIP() << "built without GEARBOX_PROFILER";
+
+    EffectChain chain;
+    chain.prepare(48000.0, 256);
+    EffectNodeRegistry reg;
+    for (const char* id : { "d1", "d2" }) {
+        auto delay = reg.create("time.delay");
+        delay->setId(id);
+        chain.addNode(delay);
+    }
+
+    auto in  = makeTone(2, 256, 440.0f, 48000.0f);
+    AudioBuffer out(2, 256);
+    ChainProfiler& prof = chain.profiler();
+    prof.setEnabled(true);
+    prof.setHardwareCounters(true);
+    for (int b = 0; b < 50; ++b) chain.process(in.view(), out.view(), 256);
+    prof.collect();
+    auto rep = prof.report(chain);
+
+    if (!rep.counterStatus.empty()) {
+        EXPECT_TRUE(rep.types.empty());
+        GTEST_SKIP() << rep.counterStatus;
+    }
+    ASSERT_EQ(rep.types.size(), 1u);  // both delays under one type
+    EXPECT_EQ(rep.types[0].typeId, "time.delay");
+    EXPECT_EQ(rep.types[0].samples, 2u * 50u * 256u);
+    EXPECT_GT(rep.types[0].perSample(PerfCounters::Cycles), 0.0);
+    EXPECT_GT(rep.types[0].ipc(), 0.0);
+}
+
+TEST(AudioIOStats, BucketsAreQuarterOctaves) {
+    EXPECT_EQ(AudioIOStats::bucketFor(0), 0);
+    EXPECT_EQ(AudioIOStats::bucketFor(1024), 0);                 // 1.024 us
+    EXPECT_EQ(AudioIOStats::bucketFor(1024 + 256), 1);           // 1.25 x
+    EXPECT_EQ(AudioIOStats::bucketFor(2048), 4);                 // next octave
+    EXPECT_EQ(AudioIOStats::bucketFor(std::int64_t{1} << 40), AudioIOStats::kBuckets - 1);
+
+    // Every value lies below its bucket's upper edge and above the previous one's
+    for (std::int64_t ns : { 1500, 5333333, 21000, 999999 }) {
+        int b = AudioIOStats::bucketFor(ns);
+        EXPECT_LT(ns * 1e-3, AudioIOStats::Histogram::bucketUpperUs(b));
+        EXPECT_GE(ns * 1e-3, AudioIOStats::Histogram::bucketUpperUs(b - 1));
+    }
+}
+
+TEST(AudioIOStats, CountsOverrunsSkipsAndDriverFlags) {
+    AudioIOStats stats;
+    stats.setPeriod(48000.0, 48);  // 1 ms
+
+    for (int i = 0; i < 20; ++i) {
+        auto t0 = stats.callbackBegin();
+        if (i == 5) std::this_thread::sleep_for(std::chrono::milliseconds(3));  // overrun
+        if (i == 7) stats.noteLockSkip();
+        stats.callbackEnd(t0);
+    }
+    stats.noteUnderflow();
+    auto first = stats.snapshot();
+
+    EXPECT_EQ(first.callbacks, 20u);
+    EXPECT_GE(first.overruns, 1u);
+    EXPECT_EQ(first.lockSkips, 1u);
+    EXPECT_EQ(first.underflows, 1u);
+    EXPECT_EQ(first.duration.total(), 20u);
+    EXPECT_EQ(first.interval.total(), 19u);  // none before the first callback
+    EXPECT_GE(first.maxDurationUs, 3000.0);
+    EXPECT_GE(first.duration.percentileUs(100), 3000.0);
+    EXPECT_NEAR(first.periodUs, 1000.0, 1e-6);
+
+    auto t0 = stats.callbackBegin();
+    stats.noteOverflow();
+    stats.callbackEnd(t0);
+    auto delta = stats.snapshot() - first;
+    EXPECT_EQ(delta.callbacks, 1u);
+    EXPECT_EQ(delta.overflows, 1u);
+    EXPECT_EQ(delta.lockSkips, 0u);
+    EXPECT_EQ(delta.duration.total(), 1u);
+    EXPECT_NE(delta.format().find("overflows 1"), std::string::npos);
+
+    stats.reset();
+    EXPECT_EQ(stats.snapshot().callbacks, 0u);
+    EXPECT_EQ(stats.snapshot().duration.total(), 0u);
+}
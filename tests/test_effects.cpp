@@ -1,7 +1,20 @@
 #include <gtest/gtest.h>
 #include "effects/EffectNodeRegistry.h"
+#include "effects/OversampledNode.h"
+#include "dsp/Adaa.h"
+#include "dsp/DirectFir.h"
+#include "dsp/Lfo.h"
+#include "dsp/LookaheadLimiter.h"
+#include "dsp/ModulatedDelay.h"
+#include "dsp/PitchDetector.h"
+#include "effects/amp/NeuralAmpNode.h"
+#include "effects/modulation/PhaserNode.h"
+#include "effects/utility/LooperNode.h"
 #include "AudioBuffer.h"
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <thread>
 
 using namespace gearboxfx;
 
@@ -26,6 +39,18 @@ static float rms(const float* d, int n) {
     return std::sqrt(s / n);
 }
 
+// Magnitude of one frequency component (Hann-windowed single-bin DFT).
+static double toneMagnitude(const std::vector<float>& x, double freq) {
+    double re = 0.0, im = 0.0, n = static_cast<double>(x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        double w  = 0.5 - 0.5 * std::cos(2.0 * 3.141592653589793 * i / n);
+        double ph = 2.0 * 3.141592653589793 * freq * i / kSR;
+        re += w * x[i] * std::cos(ph);
+        im -= w * x[i] * std::sin(ph);
+    }
+    return std::sqrt(re * re + im * im);
+}
+
 static std::shared_ptr<EffectNode> makeNode(const std::string& type) {
     static EffectNodeRegistry reg;
     auto n = reg.create(type);
@@ -49,18 +74,22 @@ static std::shared_ptr<EffectNode> makeNode(const std::string& type) {
 
 TEST_SILENCE_PASSTHROUGH(dynamics_noise_gate,          "dynamics.noise_gate")
 TEST_SILENCE_PASSTHROUGH(dynamics_compressor,          "dynamics.compressor")
+TEST_SILENCE_PASSTHROUGH(amp_neural,                   "amp.neural")
+TEST_SILENCE_PASSTHROUGH(cab_short_ir,                 "cab.short_ir")
 TEST_SILENCE_PASSTHROUGH(eq_parametric,                "eq.parametric")
 TEST_SILENCE_PASSTHROUGH(gain_clean_boost,             "gain.clean_boost")
 TEST_SILENCE_PASSTHROUGH(gain_overdrive,               "gain.overdrive")
 TEST_SILENCE_PASSTHROUGH(gain_distortion,              "gain.distortion")
 TEST_SILENCE_PASSTHROUGH(modulation_chorus,            "modulation.chorus")
 TEST_SILENCE_PASSTHROUGH(modulation_flanger,           "modulation.flanger")
+TEST_SILENCE_PASSTHROUGH(modulation_octave_divider,    "modulation.octave_divider")
 TEST_SILENCE_PASSTHROUGH(modulation_phaser,            "modulation.phaser")
 TEST_SILENCE_PASSTHROUGH(modulation_pitch_shifter,     "modulation.pitch_shifter")
 TEST_SILENCE_PASSTHROUGH(modulation_tremolo,           "modulation.tremolo")
 TEST_SILENCE_PASSTHROUGH(output_volume,                "output.volume")
 TEST_SILENCE_PASSTHROUGH(time_delay,                   "time.delay")
 TEST_SILENCE_PASSTHROUGH(time_reverb,                  "time.reverb")
+TEST_SILENCE_PASSTHROUGH(utility_looper,               "utility.looper")
 
 // ── Signal level tests ────────────────────────────────────────────────────────
 
@@ -124,6 +153,26 @@ TEST(Effects, NoiseGate_PassesLoudSignal) {
     EXPECT_GT(rmsOut / rmsIn, 0.9f);  // should mostly pass through
 }
 
+TEST(Effects, NoiseGate_SteadyStatesAreExact) {
+    auto node = makeNode("dynamics.noise_gate");
+    node->setParam("threshold_db", -40.0f);
+    node->setParam("release_ms", 10.0f);
+
+    AudioBuffer loud = makeTone(440.0f, 0.5f), quiet = makeTone(440.0f, 0.001f);
+    AudioBuffer out(kCh, kBlock);
+    auto lv = loud.view(), qv = quiet.view(), ov = out.view();
+
+    // Fully open: bit-exact copy
+    for (int i = 0; i < 100; ++i) node->process(lv, ov, kBlock);
+    for (int s = 0; s < kBlock; ++s)
+        EXPECT_EQ(out.getReadPointer(0)[s], loud.getReadPointer(0)[s]);
+
+    // Fully closed: exact silence
+    for (int i = 0; i < 100; ++i) node->process(qv, ov, kBlock);
+    for (int s = 0; s < kBlock; ++s)
+        EXPECT_EQ(out.getReadPointer(0)[s], 0.0f);
+}
+
 TEST(Effects, Overdrive_SaturatesHighGain) {
     auto node = makeNode("gain.overdrive");
     node->setParam("gain", 1.0f);
@@ -179,6 +228,59 @@ TEST(Effects, Compressor_ReducesDynamics) {
     EXPECT_LT(rmsOut, rmsIn);
 }
 
+TEST(Effects, Compressor_BelowKneeIsMakeupOnly) {
+    auto node = makeNode("dynamics.compressor");
+    node->setParam("threshold_db", -10.0f);
+    node->setParam("knee_db", 6.0f);
+    node->setParam("makeup_db", 6.0f);
+
+    AudioBuffer in = makeTone(440.0f, 0.05f), out(kCh, kBlock);  // ≈ -29 dB RMS
+    auto iv = in.view(), ov = out.view();
+    for (int i = 0; i < 5; ++i) node->process(iv, ov, kBlock);
+
+    float makeup = std::pow(10.0f, 6.0f / 20.0f);
+    for (int s = 0; s < kBlock; ++s)
+        EXPECT_FLOAT_EQ(out.getReadPointer(0)[s], in.getReadPointer(0)[s] * makeup);
+}
+
+TEST(Effects, Compressor_MatchesPerSampleReference) {
+    auto node = makeNode("dynamics.compressor");
+    node->setParam("threshold_db", -20.0f);
+    node->setParam("ratio", 6.0f);
+    node->setParam("knee_db", 8.0f);
+    node->setParam("attack_ms", 2.0f);
+    node->setParam("release_ms", 50.0f);
+
+    // Straight per-sample soft-knee RMS compressor (the textbook form)
+    double attack  = std::exp(-1.0 / (kSR * 0.002));
+    double release = std::exp(-1.0 / (kSR * 0.050));
+    double env = -96.0;
+
+    AudioBuffer in(kCh, kBlock), out(kCh, kBlock);
+    float worst = 0.0f;
+    for (int b = 0; b < 40; ++b) {
+        float amp = (b / 10) % 2 ? 0.8f : 0.02f;  // bursts across the knee
+        for (int c = 0; c < kCh; ++c)
+            for (int s = 0; s < kBlock; ++s)
+                in.getWritePointer(c)[s] = amp * std::sin(2.0f * 3.14159f * 220.0f * (b * kBlock + s) / (float)kSR);
+        auto iv = in.view(), ov = out.view();
+        node->process(iv, ov, kBlock);
+
+        for (int s = 0; s < kBlock; ++s) {
+            double x     = in.getReadPointer(0)[s];
+            double level = 20.0 * std::log10(std::abs(x) + 1e-10);
+            env = level + ((level > env) ? attack : release) * (env - level);
+            double diff = env + 20.0, g;
+            if      (diff < -4.0) g = 0.0;
+            else if (diff <  4.0) g = (1.0 / 6.0 - 1.0) * (diff + 4.0) * (diff + 4.0) / 16.0;
+            else                  g = (1.0 / 6.0 - 1.0) * diff;
+            double ref = x * std::pow(10.0, g / 20.0);
+            worst = std::max(worst, static_cast<float>(std::abs(out.getReadPointer(0)[s] - ref)));
+        }
+    }
+    EXPECT_LT(worst, 1e-4f);
+}
+
 TEST(Effects, Delay_ProducesDelayedSignal) {
     auto node = makeNode("time.delay");
     node->setParam("time_ms", 100.0f);
@@ -216,6 +318,34 @@ TEST(Effects, Reverb_ProducesWetSignal) {
     EXPECT_GT(rms(out.getReadPointer(0), kBlock), 0.001f);
 }
 
+TEST(Effects, Reverb_ParamChangesWhileProcessing) {
+    auto node = makeNode("time.reverb");
+    node->setParam("mix", 1.0f);
+
+    // GUI thread: sweep size (the filter lengths) while audio runs.
+    std::atomic<bool> done{false};
+    std::thread gui([&] {
+        for (int i = 0; i < 2000 && !done; ++i)
+            node->setParam("size", (i % 3) * 0.5f);
+        done = true;
+    });
+
+    AudioBuffer in = makeTone(220.0f, 0.5f), out(kCh, kBlock);
+    auto iv = in.view(), ov = out.view();
+    while (!done) {
+        node->process(iv, ov, kBlock);
+        for (int s = 0; s < kBlock; ++s)
+            ASSERT_TRUE(std::isfinite(out.getReadPointer(0)[s]));
+    }
+    gui.join();
+
+    // A parameter change keeps the tail instead of clearing the filters.
+    node->setParam("mix", 0.9f);
+    AudioBuffer silence = makeSilence();
+    node->process(silence.view(), ov, kBlock);
+    EXPECT_GT(rms(out.getReadPointer(0), kBlock), 0.001f);
+}
+
 TEST(Effects, Chorus_MixBlendsDryWet) {
     auto node = makeNode("modulation.chorus");
     node->setParam("mix", 0.0f);  // 100% dry
@@ -230,6 +360,63 @@ TEST(Effects, Chorus_MixBlendsDryWet) {
     EXPECT_NEAR(rmsOut, rmsIn, rmsIn * 0.01f);  // dry = input
 }
 
+TEST(Effects, Chorus_MonoInputFeedsBothChannels) {
+    auto node = makeNode("modulation.chorus");
+    node->setParam("mix", 1.0f);
+
+    AudioBuffer stereo = makeTone(440.0f, 0.5f);
+    AudioBuffer mono(1, kBlock), out(kCh, kBlock);
+    std::copy(stereo.getReadPointer(0), stereo.getReadPointer(0) + kBlock, mono.getWritePointer(0));
+    auto iv = mono.view(), ov = out.view();
+    for (int i = 0; i < 10; ++i) node->process(iv, ov, kBlock);
+
+    EXPECT_GT(rms(out.getReadPointer(1), kBlock), 0.1f);
+    for (int s = 0; s < kBlock; ++s)
+        ASSERT_EQ(out.getReadPointer(1)[s], out.getReadPointer(0)[s]) << "sample " << s;
+}
+
+TEST(Effects, Chorus_EightVoicesStayBounded) {
+    auto node = makeNode("modulation.chorus");
+    node->setParam("voices", 8.0f);
+    node->setParam("mix",    1.0f);
+    node->setParam("depth",  1.0f);
+
+    AudioBuffer in  = makeTone(440.0f, 0.5f);
+    AudioBuffer out(kCh, kBlock);
+    auto iv = in.view(), ov = out.view();
+    for (int i = 0; i < 20; ++i) node->process(iv, ov, kBlock);
+
+    // Wet gain is split across the voices: the ensemble is never louder than the input
+    float rmsIn  = rms(in.getReadPointer(0), kBlock);
+    float rmsOut = rms(out.getReadPointer(0), kBlock);
+    EXPECT_GT(rmsOut, 0.05f * rmsIn);
+    EXPECT_LT(rmsOut, 1.01f * rmsIn);
+}
+
+TEST(Effects, ModulatedDelay_TapSumMatchesSingleReads) {
+    ModulatedDelay delay;
+    delay.prepare(1000);
+    for (int s = 0; s < 1500; ++s) {
+        delay.push(0, std::sin(0.01f * s) + 0.1f * (s % 7));
+        delay.advance();
+    }
+
+    float delays[ModulatedDelay::kLanes], weights[ModulatedDelay::kLanes];
+    for (int j = 0; j < ModulatedDelay::kLanes; ++j) {
+        delays[j]  = 1.0f + 123.37f * j;
+        weights[j] = (j % 3 == 2) ? 0.0f : 0.1f * (j + 1);
+    }
+
+    float expected = 0.0f;
+    for (int j = 0; j < ModulatedDelay::kLanes; ++j)
+        expected += weights[j] * delay.read(0, delays[j]);
+    EXPECT_NEAR(delay.tapSum(0, delays, weights), expected, 1e-5f);
+
+    // Linear interpolation between the two neighbouring samples
+    EXPECT_NEAR(delay.read(0, 10.25f), 0.75f * delay.read(0, 10.0f) + 0.25f * delay.read(0, 11.0f), 1e-6f);
+    EXPECT_GE(delay.maxDelay(), 1000.0f);
+}
+
 TEST(Effects, Tremolo_ModulatesAmplitude) {
     auto node = makeNode("modulation.tremolo");
     node->setParam("rate", 10.0f);
@@ -246,16 +433,96 @@ TEST(Effects, Tremolo_ModulatesAmplitude) {
     EXPECT_LT(rmsOut, rmsIn);  // tremolo reduces average level
 }
 
+TEST(Effects, Tremolo_SyncFollowsTempoClock) {
+    auto node = makeNode("modulation.tremolo");
+    node->setParam("depth", 1.0f);
+    node->setParam("sync",  3.0f);  // 1/4: one cycle per beat
+
+    TempoClock clock;
+    clock.bpm = 120.0;
+    node->setTempoClock(&clock);
+
+    AudioBuffer in = makeTone(440.0f, 0.5f), out(kCh, kBlock);
+    auto iv = in.view(), ov = out.view();
+    const float rmsIn = rms(in.getReadPointer(0) + 64, kBlock - 64);
+
+    // Quarter beat: sine LFO at its peak → unity gain
+    clock.beat = 0.25;
+    node->process(iv, ov, kBlock);
+    node->process(iv, ov, kBlock);
+    EXPECT_NEAR(rms(out.getReadPointer(0) + 64, kBlock - 64), rmsIn, rmsIn * 0.02f);
+
+    // Three quarters: trough → silence at full depth
+    clock.beat = 0.75;
+    node->process(iv, ov, kBlock);
+    node->process(iv, ov, kBlock);
+    EXPECT_LT(rms(out.getReadPointer(0) + 64, kBlock - 64), rmsIn * 0.02f);
+}
+
+TEST(Effects, Lfo_WavetablesMatchShapes) {
+    Lfo lfo;
+    lfo.prepare(kSR);
+    lfo.setRate(static_cast<float>(kSR) / 1000.0f);  // 1000-sample cycle
+    lfo.setControlInterval(1);
+
+    std::vector<float> buf(1000);
+    const LfoShape shapes[] = { LfoShape::Sine, LfoShape::Triangle, LfoShape::Square };
+    for (LfoShape shape : shapes) {
+        lfo.setShape(shape);
+        lfo.reset();
+        lfo.process(buf.data(), 1000);
+        for (int i = 0; i < 1000; ++i) {
+            float p = i / 1000.0f;  // sample i is the value at phase i/1000
+            switch (shape) {
+                case LfoShape::Sine:
+                    EXPECT_NEAR(buf[i], std::sin(2.0f * 3.14159265f * p), 1e-4f);
+                    break;
+                case LfoShape::Triangle:
+                    // Band-limited: corners are rounded, the rest is linear
+                    if (std::abs(p - 0.5f) > 0.1f && p > 0.1f && p < 0.9f)
+                        EXPECT_NEAR(buf[i], p < 0.5f ? 4.0f * p - 1.0f : 3.0f - 4.0f * p, 0.05f);
+                    break;
+                default:
+                    if (p > 0.1f && p < 0.4f) EXPECT_GT(buf[i],  0.9f);
+                    if (p > 0.6f && p < 0.9f) EXPECT_LT(buf[i], -0.9f);
+                    break;
+            }
+            EXPECT_LE(std::abs(buf[i]), 1.0f);
+        }
+    }
+}
+
+TEST(Effects, Lfo_ControlRateTracksAudioRate) {
+    Lfo fine, coarse;
+    for (Lfo* l : { &fine, &coarse }) {
+        l->prepare(kSR);
+        l->setRate(5.0f);
+        l->reset();
+    }
+    fine.setControlInterval(1);
+    coarse.setControlInterval(Lfo::kDefaultControlInterval);
+
+    // Control rate lags by one interval; compare against the delayed fine LFO.
+    std::vector<float> a(kBlock * 20), b(kBlock * 20);
+    fine.process(a.data(), static_cast<int>(a.size()));
+    coarse.process(b.data(), static_cast<int>(b.size()));
+    const int lag = Lfo::kDefaultControlInterval - 1;
+    for (size_t i = lag; i < a.size(); ++i)
+        EXPECT_NEAR(b[i], a[i - lag], 1e-4f) << "sample " << i;
+}
+
 TEST(Effects, Registry_AllTypesRegistered) {
     EffectNodeRegistry reg;
     std::vector<std::string> expected = {
         "dynamics.noise_gate", "dynamics.compressor",
+        "amp.neural", "cab.short_ir",
         "eq.parametric",
         "gain.clean_boost", "gain.overdrive", "gain.distortion",
-        "modulation.chorus", "modulation.flanger", "modulation.phaser",
-        "modulation.pitch_shifter", "modulation.tremolo",
+        "modulation.chorus", "modulation.flanger", "modulation.octave_divider",
+        "modulation.phaser", "modulation.pitch_shifter", "modulation.tremolo",
         "output.volume",
-        "time.delay", "time.reverb"
+        "time.delay", "time.reverb",
+        "utility.looper"
     };
     for (auto& t : expected) {
         EXPECT_TRUE(reg.has(t)) << "Missing: " << t;
@@ -267,7 +534,7 @@ TEST(Effects, Registry_AllTypesRegistered) {
 // ── EQ (eq.parametric) ────────────────────────────────────────────────────────
 
 TEST(Effects, EQ_FlatSettingIsTransparent) {
-    // Default params are all 0 dB → biquads collapse to identity (H(z)=1)
+    // Default params are all 0 dB → every band collapses to identity (H(z)=1)
     auto node = makeNode("eq.parametric");
     // defaults already 0 dB — no setParam needed
 
@@ -296,6 +563,55 @@ TEST(Effects, EQ_TrebleBoostIncreasesHFRMS) {
     EXPECT_GT(rmsOut, rmsIn * 1.2f);  // must be noticeably louder
 }
 
+TEST(Effects, EQ_MidBoostMatchesSetGain) {
+    auto node = makeNode("eq.parametric");
+    node->setParam("mid_db",   12.0f);
+    node->setParam("mid_freq", 1500.0f);
+
+    AudioBuffer in  = makeTone(1500.0f, 0.1f);  // 32 samples per cycle: blocks are continuous
+    AudioBuffer out(kCh, kBlock);
+    auto iv = in.view(), ov = out.view();
+    for (int i = 0; i < 40; ++i) node->process(iv, ov, kBlock);
+
+    float gain = rms(out.getReadPointer(0), kBlock) / rms(in.getReadPointer(0), kBlock);
+    EXPECT_NEAR(gain, std::pow(10.0f, 12.0f / 20.0f), 0.05f);
+}
+
+TEST(Effects, EQ_ParamChangeGlidesOntoTarget) {
+    auto gliding = makeNode("eq.parametric");
+    auto fresh   = makeNode("eq.parametric");
+    fresh->setParam("treble_db", 12.0f);
+    fresh->setParam("mid_freq",  3000.0f);
+
+    AudioBuffer in = makeTone(1500.0f, 0.1f);
+    AudioBuffer outA(kCh, kBlock), outB(kCh, kBlock);
+    auto iv = in.view(), ovA = outA.view(), ovB = outB.view();
+    for (int i = 0; i < 10; ++i) gliding->process(iv, ovA, kBlock);
+
+    // Jump both params: no sample-to-sample step larger than the steady-state
+    // slope of the (boosted) tone, i.e. no click from a coefficient jump.
+    gliding->setParam("treble_db", 12.0f);
+    gliding->setParam("mid_freq",  3000.0f);
+    float prev = outA.getReadPointer(0)[kBlock - 1], maxStep = 0.0f;
+    for (int i = 0; i < 40; ++i) {
+        gliding->process(iv, ovA, kBlock);
+        fresh->process(iv, ovB, kBlock);
+        for (int s = 0; s < kBlock; ++s) {
+            float y = outA.getReadPointer(0)[s];
+            maxStep = std::max(maxStep, std::abs(y - prev));
+            prev = y;
+        }
+    }
+    float steadyStep = 0.0f;
+    for (int s = 1; s < kBlock; ++s)
+        steadyStep = std::max(steadyStep, std::abs(outB.getReadPointer(0)[s] - outB.getReadPointer(0)[s - 1]));
+    EXPECT_LE(maxStep, steadyStep * 1.05f);
+
+    // Once settled it is exactly the filter a fresh node builds
+    for (int s = 0; s < kBlock; ++s)
+        EXPECT_NEAR(outA.getReadPointer(0)[s], outB.getReadPointer(0)[s], 1e-4f);
+}
+
 TEST(Effects, EQ_BassCutReducesLFRMS) {
     auto node = makeNode("eq.parametric");
     node->setParam("bass_db", -12.0f);
@@ -418,6 +734,43 @@ TEST(Effects, Phaser_HighFeedbackStaysBounded) {
         EXPECT_LT(std::abs(o[s]), 5.0f) << "sample " << s << " diverged";
 }
 
+TEST(Effects, Phaser_ControlIntervalIsAdjustable) {
+    auto render = [](int interval) {
+        PhaserNode node;
+        node.setParam("rate", 5.0f);
+        node.setParam("mix",  1.0f);
+        node.setControlInterval(interval);
+        node.prepare(kSR, kBlock);
+
+        AudioBuffer in = makeTone(440.0f, 0.5f), out(kCh, kBlock);
+        auto iv = in.view(), ov = out.view();
+        std::vector<float> y;
+        for (int b = 0; b < 20; ++b) {
+            node.process(iv, ov, kBlock);
+            y.insert(y.end(), out.getReadPointer(0), out.getReadPointer(0) + kBlock);
+        }
+        return y;
+    };
+
+    const auto perSample = render(1);
+    const auto clamped   = render(0);   // clamped to 1
+    const auto coarse    = render(kDefaultControlInterval);
+    const auto veryCoarse = render(256);
+
+    float coarseErr = 0.0f, veryCoarseErr = 0.0f;
+    for (size_t i = 0; i < perSample.size(); ++i) {
+        ASSERT_EQ(clamped[i], perSample[i]) << "sample " << i;
+        if (i < static_cast<size_t>(kBlock)) continue;  // the first ramp starts from fc = 0
+        coarseErr     = std::max(coarseErr,     std::abs(coarse[i]     - perSample[i]));
+        veryCoarseErr = std::max(veryCoarseErr, std::abs(veryCoarse[i] - perSample[i]));
+    }
+    // The ramp between control points tracks the per-sample sweep closely;
+    // a longer interval is further off but still applied.
+    EXPECT_GT(coarseErr, 0.0f);
+    EXPECT_LT(coarseErr, 0.05f);  // 10% of the tone
+    EXPECT_GT(veryCoarseErr, 2.0f * coarseErr);
+}
+
 // ── PitchShifter (modulation.pitch_shifter) ───────────────────────────────────
 
 TEST(Effects, PitchShifter_DryMixPassesThrough) {
@@ -465,6 +818,257 @@ TEST(Effects, PitchShifter_OutputBounded) {
         EXPECT_LT(std::abs(o[s]), 2.0f) << "sample " << s << " out of range";
 }
 
+// Renders numBlocks of a continuous chord (same on both channels unless
+// rightSilent) and returns the last `keep` blocks of the left channel.
+static std::vector<float> renderChord(EffectNode& node, std::initializer_list<float> freqs,
+                                      int numBlocks, int keep, bool rightSilent = false,
+                                      std::vector<float>* right = nullptr)
+{
+    AudioBuffer in(kCh, kBlock), out(kCh, kBlock);
+    auto iv = in.view(), ov = out.view();
+    std::vector<float> left;
+    for (int b = 0; b < numBlocks; ++b) {
+        for (int s = 0; s < kBlock; ++s) {
+            double t = static_cast<double>(b * kBlock + s) / kSR, v = 0.0;
+            for (float f : freqs) v += 0.3 * std::sin(2.0 * 3.141592653589793 * f * t);
+            in.getWritePointer(0)[s] = static_cast<float>(v);
+            in.getWritePointer(1)[s] = rightSilent ? 0.0f : static_cast<float>(v);
+        }
+        node.process(iv, ov, kBlock);
+        if (b >= numBlocks - keep) {
+            left.insert(left.end(), out.getReadPointer(0), out.getReadPointer(0) + kBlock);
+            if (right)
+                right->insert(right->end(), out.getReadPointer(1), out.getReadPointer(1) + kBlock);
+        }
+    }
+    return left;
+}
+
+TEST(Effects, PitchShifter_VocoderShiftsChordAnOctave) {
+    auto node = makeNode("modulation.pitch_shifter");
+    node->setParam("mode",      1.0f);
+    node->setParam("semitones", 12.0f);
+    EXPECT_EQ(node->latencySamples(), 2048);
+
+    auto y = renderChord(*node, { 440.0f, 554.37f }, 64, 16);
+    double up1 = toneMagnitude(y, 880.0), up2 = toneMagnitude(y, 1108.73);
+    double org1 = toneMagnitude(y, 440.0), org2 = toneMagnitude(y, 554.37);
+    double between = toneMagnitude(y, 990.0);
+    EXPECT_GT(up1, 10.0 * org1);
+    EXPECT_GT(up2, 10.0 * org2);
+    EXPECT_GT(std::min(up1, up2), 10.0 * between);  // no intermodulation smear between partials
+}
+
+// At mix 0.5 and no shift the dry and wet halves only add up to the input
+// level if the dry half is delayed by the vocoder latency too; misaligned,
+// the chord partials partly cancel.
+TEST(Effects, PitchShifter_VocoderDryLinesUpWithWet) {
+    auto node = makeNode("modulation.pitch_shifter");
+    node->setParam("mode",     1.0f);
+    node->setParam("mix",      0.5f);
+    node->setParam("fft_size", 2048.0f);
+    node->setParam("overlap",  4.0f);
+    const int latency = node->latencySamples();
+    EXPECT_EQ(latency, 2048);
+
+    auto y = renderChord(*node, { 440.0f, 660.0f }, 40, 16);
+    std::vector<float> ref;
+    for (int i = 0; i < 16 * kBlock; ++i) {
+        // Same chord, unprocessed, latency samples earlier
+        double t = static_cast<double>(24 * kBlock + i - latency) / kSR;
+        ref.push_back(static_cast<float>(0.3 * std::sin(2.0 * 3.141592653589793 * 440.0 * t) +
+                                         0.3 * std::sin(2.0 * 3.141592653589793 * 660.0 * t)));
+    }
+    double num = 0.0, den = 0.0;
+    for (size_t i = 0; i < y.size(); ++i) {
+        num += static_cast<double>(ref[i]) * ref[i];
+        den += static_cast<double>(y[i] - ref[i]) * (y[i] - ref[i]);
+    }
+    EXPECT_GT(10.0 * std::log10(num / den), 30.0);  // null depth against the delayed input
+}
+
+TEST(Effects, PitchShifter_VocoderPreservesStereo) {
+    auto node = makeNode("modulation.pitch_shifter");
+    node->setParam("mode",      1.0f);
+    node->setParam("semitones", 7.0f);
+
+    std::vector<float> right;
+    auto left = renderChord(*node, { 330.0f }, 40, 8, true, &right);
+    EXPECT_GT(rms(left.data(), static_cast<int>(left.size())), 0.05f);
+    EXPECT_LT(rms(right.data(), static_cast<int>(right.size())), 1e-6f);
+}
+
+TEST(Effects, PitchShifter_PsolaShiftsNoteAFifth) {
+    auto node = makeNode("modulation.pitch_shifter");
+    node->setParam("mode",      2.0f);
+    node->setParam("semitones", 7.0f);
+    EXPECT_LT(node->latencySamples(), static_cast<int>(0.010 * kSR));
+
+    // A 220 Hz note with two harmonics
+    auto y = renderChord(*node, { 220.0f, 440.0f, 660.0f }, 64, 16);
+    double up  = toneMagnitude(y, 220.0 * 1.4983);
+    double org = toneMagnitude(y, 220.0);
+    EXPECT_GT(up, 5.0 * org);
+}
+
+// The dry part of the mix is delayed by the reported latency.
+TEST(Effects, PitchShifter_PsolaDryLinesUpWithWet) {
+    auto node = makeNode("modulation.pitch_shifter");
+    node->setParam("mode", 2.0f);
+    node->setParam("mix",  0.0f);
+    const int latency = node->latencySamples();
+    ASSERT_GT(latency, 0);
+
+    AudioBuffer in(kCh, kBlock), out(kCh, kBlock);
+    std::vector<float> x, y;
+    for (int b = 0; b < 8; ++b) {
+        for (int s = 0; s < kBlock; ++s) {
+            const float v = std::sin(0.05f * static_cast<float>(x.size())) * 0.5f;
+            in.getWritePointer(0)[s] = in.getWritePointer(1)[s] = v;
+            x.push_back(v);
+        }
+        node->process(in.view(), out.view(), kBlock);
+        y.insert(y.end(), out.getReadPointer(1), out.getReadPointer(1) + kBlock);
+    }
+    for (int i = 0; i < static_cast<int>(y.size()); ++i)
+        ASSERT_FLOAT_EQ(y[i], i >= latency ? x[i - latency] : 0.0f) << i;
+}
+
+TEST(Effects, PitchDetector_TracksGuitarRange) {
+    for (float f : { 82.41f, 110.0f, 196.0f, 329.63f, 659.26f, 1046.5f }) {
+        PitchDetector det;
+        det.prepare(kSR);
+        std::vector<float> x(static_cast<size_t>(kSR / 10));
+        for (size_t i = 0; i < x.size(); ++i) {
+            double ph = 2.0 * 3.141592653589793 * f * i / kSR;
+            x[i] = static_cast<float>(0.5 * std::sin(ph) + 0.25 * std::sin(2.0 * ph) + 0.1 * std::sin(3.0 * ph));
+        }
+        det.push(x.data(), static_cast<int>(x.size()));
+        EXPECT_NEAR(det.frequency(), f, f * 0.01f) << f << " Hz";
+        EXPECT_GT(det.confidence(), 0.85f);
+    }
+}
+
+TEST(Effects, OctaveDivider_SubAndUpVoices) {
+    auto sub = makeNode("modulation.octave_divider");
+    sub->setParam("dry", 0.0f);
+    sub->setParam("sub", 1.0f);
+    auto y = renderChord(*sub, { 220.0f }, 48, 16);
+    EXPECT_GT(toneMagnitude(y, 110.0), 5.0 * toneMagnitude(y, 220.0));
+
+    auto up = makeNode("modulation.octave_divider");
+    up->setParam("dry", 0.0f);
+    up->setParam("sub", 0.0f);
+    up->setParam("up",  1.0f);
+    y = renderChord(*up, { 220.0f }, 48, 16);
+    EXPECT_GT(toneMagnitude(y, 440.0), 5.0 * toneMagnitude(y, 220.0));
+    EXPECT_GT(rms(y.data(), static_cast<int>(y.size())), 0.05f);
+}
+
+// ── LooperNode (utility.looper) ──────────────────────────────────────────────
+
+// Runs one block of `value(i)` (i = running sample index) through the looper
+// and returns the left output.
+template <typename F>
+static std::vector<float> loopBlock(LooperNode& node, long long& counter, F value) {
+    AudioBuffer in(kCh, kBlock), out(kCh, kBlock);
+    for (int s = 0; s < kBlock; ++s, ++counter)
+        for (int c = 0; c < kCh; ++c)
+            in.getWritePointer(c)[s] = value(counter);
+    node.process(in.view(), out.view(), kBlock);
+    return { out.getReadPointer(0), out.getReadPointer(0) + kBlock };
+}
+
+static float loopSignal(long long i) { return 0.25f * std::sin(0.01f * static_cast<float>(i)); }
+
+// Blocks until the disk thread has served every request made so far, which is
+// what a real callback period gives it. False on timeout.
+static bool waitForSpill(const LooperNode& node) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (node.spillPending() > 0) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+TEST(Effects, Looper_RecordOverdubUndoRedo) {
+    LooperNode node;
+    node.setMemorySeconds(1.0);
+    node.setDiskSpill(false);
+    node.prepare(kSR, kBlock);
+
+    long long n = 0;
+    node.command(LooperCommand::Record);
+    for (int b = 0; b < 8; ++b) loopBlock(node, n, loopSignal);
+    node.command(LooperCommand::Play);
+    EXPECT_NEAR(node.lengthSeconds(), 0.0, 1e-9);  // applied by the next block
+
+    auto silence = [](long long) { return 0.0f; };
+    auto y = loopBlock(node, n, silence);
+    EXPECT_EQ(node.state(), LooperState::Playing);
+    EXPECT_NEAR(node.lengthSeconds(), 8.0 * kBlock / kSR, 1e-9);
+    for (int s = 0; s < kBlock; ++s) ASSERT_FLOAT_EQ(y[s], loopSignal(s));
+
+    // Finish the cycle, then overdub a constant over one full pass
+    for (int b = 1; b < 8; ++b) loopBlock(node, n, silence);
+    node.command(LooperCommand::Overdub);
+    for (int b = 0; b < 8; ++b) loopBlock(node, n, [](long long) { return 0.1f; });
+    node.command(LooperCommand::Play);
+
+    auto layered = loopBlock(node, n, silence);
+    for (int s = 0; s < kBlock; ++s) ASSERT_FLOAT_EQ(layered[s], loopSignal(s) + 0.1f);
+
+    for (int b = 1; b < 8; ++b) loopBlock(node, n, silence);
+    node.command(LooperCommand::Undo);
+    y = loopBlock(node, n, silence);
+    for (int s = 0; s < kBlock; ++s) ASSERT_FLOAT_EQ(y[s], loopSignal(s));
+
+    for (int b = 1; b < 8; ++b) loopBlock(node, n, silence);
+    node.command(LooperCommand::Redo);
+    y = loopBlock(node, n, silence);
+    for (int s = 0; s < kBlock; ++s) ASSERT_FLOAT_EQ(y[s], loopSignal(s) + 0.1f);
+}
+
+TEST(Effects, Looper_AllocatesOnFirstRecord) {
+    LooperNode node;
+    node.prepare(kSR, kBlock);
+    EXPECT_EQ(node.allocatedBytes(), 0u);
+
+    node.command(LooperCommand::Record);
+    EXPECT_GT(node.allocatedBytes(), 60.0 * kSR * 2 * sizeof(float));  // default 60 s, stereo
+
+    node.prepare(kSR, kBlock);
+    EXPECT_EQ(node.allocatedBytes(), 0u);
+    EXPECT_EQ(node.state(), LooperState::Empty);
+}
+
+TEST(Effects, Looper_SpillsPastMemoryBudget) {
+    LooperNode node;
+    node.setMemorySeconds(0.1);  // one 4096-frame chunk in RAM
+    node.prepare(kSR, kBlock);
+
+    const int loopBlocks = 40;   // 2.5 chunks
+    long long n = 0;
+    node.command(LooperCommand::Record);
+    for (int b = 0; b < loopBlocks; ++b) {
+        loopBlock(node, n, loopSignal);
+        ASSERT_TRUE(waitForSpill(node));
+    }
+    node.command(LooperCommand::Play);
+
+    std::vector<float> played;
+    for (int b = 0; b < 2 * loopBlocks; ++b) {
+        auto y = loopBlock(node, n, [](long long) { return 0.0f; });
+        if (b >= loopBlocks) played.insert(played.end(), y.begin(), y.end());
+        ASSERT_TRUE(waitForSpill(node));
+    }
+    EXPECT_NEAR(node.lengthSeconds(), loopBlocks * kBlock / kSR, 1e-9);
+    EXPECT_EQ(node.spillUnderruns(), 0);
+    for (size_t i = 0; i < played.size(); ++i)
+        ASSERT_FLOAT_EQ(played[i], loopSignal(static_cast<long long>(i))) << "frame " << i;
+}
+
 // ── VolumeNode (output.volume) ────────────────────────────────────────────────
 
 TEST(Effects, Volume_ZeroDbIsTransparent) {
@@ -529,3 +1133,567 @@ TEST(Effects, Volume_LimiterConstrainsHighGain) {
     float rmsOut = rms(out.getReadPointer(0), kBlock);
     EXPECT_LT(rmsOut, threshold * 1.2f);  // should be well below ungained 2.0
 }
+
+TEST(Effects, Volume_LimiterNeverExceedsThreshold) {
+    auto node = makeNode("output.volume");
+    node->setParam("volume_db",            12.0f);
+    node->setParam("limiter_threshold_db", -1.0f);
+    node->setParam("lookahead_ms",         1.0f);
+    const float threshold = std::pow(10.0f, -1.0f / 20.0f);
+
+    // Bursts of an fs/4 sine at 45 degrees: the samples sit at 0.707 of the
+    // waveform peak, the classic inter-sample overshoot. Each onset after the
+    // silence in between is a fresh transient.
+    AudioBuffer in(kCh, kBlock), out(kCh, kBlock);
+    auto iv = in.view(), ov = out.view();
+    std::vector<float> rendered;
+    for (int b = 0; b < 40; ++b) {
+        for (int s = 0; s < kBlock; ++s) {
+            float sine = std::sin(3.14159265f * (0.5f * s + 0.25f));
+            float v = ((b + s / 64) % 3 == 0) ? sine : 0.0f;
+            in.getWritePointer(0)[s] = v;
+            in.getWritePointer(1)[s] = -v;
+        }
+        node->process(iv, ov, kBlock);
+        for (int c = 0; c < kCh; ++c)
+            for (int s = 0; s < kBlock; ++s)
+                ASSERT_LE(std::abs(out.getReadPointer(c)[s]), threshold);
+        rendered.insert(rendered.end(), out.getReadPointer(0), out.getReadPointer(0) + kBlock);
+    }
+
+    // Inter-sample peaks: 4x band-limited reconstruction stays within 0.2 dB
+    float truePeak = 0.0f;
+    for (size_t n = 8; n + 8 < rendered.size(); ++n) {
+        for (int p = 1; p < 4; ++p) {
+            float t = p / 4.0f, v = 0.0f;
+            for (int k = -8; k < 8; ++k) {
+                float x = static_cast<float>(k + 1) - t;  // distance from sample n+k+1
+                float w = 0.5f + 0.5f * std::cos(3.14159265f * x / 8.0f);
+                v += rendered[n + k + 1] * std::sin(3.14159265f * x) / (3.14159265f * x) * w;
+            }
+            truePeak = std::max(truePeak, std::abs(v));
+        }
+    }
+    EXPECT_LT(truePeak, threshold * 1.023f);
+}
+
+TEST(Effects, Volume_ReportsLookaheadLatency) {
+    auto node = makeNode("output.volume");
+    node->setParam("lookahead_ms", 2.0f);
+    const int latency = node->latencySamples();
+    EXPECT_GE(latency, 96);  // at least the 2 ms lookahead at 48 kHz
+
+    // Below threshold the limiter is a pure delay of exactly that many samples
+    AudioBuffer in = makeSilence(), out(kCh, kBlock);
+    in.getWritePointer(0)[10] = 0.5f;
+    in.getWritePointer(1)[10] = 0.5f;
+    auto iv = in.view(), ov = out.view();
+    node->process(iv, ov, kBlock);
+
+    const float* o = out.getReadPointer(0);
+    for (int s = 0; s < kBlock; ++s)
+        EXPECT_EQ(o[s], s == 10 + latency ? 0.5f : 0.0f) << "sample " << s;
+}
+
+TEST(Effects, Volume_LookaheadChangesDoNotClick) {
+    auto node = makeNode("output.volume");
+
+    // A continuous sine below the threshold; the limiter is a pure delay, so
+    // the output should move no faster than the sine itself, even while the
+    // lookahead (and with it the delay) jumps between blocks.
+    const float amp = 0.3f, w = 2.0f * 3.14159265f * 440.0f / static_cast<float>(kSR);
+    const float lookaheads[] = {0.5f, 5.0f, 1.0f, 3.0f, 0.5f, 2.0f};
+    AudioBuffer in(kCh, kBlock), out(kCh, kBlock);
+    auto iv = in.view(), ov = out.view();
+    std::vector<float> rendered;
+    long long n = 0;
+    for (int b = 0; b < 48; ++b) {
+        if (b % 4 == 3) node->setParam("lookahead_ms", lookaheads[(b / 4) % 6]);
+        for (int s = 0; s < kBlock; ++s, ++n) {
+            float v = amp * std::sin(w * static_cast<float>(n));
+            in.getWritePointer(0)[s] = v;
+            in.getWritePointer(1)[s] = v;
+        }
+        node->process(iv, ov, kBlock);
+        rendered.insert(rendered.end(), out.getReadPointer(0), out.getReadPointer(0) + kBlock);
+    }
+
+    // Largest step of the sine is amp * w; the crossfade between two taps of
+    // it adds at most 2 * amp / kLookaheadFade.
+    const float maxStep = amp * w + 2.0f * amp / LookaheadLimiter::kLookaheadFade;
+    for (size_t i = 1; i < rendered.size(); ++i)
+        ASSERT_LE(std::abs(rendered[i] - rendered[i - 1]), maxStep * 1.05f) << "sample " << i;
+}
+
+TEST(Effects, DirectFir_MatchesConvolutionAcrossBlocks) {
+    DirectFir fir;
+    fir.prepare(512, kBlock);
+
+    std::vector<float> x(6000);
+    for (size_t i = 0; i < x.size(); ++i)
+        x[i] = static_cast<float>(std::sin(0.37 * i) + 0.5 * std::cos(0.011 * i * i));
+    auto kernel = [](int taps) {
+        std::vector<float> h(taps);
+        for (int k = 0; k < taps; ++k) h[k] = std::exp(-0.01f * k) * ((k % 3) - 1.0f);
+        return h;
+    };
+
+    // Block sizes below and above the history length, odd ones too; the
+    // kernel shrinks (exact) and then grows (older history starts silent).
+    const int sizes[] = {256, 1, 17, 255, 64, 3, 200};
+    const int phases[][2] = {{0, 300}, {2000, 40}, {3500, 100}};
+    std::vector<float> h;
+    int pos = 0, phase = 0, changedAt = 0, b = 0;
+    while (pos < static_cast<int>(x.size())) {
+        if (phase < 3 && pos >= phases[phase][0]) {
+            h = kernel(phases[phase][1]);
+            fir.setKernel(h.data(), static_cast<int>(h.size()));
+            changedAt = pos;
+            ++phase;
+        }
+        const int n = std::min(sizes[b++ % 7], static_cast<int>(x.size()) - pos);
+        std::vector<float> y(n);
+        fir.process(x.data() + pos, y.data(), n);
+        for (int i = 0; i < n; ++i) {
+            const int t = pos + i;
+            const int taps = static_cast<int>(h.size());
+            if (t - changedAt < taps - 1 && phase == 3) continue;  // growing: history not kept
+            double ref = 0.0;
+            for (int k = 0; k < taps && k <= t; ++k) ref += h[k] * x[t - k];
+            ASSERT_NEAR(y[i], ref, 1e-4) << "sample " << t;
+        }
+        pos += n;
+    }
+}
+
+// ── Short-IR cab (cab.short_ir) ───────────────────────────────────────────────
+
+TEST(Effects, ShortIRCab_ConvertsToMinimumPhase) {
+    auto node = makeNode("cab.short_ir");
+    node->setParam("taps", 512.0f);
+
+    // Linear-phase-ish IR: a decaying burst that starts 200 samples late.
+    std::vector<float> ir(400, 0.0f);
+    for (int i = 200; i < 400; ++i)
+        ir[i] = std::exp(-(i - 200) / 20.0f) * ((i % 2) ? -0.5f : 1.0f);
+    node->loadData({{"ir", ir}, {"ir_sample_rate", kSR}});
+
+    AudioBuffer impulse(kCh, kBlock), out(kCh, kBlock);
+    impulse.getWritePointer(0)[0] = 1.0f;
+    impulse.getWritePointer(1)[0] = 1.0f;
+    auto iv = impulse.view(), ov = out.view();
+    node->process(iv, ov, kBlock);
+
+    // Minimum phase moves the energy to the front: most of it in the first 64 taps.
+    const float* o = out.getReadPointer(0);
+    float head = 0.0f, total = 0.0f;
+    for (int s = 0; s < kBlock; ++s) {
+        total += o[s] * o[s];
+        if (s < 64) head += o[s] * o[s];
+    }
+    ASSERT_GT(total, 0.0f);
+    EXPECT_GT(head / total, 0.95f);
+}
+
+TEST(Effects, ShortIRCab_TapBudgetTruncatesResponse) {
+    auto node = makeNode("cab.short_ir");
+    node->setParam("taps", 64.0f);
+
+    AudioBuffer impulse(kCh, kBlock), out(kCh, kBlock);
+    impulse.getWritePointer(0)[0] = 1.0f;
+    impulse.getWritePointer(1)[0] = 1.0f;
+    auto iv = impulse.view(), ov = out.view();
+    node->process(iv, ov, kBlock);
+
+    const float* o = out.getReadPointer(0);
+    EXPECT_GT(std::abs(o[0]) + std::abs(o[1]) + std::abs(o[2]), 0.0f);
+    for (int s = 64; s < kBlock; ++s)
+        EXPECT_EQ(o[s], 0.0f) << "tap " << s << " beyond budget";
+}
+
+TEST(Effects, ShortIRCab_StereoMatchesDualMono) {
+    auto node = makeNode("cab.short_ir");
+
+    AudioBuffer in = makeTone(440.0f, 0.5f), out(kCh, kBlock);
+    in.getWritePointer(1)[10] += 0.25f;  // make the channels differ
+    auto iv = in.view(), ov = out.view();
+    node->process(iv, ov, kBlock);
+
+    auto ref = makeNode("cab.short_ir");
+    AudioBuffer mono = makeTone(440.0f, 0.5f), refOut(kCh, kBlock);
+    auto mv = mono.view(), rv = refOut.view();
+    ref->process(mv, rv, kBlock);
+
+    for (int s = 0; s < kBlock; ++s)
+        EXPECT_FLOAT_EQ(out.getReadPointer(0)[s], refOut.getReadPointer(0)[s]);
+}
+
+TEST(Effects, ShortIRCab_KernelChangesWhileProcessing) {
+    auto node = makeNode("cab.short_ir");
+    std::vector<float> ir(300);
+    for (int i = 0; i < 300; ++i) ir[i] = std::exp(-i / 30.0f) * ((i % 3) ? 0.3f : -0.6f);
+
+    // GUI / loader thread: rebuild and publish kernels while audio runs.
+    std::atomic<bool> done{false};
+    std::thread gui([&] {
+        for (int i = 0; i < 200 && !done; ++i) {
+            node->setParam("taps", (i % 2) ? 1024.0f : 48.0f);
+            node->setParam("level_db", static_cast<float>(i % 7) - 3.0f);
+            if (i % 25 == 0) node->loadData({{"ir", ir}, {"ir_sample_rate", kSR}});
+        }
+        done = true;
+    });
+
+    AudioBuffer in = makeTone(220.0f, 0.5f), out(kCh, kBlock);
+    auto iv = in.view(), ov = out.view();
+    while (!done) {
+        node->process(iv, ov, kBlock);
+        for (int s = 0; s < kBlock; ++s)
+            ASSERT_TRUE(std::isfinite(out.getReadPointer(0)[s]));
+    }
+    gui.join();
+
+    // The last published kernel is the one in use.
+    node->setParam("taps", 64.0f);
+    AudioBuffer impulse(kCh, kBlock);
+    impulse.getWritePointer(0)[0] = impulse.getWritePointer(1)[0] = 1.0f;
+    for (int i = 0; i < 8; ++i) {  // flush the tone out of the history
+        AudioBuffer silence = makeSilence();
+        node->process(silence.view(), ov, kBlock);
+    }
+    node->process(impulse.view(), ov, kBlock);
+    for (int s = 64; s < kBlock; ++s)
+        EXPECT_EQ(out.getReadPointer(0)[s], 0.0f) << "tap " << s;
+}
+
+// ── Oversampling wrapper ──────────────────────────────────────────────────────
+
+// Drives 'node' with a 7 kHz sine and returns (fundamental, 13 kHz alias of the 5th harmonic).
+static std::pair<double, double> measureAlias(EffectNode& node) {
+    const int numBlocks = 40, keep = 16;
+    std::vector<float> captured;
+    AudioBuffer in(kCh, kBlock), out(kCh, kBlock);
+    for (int b = 0; b < numBlocks; ++b) {
+        for (int c = 0; c < kCh; ++c)
+            for (int s = 0; s < kBlock; ++s)
+                in.getWritePointer(c)[s] = 0.8f * static_cast<float>(
+                    std::sin(2.0 * 3.141592653589793 * 7000.0 * (b * kBlock + s) / kSR));
+        auto iv = in.view(), ov = out.view();
+        node.process(iv, ov, kBlock);
+        if (b >= numBlocks - keep)
+            captured.insert(captured.end(), out.getReadPointer(0), out.getReadPointer(0) + kBlock);
+    }
+    return { toneMagnitude(captured, 7000.0), toneMagnitude(captured, 13000.0) };
+}
+
+TEST(Effects, Oversampled_MirrorsInnerNode) {
+    auto inner = makeNode("gain.distortion");
+    inner->setParam("gain", 0.9f);
+    OversampledNode os(inner, 4);
+
+    EXPECT_EQ(os.typeId(), "gain.distortion");
+    EXPECT_EQ(os.factor(), 4);
+    EXPECT_FLOAT_EQ(os.getParam("gain"), 0.9f);
+
+    os.setParam("tone", 0.2f);
+    EXPECT_FLOAT_EQ(inner->getParam("tone"), 0.2f);
+}
+
+TEST(Effects, Oversampled_ForwardsGainReduction) {
+    auto inner = makeNode("dynamics.compressor");
+    inner->setParam("threshold_db", -20.0f);
+    inner->setParam("ratio", 10.0f);
+    OversampledNode os(inner, 2);
+    os.prepare(kSR, kBlock);
+
+    AudioBuffer in = makeTone(440.0f, 0.5f), out(kCh, kBlock);
+    auto iv = in.view(), ov = out.view();
+    for (int i = 0; i < 20; ++i) os.process(iv, ov, kBlock);
+
+    EXPECT_LT(os.gainReductionDb(), -5.0f);
+    EXPECT_FLOAT_EQ(os.gainReductionDb(), inner->gainReductionDb());
+}
+
+TEST(Effects, Oversampled_LinearNodeIsDelayedPassthrough) {
+    for (int factor : {2, 4, 8}) {
+        OversampledNode os(makeNode("gain.clean_boost"), factor);
+        os.prepare(kSR, kBlock);
+        int lat = os.latencySamples();
+        EXPECT_GT(lat, 0);
+
+        // 500 Hz sits well inside the half-band passband: output = input delayed by
+        // exactly the latency, at every factor.
+        AudioBuffer in(kCh, kBlock), out(kCh, kBlock);
+        float err = 0.0f;
+        for (int b = 0; b < 4; ++b) {
+            for (int c = 0; c < kCh; ++c)
+                for (int s = 0; s < kBlock; ++s)
+                    in.getWritePointer(c)[s] =
+                        0.5f * std::sin(2.0f * 3.14159f * 500.0f * (b * kBlock + s) / (float)kSR);
+            auto iv = in.view(), ov = out.view();
+            os.process(iv, ov, kBlock);
+            if (b == 0) continue;
+
+            const float* o = out.getReadPointer(0);
+            for (int s = 0; s < kBlock; ++s) {
+                float ref = 0.5f * std::sin(2.0f * 3.14159f * 500.0f * (b * kBlock + s - lat) / (float)kSR);
+                err = std::max(err, std::abs(o[s] - ref));
+            }
+        }
+        EXPECT_LT(err, 1e-4f) << "factor " << factor;
+    }
+}
+
+TEST(Effects, Oversampled_ReducesAliasing) {
+    auto plain = makeNode("gain.distortion");
+    plain->setParam("gain", 1.0f);
+    plain->setParam("tone", 1.0f);
+
+    auto inner = makeNode("gain.distortion");
+    inner->setParam("gain", 1.0f);
+    inner->setParam("tone", 1.0f);
+    OversampledNode os(inner, 4);
+    os.prepare(kSR, kBlock);
+
+    auto [fundPlain, aliasPlain] = measureAlias(*plain);
+    auto [fundOs,    aliasOs]    = measureAlias(os);
+
+    ASSERT_GT(fundPlain, 0.0);
+    ASSERT_GT(fundOs, 0.0);
+    // At least 20 dB less alias energy relative to the fundamental.
+    EXPECT_LT(aliasOs / fundOs, 0.1 * aliasPlain / fundPlain);
+}
+
+// ── Antiderivative anti-aliasing ─────────────────────────────────────────────
+
+template <typename Shaper>
+static void expectConsistentAntiderivatives(const Shaper& sh) {
+    const double h = 1e-4;
+    for (double x = -3.0; x <= 3.0; x += 0.37) {
+        EXPECT_NEAR((sh.F1(x + h) - sh.F1(x - h)) / (2 * h), sh.f(x),  1e-6) << "x=" << x;
+        EXPECT_NEAR((sh.F2(x + h) - sh.F2(x - h)) / (2 * h), sh.F1(x), 1e-6) << "x=" << x;
+    }
+}
+
+TEST(Effects, Adaa_AntiderivativesAreConsistent) {
+    expectConsistentAntiderivatives(AtanShaper{});
+    AsymClipShaper clip;
+    clip.pos = 0.6;
+    clip.neg = 0.9;
+    expectConsistentAntiderivatives(clip);
+}
+
+// The float segment averages against the double antiderivatives, including
+// close and equal ends where the plain difference quotient cancels.
+template <typename Shaper>
+static void expectMeansMatchReference(const Shaper& sh) {
+    for (double b = -4.0; b <= 4.0; b += 0.29) {
+        for (double d : {0.0, 1e-4, -3e-3, 0.05, -0.4, 2.5}) {
+            const double a  = b + d;
+            const float  fa = static_cast<float>(a), fb = static_cast<float>(b);
+            const double ad = fa, bd = fb;  // the inputs the float path sees
+            const double m0 = (fa == fb) ? sh.f(ad)  : (sh.F1(ad) - sh.F1(bd)) / (ad - bd);
+            const double m1 = (fa == fb) ? sh.F1(ad) : (sh.F2(ad) - sh.F2(bd)) / (ad - bd);
+            const AdaaPoint pa = sh.point(fa), pb = sh.point(fb);
+            EXPECT_NEAR(sh.mean0(pa, pb), m0, 1e-6) << "a=" << a << " b=" << b;
+            EXPECT_NEAR(sh.mean1(pa, pb), m1, 1e-6 * std::max(1.0, std::abs(m1))) << "a=" << a << " b=" << b;
+        }
+    }
+}
+
+TEST(Effects, Adaa_FloatMeansMatchReference) {
+    expectMeansMatchReference(AtanShaper{});
+    AsymClipShaper clip;
+    clip.pos = 0.6;
+    clip.neg = 0.9;
+    expectMeansMatchReference(clip);
+}
+
+TEST(Effects, Adaa_ConstantInputUsesFallback) {
+    AtanShaper sh;
+    for (int order : {1, 2}) {
+        Adaa adaa;
+        adaa.prepare(kBlock);
+        std::vector<float> buf(kBlock, 0.75f);
+        adaa.process(buf.data(), kBlock, order, sh);  // first samples see the zero history
+        std::fill(buf.begin(), buf.end(), 0.75f);
+        adaa.process(buf.data(), kBlock, order, sh);
+        for (float v : buf)
+            EXPECT_NEAR(v, sh.f(0.75), 1e-6) << "order " << order;
+    }
+}
+
+static double aliasRatio(EffectNode& node) {
+    auto [fund, alias] = measureAlias(node);
+    EXPECT_GT(fund, 0.0);
+    return alias / fund;
+}
+
+TEST(Effects, Overdrive_AdaaReducesAliasing) {
+    auto plain = makeNode("gain.overdrive");
+    plain->setParam("gain", 1.0f);
+    plain->setParam("tone", 1.0f);
+    double ref = aliasRatio(*plain);
+
+    for (int order : {1, 2}) {
+        auto node = makeNode("gain.overdrive");
+        node->setParam("gain", 1.0f);
+        node->setParam("tone", 1.0f);
+        node->setParam("antialias", static_cast<float>(order));
+        EXPECT_EQ(node->latencySamples(), order == 2 ? 1 : 0);
+        EXPECT_LT(aliasRatio(*node), 0.5 * ref) << "order " << order;
+    }
+}
+
+TEST(Effects, Distortion_AdaaReducesAliasing) {
+    auto plain = makeNode("gain.distortion");
+    plain->setParam("gain", 1.0f);
+    plain->setParam("tone", 1.0f);
+    double ref = aliasRatio(*plain);
+
+    for (int order : {1, 2}) {
+        auto node = makeNode("gain.distortion");
+        node->setParam("gain", 1.0f);
+        node->setParam("tone", 1.0f);
+        node->setParam("antialias", static_cast<float>(order));
+        EXPECT_LT(aliasRatio(*node), 0.5 * ref) << "order " << order;
+    }
+}
+
+// ── Neural amp (amp.neural) ───────────────────────────────────────────────────
+
+// Small deterministic model in PyTorch layout: weight rows of [gates*H][...].
+static nlohmann::json makeRnnModel(const std::string& type, int H) {
+    const int G = (type == "lstm") ? 4 : 3;
+    auto w = [](int i) { return 0.4f * std::sin(1.7f * i + 0.3f); };
+
+    nlohmann::json wih = nlohmann::json::array(), whh = nlohmann::json::array();
+    std::vector<float> bih, bhh, dense;
+    for (int r = 0; r < G * H; ++r) {
+        wih.push_back({ w(r) * 2.0f });
+        std::vector<float> row;
+        for (int k = 0; k < H; ++k) row.push_back(w(100 + r * H + k));
+        whh.push_back(row);
+        bih.push_back(w(500 + r) * 0.5f);
+        bhh.push_back(w(700 + r) * 0.5f);
+    }
+    for (int k = 0; k < H; ++k) dense.push_back(w(900 + k));
+
+    return {{"type", type}, {"hidden_size", H},
+            {"weight_ih", wih}, {"weight_hh", whh},
+            {"bias_ih", bih}, {"bias_hh", bhh},
+            {"dense_weight", dense}, {"dense_bias", 0.05f}, {"skip", true}};
+}
+
+// Straightforward per-sample reference of the PyTorch cell equations.
+static std::vector<float> referenceRnn(const nlohmann::json& m, const std::vector<float>& x) {
+    const bool lstm = m["type"] == "lstm";
+    const int  H    = m["hidden_size"];
+    auto sig = [](double v) { return 1.0 / (1.0 + std::exp(-v)); };
+
+    std::vector<double> h(H, 0.0), c(H, 0.0), gi, gh;
+    std::vector<float> y;
+    for (float xs : x) {
+        const int G = lstm ? 4 : 3;
+        gi.assign(G * H, 0.0); gh.assign(G * H, 0.0);
+        for (int r = 0; r < G * H; ++r) {
+            gi[r] = m["weight_ih"][r][0].get<double>() * xs + m["bias_ih"][r].get<double>();
+            gh[r] = m["bias_hh"][r].get<double>();
+            for (int k = 0; k < H; ++k) gh[r] += m["weight_hh"][r][k].get<double>() * h[k];
+        }
+        std::vector<double> hn(H);
+        for (int k = 0; k < H; ++k) {
+            if (lstm) {
+                double i = sig(gi[k] + gh[k]),         f = sig(gi[H + k] + gh[H + k]);
+                double g = std::tanh(gi[2*H + k] + gh[2*H + k]), o = sig(gi[3*H + k] + gh[3*H + k]);
+                c[k]  = f * c[k] + i * g;
+                hn[k] = o * std::tanh(c[k]);
+            } else {
+                double r = sig(gi[k] + gh[k]), z = sig(gi[H + k] + gh[H + k]);
+                double n = std::tanh(gi[2*H + k] + r * gh[2*H + k]);
+                hn[k] = (1.0 - z) * n + z * h[k];
+            }
+        }
+        h = hn;
+        double out = m["dense_bias"].get<double>() + xs;
+        for (int k = 0; k < H; ++k) out += m["dense_weight"][k].get<double>() * h[k];
+        y.push_back(static_cast<float>(out));
+    }
+    return y;
+}
+
+TEST(Effects, NeuralAmp_PassthroughWithoutModel) {
+    auto node = makeNode("amp.neural");
+    AudioBuffer in = makeTone(440.0f), out(kCh, kBlock);
+    auto iv = in.view(), ov = out.view();
+    node->process(iv, ov, kBlock);
+    for (int s = 0; s < kBlock; ++s)
+        EXPECT_FLOAT_EQ(out.getReadPointer(0)[s], in.getReadPointer(0)[s]);
+}
+
+TEST(Effects, NeuralAmp_MatchesReferenceCells) {
+    for (const char* type : {"lstm", "gru"}) {
+        auto model = makeRnnModel(type, 11);  // odd size exercises the lane padding
+        auto node  = std::dynamic_pointer_cast<NeuralAmpNode>(makeNode("amp.neural"));
+        node->loadData({{"model", model}});
+        ASSERT_TRUE(node->hasModel()) << node->modelError();
+
+        AudioBuffer in = makeTone(220.0f, 0.8f), out(kCh, kBlock);
+        auto iv = in.view(), ov = out.view();
+        node->process(iv, ov, kBlock);
+
+        std::vector<float> x(in.getReadPointer(0), in.getReadPointer(0) + kBlock);
+        auto ref = referenceRnn(model, x);
+        for (int s = 0; s < kBlock; ++s) {
+            EXPECT_NEAR(out.getReadPointer(0)[s], ref[s], 1e-4f) << type << " sample " << s;
+            EXPECT_FLOAT_EQ(out.getReadPointer(1)[s], out.getReadPointer(0)[s]);
+        }
+
+        auto saved = node->saveData();
+        EXPECT_EQ(saved["model"]["hidden_size"], 11);
+    }
+}
+
+TEST(Effects, NeuralAmp_RejectsMalformedModel) {
+    auto node  = std::dynamic_pointer_cast<NeuralAmpNode>(makeNode("amp.neural"));
+    auto model = makeRnnModel("lstm", 4);
+    model["weight_hh"].erase(0);
+    EXPECT_FALSE(node->loadModel(model));
+    EXPECT_FALSE(node->hasModel());
+    EXPECT_FALSE(node->modelError().empty());
+}
+
+TEST(Effects, NeuralAmp_ModelSwapsWhileProcessing) {
+    auto node = std::dynamic_pointer_cast<NeuralAmpNode>(makeNode("amp.neural"));
+    auto lstm = makeRnnModel("lstm", 16), gru = makeRnnModel("gru", 5);
+
+    // Loader / GUI thread: swap models while audio runs.
+    std::atomic<bool> done{false};
+    std::thread loader([&] {
+        for (int i = 0; i < 100 && !done; ++i)
+            node->loadModel((i % 2) ? lstm : gru);
+        done = true;
+    });
+
+    AudioBuffer in = makeTone(220.0f, 0.8f), out(kCh, kBlock);
+    auto iv = in.view(), ov = out.view();
+    while (!done) {
+        node->process(iv, ov, kBlock);
+        for (int s = 0; s < kBlock; ++s)
+            ASSERT_TRUE(std::isfinite(out.getReadPointer(0)[s]));
+    }
+    loader.join();
+
+    // A failed load keeps the current model; the last good one is adopted
+    // with zero state on the next block.
+    auto broken = lstm;
+    broken["weight_hh"].erase(0);
+    EXPECT_FALSE(node->loadModel(broken));
+    EXPECT_TRUE(node->hasModel());
+
+    node->process(iv, ov, kBlock);
+    std::vector<float> x(in.getReadPointer(0), in.getReadPointer(0) + kBlock);
+    auto ref = referenceRnn(lstm, x);
+    for (int s = 0; s < kBlock; ++s)
+        EXPECT_NEAR(out.getReadPointer(0)[s], ref[s], 1e-4f) << "sample " << s;
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "dsp/FastMath.h"
+#include <cmath>
+#include <functional>
+
+using namespace gearboxfx;
+
+enum class Err { Abs, Rel, Mixed };  // Mixed: abs / max(1, |ref|)
+
+// Largest error of approx(x) against the double-precision reference over [lo, hi].
+static double maxError(const std::function<float(float)>&   approx,
+                       const std::function<double(double)>& ref,
+                       double lo, double hi, Err kind = Err::Abs, int steps = 200000)
+{
+    double worst = 0.0;
+    for (int i = 0; i <= steps; ++i) {
+        float  x = static_cast<float>(lo + (hi - lo) * i / steps);
+        double r = ref(static_cast<double>(x));
+        double e = std::abs(static_cast<double>(approx(x)) - r);
+        if (kind == Err::Rel) {
+            if (std::abs(r) < 1e-30) continue;
+            e /= std::abs(r);
+        } else if (kind == Err::Mixed) {
+            e /= std::max(1.0, std::abs(r));
+        }
+        worst = std::max(worst, e);
+    }
+    return worst;
+}
+
+static constexpr double kPiD = 3.14159265358979323846;
+
+TEST(FastMath, Sin2PiCos2Pi) {
+    EXPECT_LT(maxError(fastmath::sin2pi, [](double p) { return std::sin(2 * kPiD * p); }, -1.0, 1.0), 3e-7);
+    EXPECT_LT(maxError(fastmath::cos2pi, [](double p) { return std::cos(2 * kPiD * p); }, -1.0, 1.0), 3e-7);
+    EXPECT_EQ(fastmath::sin2pi(0.0f), 0.0f);
+}
+
+TEST(FastMath, SinCos) {
+    EXPECT_LT(maxError(fastmath::sin, [](double x) { return std::sin(x); }, -2 * kPiD, 2 * kPiD), 1e-6);
+    EXPECT_LT(maxError(fastmath::cos, [](double x) { return std::cos(x); }, -2 * kPiD, 2 * kPiD), 1e-6);
+}
+
+TEST(FastMath, Tan) {
+    EXPECT_LT(maxError(fastmath::tan, [](double x) { return std::tan(x); },
+                       -0.49 * kPiD, 0.49 * kPiD, Err::Rel), 1e-5);
+    EXPECT_LT(maxError(fastmath::tan, [](double x) { return std::tan(x); },
+                       -0.25 * kPiD, 0.25 * kPiD, Err::Rel), 1e-6);
+}
+
+TEST(FastMath, Atan) {
+    EXPECT_LT(maxError(fastmath::atan, [](double x) { return std::atan(x); }, -50.0, 50.0), 2e-7);
+    EXPECT_NEAR(fastmath::atan(1e30f), kPiD / 2, 2e-7);
+    EXPECT_NEAR(fastmath::atan(-1e30f), -kPiD / 2, 2e-7);
+}
+
+TEST(FastMath, Atan2) {
+    double worst = 0.0;
+    for (int i = 0; i < 100000; ++i) {
+        double a = 2 * kPiD * i / 100000 - kPiD;
+        for (float r : { 1e-3f, 1.0f, 250.0f }) {
+            float x = static_cast<float>(r * std::cos(a)), y = static_cast<float>(r * std::sin(a));
+            worst = std::max(worst, std::abs(fastmath::atan2(y, x) - std::atan2((double)y, (double)x)));
+        }
+    }
+    EXPECT_LT(worst, 3e-7);
+    EXPECT_EQ(fastmath::atan2(0.0f, 0.0f), 0.0f);
+    EXPECT_NEAR(fastmath::atan2(0.0f, -1.0f), kPiD, 3e-7);
+}
+
+TEST(FastMath, Exp2Log2) {
+    EXPECT_LT(maxError(fastmath::exp2, [](double x) { return std::exp2(x); }, -126.0, 126.0, Err::Rel), 3e-7);
+    EXPECT_LT(maxError(fastmath::log2, [](double x) { return std::log2(x); }, 1e-30, 1e-20, Err::Mixed), 3e-7);
+    EXPECT_LT(maxError(fastmath::log2, [](double x) { return std::log2(x); }, 1e-6, 1e6, Err::Mixed), 3e-7);
+    EXPECT_LT(maxError(fastmath::log2, [](double x) { return std::log2(x); }, 0.5, 2.0, Err::Mixed), 3e-7);
+    EXPECT_EQ(fastmath::log2(1.0f), 0.0f);
+    EXPECT_EQ(fastmath::exp2(0.0f), 1.0f);
+}
+
+TEST(FastMath, Tanh) {
+    EXPECT_LT(maxError(fastmath::tanh, [](double x) { return std::tanh(x); }, -20.0, 20.0), 5e-7);
+    EXPECT_LT(maxError(fastmath::sigmoid, [](double x) { return 1.0 / (1.0 + std::exp(-x)); },
+                       -30.0, 30.0), 5e-7);
+}
+
+TEST(FastMath, DecibelConversion) {
+    EXPECT_LT(maxError(fastmath::dbToLinear, [](double db) { return std::pow(10.0, db / 20.0); },
+                       -120.0, 40.0, Err::Rel), 1e-6);
+    EXPECT_LT(maxError(fastmath::linearToDb, [](double g) { return 20.0 * std::log10(g); },
+                       1e-6, 100.0), 1e-5);
+}
+
+TEST(FastMath, BlockVariantsMatchScalar) {
+    float in[37], out[37];
+    for (int i = 0; i < 37; ++i) in[i] = -3.0f + 0.17f * i;
+
+    fastmath::tanhBlock(in, out, 37);
+    for (int i = 0; i < 37; ++i) EXPECT_EQ(out[i], fastmath::tanh(in[i]));
+
+    fastmath::sin2piBlock(in, out, 37);
+    for (int i = 0; i < 37; ++i) EXPECT_EQ(out[i], fastmath::sin2pi(in[i]));
+}
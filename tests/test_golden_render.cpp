@@ -0,0 +1,306 @@
+#include <gtest/gtest.h>
+#include "EffectEngine.h"
+#include "AudioBuffer.h"
+#include "GoldenDiff.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Golden-render regression (gearboxfx_golden_tests): every preset is rendered
+// over each fixed input and compared with tests/golden/<preset>__<input>.f32.
+//
+//   GEARBOX_GOLDEN_MODE=tolerance   (default) max abs error and SNR limits
+//   GEARBOX_GOLDEN_MODE=exact       every sample bit-identical
+//   GEARBOX_GOLDEN_MAX_ABS=<x>      tolerance limit, default 1e-3
+//   GEARBOX_GOLDEN_MIN_SNR=<dB>     tolerance limit, default 60
+//   GEARBOX_GOLDEN_RECORD=1         write the renders as the new goldens
+//   GEARBOX_GOLDEN_DIR=<dir>        read/write goldens elsewhere
+//
+// The committed goldens come from one compiler and libm, so other toolchains
+// are only expected to match within tolerance (FMA contraction alone costs the
+// octave tracker ~80 dB SNR; a real behaviour change lands well below 60). For a refactor that must not
+// change output, record into a scratch directory before the change and run
+// exact mode against it after.
+
+using namespace gearboxfx;
+
+static constexpr double kSR     = 48000.0;
+static constexpr int    kBlock  = 256;
+static constexpr int    kFrames = 16384;  // ~0.34 s
+
+// ── Inputs ───────────────────────────────────────────────────────────────────
+
+// Plucked guitar notes (Karplus-Strong), the same signal on both channels.
+static void makePluck(AudioBuffer& buf) {
+    static const double kNotes[] = { 82.41, 196.00, 329.63, 110.00 };
+    std::uint32_t seed = 12345;
+    std::vector<float> line;
+    float* L = buf.getWritePointer(0);
+    size_t pos = 0;
+    for (int i = 0; i < kFrames; ++i) {
+        if (i % (kFrames / 4) == 0) {
+            line.assign(static_cast<size_t>(kSR / kNotes[i / (kFrames / 4)]), 0.0f);
+            for (auto& v : line) {
+                seed = seed * 1664525u + 1013904223u;
+                v = 0.6f * (static_cast<float>(seed >> 8) / 8388608.0f - 1.0f);
+            }
+            pos = 0;
+        }
+        size_t next = (pos + 1) % line.size();
+        float y = line[pos];
+        line[pos] = 0.996f * 0.5f * (line[pos] + line[next]);
+        pos = next;
+        L[i] = y;
+    }
+    std::memcpy(buf.getWritePointer(1), L, kFrames * sizeof(float));
+}
+
+// Different left and right: an exponential sine sweep on the left, noise
+// bursts and clicks on the right; the last 2048 frames are silent on both
+// so tails and their decay to zero are covered.
+static void makeStereoSweep(AudioBuffer& buf) {
+    float* L = buf.getWritePointer(0);
+    float* R = buf.getWritePointer(1);
+    const int active = kFrames - 2048;
+    const double f0 = 50.0, f1 = 10000.0, T = active / kSR, k = std::log(f1 / f0);
+    std::uint32_t seed = 777;
+    for (int i = 0; i < kFrames; ++i) {
+        if (i >= active) { L[i] = R[i] = 0.0f; continue; }
+        double t = i / kSR;
+        L[i] = static_cast<float>(0.5 * std::sin(2.0 * 3.141592653589793 * f0 * T / k * (std::exp(t / T * k) - 1.0)));
+
+        seed = seed * 1664525u + 1013904223u;
+        float noise = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+        int   phase = i % 4096;
+        R[i] = 0.8f * noise * std::exp(-static_cast<float>(phase) / 300.0f);
+        if (i % 2048 == 1024) R[i] = 0.9f;
+    }
+}
+
+struct GoldenInput {
+    const char* name;
+    void (*make)(AudioBuffer&);
+};
+
+static const GoldenInput kInputs[] = {
+    { "pluck",  makePluck },
+    { "stereo", makeStereoSweep },
+};
+
+// ── Golden files ─────────────────────────────────────────────────────────────
+// "GBXGOLD1", then uint32 sample rate, channels, stored channels, frames, then
+// stored channels × frames float32, planar, host byte order (little-endian on
+// every supported target). A render whose channels are all identical stores
+// one channel.
+
+struct Golden {
+    uint32_t sampleRate = 0, channels = 0, frames = 0;
+    std::vector<std::vector<float>> data;  // one per channel
+};
+
+static const char kMagic[8] = { 'G', 'B', 'X', 'G', 'O', 'L', 'D', '1' };
+
+static bool readGolden(const std::filesystem::path& path, Golden& g) {
+    std::ifstream f(path, std::ios::binary);
+    char magic[8];
+    uint32_t hdr[4];
+    if (!f.read(magic, 8) || std::memcmp(magic, kMagic, 8) != 0) return false;
+    if (!f.read(reinterpret_cast<char*>(hdr), sizeof(hdr))) return false;
+    g.sampleRate = hdr[0];
+    g.channels   = hdr[1];
+    g.frames     = hdr[3];
+    if (hdr[2] == 0 || hdr[2] > g.channels) return false;
+    g.data.assign(g.channels, std::vector<float>(g.frames));
+    for (uint32_t c = 0; c < hdr[2]; ++c)
+        if (!f.read(reinterpret_cast<char*>(g.data[c].data()), g.frames * sizeof(float))) return false;
+    for (uint32_t c = hdr[2]; c < g.channels; ++c)
+        g.data[c] = g.data[0];
+    return true;
+}
+
+static bool writeGolden(const std::filesystem::path& path, const AudioBuffer& buf) {
+    const int numCh = buf.numChannels();
+    bool same = true;
+    for (int c = 1; c < numCh && same; ++c)
+        same = std::memcmp(buf.getReadPointer(0), buf.getReadPointer(c), kFrames * sizeof(float)) == 0;
+    const uint32_t stored = same ? 1u : static_cast<uint32_t>(numCh);
+    const uint32_t hdr[4] = { static_cast<uint32_t>(kSR), static_cast<uint32_t>(numCh), stored,
+                              static_cast<uint32_t>(kFrames) };
+
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f.write(kMagic, 8);
+    f.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+    for (uint32_t c = 0; c < stored; ++c)
+        f.write(reinterpret_cast<const char*>(buf.getReadPointer(static_cast<int>(c))), kFrames * sizeof(float));
+    return static_cast<bool>(f);
+}
+
+// ── Configuration ────────────────────────────────────────────────────────────
+
+static std::string envOr(const char* name, const char* fallback) {
+    const char* v = std::getenv(name);
+    return (v && *v) ? v : fallback;
+}
+
+static std::filesystem::path goldenDir() { return envOr("GEARBOX_GOLDEN_DIR", GEARBOX_GOLDEN_DIR); }
+static bool   recordMode()   { return envOr("GEARBOX_GOLDEN_RECORD", "0") != "0"; }
+static bool   exactMode()    { return envOr("GEARBOX_GOLDEN_MODE", "tolerance") == "exact"; }
+static double maxAbsLimit()  { return std::atof(envOr("GEARBOX_GOLDEN_MAX_ABS", "1e-3").c_str()); }
+static double minSnrLimit()  { return std::atof(envOr("GEARBOX_GOLDEN_MIN_SNR", "60").c_str()); }
+
+// ── Render ───────────────────────────────────────────────────────────────────
+
+static void render(EffectEngine& engine, const AudioBuffer& input, AudioBuffer& output) {
+    AudioBuffer in(2, kBlock), out(2, kBlock);
+    for (int pos = 0; pos < kFrames; pos += kBlock) {
+        const int n = std::min(kBlock, kFrames - pos);
+        for (int c = 0; c < 2; ++c)
+            std::memcpy(in.getWritePointer(c), input.getReadPointer(c) + pos, n * sizeof(float));
+        auto inView  = in.view();
+        auto outView = out.view();
+        inView.numSamples = outView.numSamples = n;
+        engine.processBlock(inView, outView, n);
+        for (int c = 0; c < 2; ++c)
+            std::memcpy(output.getWritePointer(c) + pos, out.getReadPointer(c), n * sizeof(float));
+    }
+}
+
+// ── Diff self-tests ──────────────────────────────────────────────────────────
+
+TEST(GoldenDiff, IdenticalIsExact) {
+    std::vector<float> a(1000);
+    for (size_t i = 0; i < a.size(); ++i) a[i] = std::sin(0.01f * i);
+    auto st = golden::diff(a.data(), a.data(), a.size());
+    EXPECT_TRUE(st.exact());
+    EXPECT_EQ(st.maxAbsError, 0.0);
+    EXPECT_TRUE(std::isinf(st.snrDb()) && st.snrDb() > 0);
+}
+
+TEST(GoldenDiff, ReportsFirstDivergenceMaxErrorAndSnr) {
+    std::vector<float> ref(1003), test;
+    for (size_t i = 0; i < ref.size(); ++i) ref[i] = 0.5f * std::sin(0.05f * i);
+    test = ref;
+    test[300] += 1e-3f;
+    test[777] += 0.25f;
+    test[1001] = -0.0f;
+    ref[1001]  = 0.0f;
+
+    auto st = golden::diff(ref.data(), test.data(), ref.size());
+    EXPECT_EQ(st.firstDiff, 300);
+    EXPECT_EQ(st.maxAbsIndex, 777u);
+    EXPECT_NEAR(st.maxAbsError, 0.25, 1e-6);
+
+    double sig = 0.0;
+    for (float v : ref) sig += static_cast<double>(v) * v;
+    EXPECT_NEAR(st.snrDb(), 10.0 * std::log10(sig / (0.25 * 0.25 + 1e-6)), 0.01);
+
+    // Only the sign of zero differs: not bit-exact, but no error.
+    std::vector<float> z(8, 0.0f), nz(8, 0.0f);
+    nz[5] = -0.0f;
+    auto sz = golden::diff(z.data(), nz.data(), z.size());
+    EXPECT_EQ(sz.firstDiff, 5);
+    EXPECT_EQ(sz.maxAbsError, 0.0);
+}
+
+TEST(GoldenDiff, NanIsInfiniteError) {
+    std::vector<float> ref(64, 0.1f), test(64, 0.1f);
+    test[40] = std::nanf("");
+    auto st = golden::diff(ref.data(), test.data(), ref.size());
+    EXPECT_EQ(st.firstDiff, 40);
+    EXPECT_EQ(st.maxAbsIndex, 40u);
+    EXPECT_TRUE(std::isinf(st.maxAbsError));
+}
+
+// ── Preset renders ───────────────────────────────────────────────────────────
+
+struct GoldenCase {
+    std::filesystem::path preset;
+    int                   input;
+    std::string           name;  // <preset>__<input>
+};
+
+static void PrintTo(const GoldenCase& gc, std::ostream* os) { *os << gc.name; }
+
+static std::vector<GoldenCase> goldenCases() {
+    std::vector<std::filesystem::path> presets;
+    for (const auto& entry : std::filesystem::directory_iterator(GEARBOX_GOLDEN_PRESET_DIR))
+        if (entry.path().extension() == ".json") presets.push_back(entry.path());
+    std::sort(presets.begin(), presets.end());
+
+    std::vector<GoldenCase> cases;
+    for (const auto& p : presets) {
+        for (int i = 0; i < static_cast<int>(std::size(kInputs)); ++i) {
+            std::string name = p.stem().string() + "__" + kInputs[i].name;
+            for (char& ch : name)
+                if (!std::isalnum(static_cast<unsigned char>(ch))) ch = '_';
+            cases.push_back({ p, i, name });
+        }
+    }
+    return cases;
+}
+
+class GoldenRender : public ::testing::TestWithParam<GoldenCase> {};
+
+TEST_P(GoldenRender, MatchesGolden) {
+    const GoldenCase& gc = GetParam();
+    const auto goldenPath = goldenDir() / (gc.name + ".f32");
+
+    AudioBuffer input(2, kFrames), output(2, kFrames);
+    kInputs[gc.input].make(input);
+
+    EffectEngine engine;
+    engine.prepare(kSR, kBlock);
+    ASSERT_TRUE(engine.loadPreset(gc.preset.string()));
+    render(engine, input, output);
+
+    if (recordMode()) {
+        ASSERT_TRUE(writeGolden(goldenPath, output)) << goldenPath;
+        std::printf("[  golden  ] recorded %s\n", goldenPath.string().c_str());
+        return;
+    }
+
+    Golden g;
+    ASSERT_TRUE(readGolden(goldenPath, g))
+        << "missing or unreadable golden " << goldenPath << " (record with GEARBOX_GOLDEN_RECORD=1)";
+    ASSERT_EQ(g.sampleRate, static_cast<uint32_t>(kSR));
+    ASSERT_EQ(g.channels, 2u);
+    ASSERT_EQ(g.frames, static_cast<uint32_t>(kFrames));
+
+    golden::DiffStats st;
+    for (int c = 0; c < 2; ++c)
+        golden::merge(st, golden::diff(g.data[c].data(), output.getReadPointer(c), kFrames), c);
+
+    char summary[256];
+    if (st.exact()) {
+        std::snprintf(summary, sizeof(summary), "bit-exact");
+    } else {
+        const int fc = st.firstDiffChannel;
+        const auto fi = static_cast<size_t>(st.firstDiff);
+        std::snprintf(summary, sizeof(summary),
+                      "max abs %.3g (ch %d, frame %zu), SNR %.1f dB, first difference ch %d frame %zu: "
+                      "%.9g vs golden %.9g",
+                      st.maxAbsError, st.maxAbsChannel, st.maxAbsIndex, st.snrDb(),
+                      fc, fi, output.getReadPointer(fc)[fi], g.data[fc][fi]);
+    }
+    std::printf("[  golden  ] %s: %s\n", gc.name.c_str(), summary);
+
+    if (exactMode()) {
+        EXPECT_TRUE(st.exact()) << summary;
+    } else {
+        EXPECT_LE(st.maxAbsError, maxAbsLimit()) << summary;
+        EXPECT_GE(st.snrDb(), minSnrLimit()) << summary;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Presets, GoldenRender, ::testing::ValuesIn(goldenCases()),
+                         [](const auto& info) { return info.param.name; });
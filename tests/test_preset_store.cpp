@@ -2,6 +2,8 @@
 #include "PresetStore.h"
 #include "EffectChain.h"
 #include "effects/EffectNodeRegistry.h"
+#include "effects/OversampledNode.h"
+#include "effects/amp/NeuralAmpNode.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <filesystem>
@@ -101,6 +103,32 @@ TEST_F(PresetStoreTest, SaveAndReload) {
     std::filesystem::remove(tempPath);
 }
 
+TEST_F(PresetStoreTest, TempoRoundTrip) {
+    nlohmann::json j = {
+        {"preset_id",      "tempo-test"},
+        {"format_version", "1.0"},
+        {"name",           "Tempo Test"},
+        {"routing_mode",   "serial"},
+        {"bpm",            96.5},
+        {"effect_chain",   nlohmann::json::array()}
+    };
+    auto result = PresetStore::loadFromJson(j, chain, reg, kSR, kBlock);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_DOUBLE_EQ(result->bpm, 96.5);
+
+    std::string tempPath = "presets/test_tempo_output.json";
+    ASSERT_TRUE(PresetStore::saveToFile(tempPath, *result, chain));
+    auto reloaded = PresetStore::loadFromFile(tempPath, chain, reg, kSR, kBlock);
+    std::filesystem::remove(tempPath);
+    ASSERT_TRUE(reloaded.has_value());
+    EXPECT_DOUBLE_EQ(reloaded->bpm, 96.5);
+
+    j["bpm"] = 1000.0;
+    EXPECT_DOUBLE_EQ(PresetStore::loadFromJson(j, chain, reg, kSR, kBlock)->bpm, TempoClock::kMaxBpm);
+    j.erase("bpm");
+    EXPECT_DOUBLE_EQ(PresetStore::loadFromJson(j, chain, reg, kSR, kBlock)->bpm, TempoClock::kDefaultBpm);
+}
+
 TEST_F(PresetStoreTest, MissingFileReturnsNullopt) {
     auto result = PresetStore::loadFromFile(
         "presets/nonexistent.json", chain, reg, kSR, kBlock);
@@ -185,3 +213,116 @@ TEST_F(PresetStoreTest, DisabledNodeIsPreserved) {
     ASSERT_NE(node, nullptr);
     EXPECT_FALSE(node->isEnabled());
 }
+
+TEST_F(PresetStoreTest, NodeDataRoundTrip) {
+    nlohmann::json j = {
+        {"preset_id",      "data-test"},
+        {"format_version", "1.0"},
+        {"name",           "Data Test"},
+        {"routing_mode",   "serial"},
+        {"output_volume",  1.0f},
+        {"effect_chain", {
+            {
+                {"id",      "cab_1"},
+                {"type",    "cab.short_ir"},
+                {"enabled", true},
+                {"params",  {{"taps", 128.0f}}},
+                {"data",    {{"ir", {1.0f, 0.5f, 0.25f}}, {"ir_sample_rate", 48000.0}}}
+            }
+        }}
+    };
+
+    auto result = PresetStore::loadFromJson(j, chain, reg, kSR, kBlock);
+    ASSERT_TRUE(result.has_value());
+
+    std::string tempPath = "presets/test_data_output.json";
+    ASSERT_TRUE(PresetStore::saveToFile(tempPath, *result, chain));
+
+    std::ifstream f(tempPath);
+    nlohmann::json saved;
+    f >> saved;
+    f.close();
+    std::filesystem::remove(tempPath);
+
+    auto& node = saved["effect_chain"][0];
+    ASSERT_TRUE(node.contains("data"));
+    EXPECT_EQ(node["data"]["ir"].size(), 3u);
+}
+
+TEST_F(PresetStoreTest, OversamplingFactorRoundTrip) {
+    nlohmann::json j = {
+        {"preset_id",      "os-test"},
+        {"format_version", "1.0"},
+        {"name",           "Oversampling Test"},
+        {"routing_mode",   "serial"},
+        {"output_volume",  1.0f},
+        {"effect_chain", {
+            {
+                {"id",           "od_1"},
+                {"type",         "gain.overdrive"},
+                {"enabled",      true},
+                {"oversampling", 4},
+                {"params",       {{"gain", 0.8f}}}
+            }
+        }}
+    };
+
+    auto result = PresetStore::loadFromJson(j, chain, reg, kSR, kBlock);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(chain.nodes().size(), 1u);
+
+    auto node = chain.findNode("od_1");
+    ASSERT_NE(node, nullptr);
+    EXPECT_EQ(node->typeId(), "gain.overdrive");
+    EXPECT_FLOAT_EQ(node->getParam("gain"), 0.8f);
+    EXPECT_GT(chain.latencySamples(), 0);
+
+    auto os = std::dynamic_pointer_cast<OversampledNode>(node);
+    ASSERT_NE(os, nullptr);
+    EXPECT_EQ(os->factor(), 4);
+
+    std::string tempPath = "presets/test_os_output.json";
+    ASSERT_TRUE(PresetStore::saveToFile(tempPath, *result, chain));
+
+    std::ifstream f(tempPath);
+    nlohmann::json saved;
+    f >> saved;
+    f.close();
+    std::filesystem::remove(tempPath);
+
+    EXPECT_EQ(saved["effect_chain"][0].value("oversampling", 1), 4);
+}
+
+TEST_F(PresetStoreTest, NeuralModelPathIsRelativeToPreset) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "gearboxfx_model_path_test";
+    fs::create_directories(dir / "amps");
+
+    // One-unit GRU: 3 gate rows of one weight each.
+    nlohmann::json model = {
+        {"type", "gru"}, {"hidden_size", 1},
+        {"weight_ih", {0.5f, -0.3f, 0.8f}}, {"weight_hh", {{0.1f}, {0.2f}, {-0.4f}}},
+        {"dense_weight", {0.7f}}
+    };
+    std::ofstream(dir / "amps" / "capture.json") << model.dump();
+
+    nlohmann::json preset = {
+        {"name", "Model Path Test"},
+        {"effect_chain", {{
+            {"id",   "amp_1"},
+            {"type", "amp.neural"},
+            {"data", {{"model_path", "amps/capture.json"}}}
+        }}}
+    };
+    std::ofstream(dir / "preset.json") << preset.dump();
+
+    // The test runs from the build directory, so a working-directory lookup fails.
+    auto result = PresetStore::loadFromFile((dir / "preset.json").string(), chain, reg, kSR, kBlock);
+    ASSERT_TRUE(result.has_value());
+    auto node = std::dynamic_pointer_cast<NeuralAmpNode>(chain.findNode("amp_1"));
+    ASSERT_NE(node, nullptr);
+    EXPECT_TRUE(node->hasModel()) << node->modelError();
+    EXPECT_EQ(node->saveData()["model_path"], "amps/capture.json");
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include "EffectEngine.h"
+#include "RtCheck.h"
+#include "AudioBuffer.h"
+#include "effects/utility/LooperNode.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Runs with the GearBoxRtCheck hooks linked in (gearboxfx_rt_tests): any
+// allocation, lock or blocking call inside EffectEngine::processBlock fails.
+
+using namespace gearboxfx;
+
+static constexpr double kSR     = 48000.0;
+static constexpr int    kBlock  = 256;
+static constexpr int    kBlocks = 400;
+
+class RtSafety : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(rtcheck::hooksInstalled());
+        rtcheck::setMode(rtcheck::Mode::Count);
+        rtcheck::resetViolations();
+    }
+
+    void TearDown() override { rtcheck::setMode(rtcheck::Mode::Off); }
+
+    static std::string summary() {
+        std::string s;
+        for (int k = 0; k < rtcheck::kNumKinds; ++k) {
+            auto kind = static_cast<rtcheck::Kind>(k);
+            s += std::string(rtcheck::kindName(kind)) + "=" + std::to_string(rtcheck::violations(kind)) + " ";
+        }
+        return s + "\n" + rtcheck::firstViolation();
+    }
+
+    // Runs kBlocks of a plucked tone through the engine. Every 16 blocks one
+    // parameter moves (from this, the "GUI", thread) to its min, max, default
+    // or midpoint, so work deferred to the audio thread is exercised too.
+    // setParam itself runs outside the real-time scope on purpose (see RtCheck.h).
+    static void render(EffectEngine& engine) {
+        AudioBuffer in(2, kBlock), out(2, kBlock);
+        long long n = 0;
+        int step = 0;
+        for (int b = 0; b < kBlocks; ++b) {
+            for (int s = 0; s < kBlock; ++s, ++n) {
+                float env = std::exp(-static_cast<float>(n % 24000) / 6000.0f);
+                float x   = 0.5f * env * static_cast<float>(std::sin(2.0 * 3.141592653589793 * 196.0 * n / kSR));
+                in.getWritePointer(0)[s] = in.getWritePointer(1)[s] = x;
+            }
+            engine.processBlock(in.view(), out.view(), kBlock);
+
+            if (b % 16 != 15) continue;
+            for (const auto& node : engine.chain().nodes()) {
+                const auto& defs = node->paramDefs();
+                if (defs.empty()) continue;
+                auto it = defs.begin();
+                std::advance(it, step % defs.size());
+                const ParamDef& d = it->second;
+                const float v = (step % 4 == 0) ? d.minValue
+                              : (step % 4 == 1) ? d.maxValue
+                              : (step % 4 == 2) ? d.defaultValue
+                                                : 0.5f * (d.minValue + d.maxValue);
+                engine.setParam(node->id() + "." + it->first, v);
+            }
+            ++step;
+        }
+    }
+};
+
+TEST_F(RtSafety, DetectsViolationsInRealtimeScope) {
+    {
+        rtcheck::RealtimeScope rt;
+        void* volatile p = std::malloc(64);
+        std::free(p);
+        std::mutex m;
+        m.lock();
+        m.unlock();
+    }
+    EXPECT_GE(rtcheck::violations(rtcheck::Allocation), 1u);
+    EXPECT_GE(rtcheck::violations(rtcheck::Deallocation), 1u);
+    EXPECT_GE(rtcheck::violations(rtcheck::Lock), 1u);
+    EXPECT_NE(rtcheck::firstViolation().find("malloc"), std::string::npos);
+
+    // Outside the scope nothing counts
+    rtcheck::resetViolations();
+    void* volatile p = std::malloc(64);
+    std::free(p);
+    EXPECT_EQ(rtcheck::totalViolations(), 0u);
+}
+
+class RtSafetyNode : public RtSafety, public ::testing::WithParamInterface<std::string> {};
+
+TEST_P(RtSafetyNode, ProcessIsRealtimeSafe) {
+    EffectEngine engine;
+    engine.prepare(kSR, kBlock);
+    auto node = engine.registry().create(GetParam());
+    ASSERT_NE(node, nullptr);
+    node->setId("fx");
+    engine.chain().addNode(node);
+    engine.parameterManager().syncFromChain();
+
+    rtcheck::resetViolations();
+    render(engine);
+    EXPECT_EQ(rtcheck::totalViolations(), 0u) << GetParam() << ": " << summary();
+}
+
+INSTANTIATE_TEST_SUITE_P(AllTypes, RtSafetyNode,
+    ::testing::ValuesIn(EffectNodeRegistry().registeredTypes()),
+    [](const ::testing::TestParamInfo<std::string>& info) {
+        std::string name = info.param;
+        for (char& c : name) if (c == '.') c = '_';
+        return name;
+    });
+
+TEST_F(RtSafety, PresetsAreRealtimeSafe) {
+    int count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator("presets")) {
+        if (entry.path().extension() != ".json") continue;
+        SCOPED_TRACE(entry.path().string());
+        EffectEngine engine;
+        engine.prepare(kSR, kBlock);
+        ASSERT_TRUE(engine.loadPreset(entry.path().string()));
+
+        rtcheck::resetViolations();
+        render(engine);
+        EXPECT_EQ(rtcheck::totalViolations(), 0u) << summary();
+        ++count;
+    }
+    EXPECT_GT(count, 0);
+}
+
+// The looper spills to disk past its RAM budget; recording into the stream
+// buffers and playing the tail back must stay inside the audio thread's
+// rules, with all file I/O on the spill thread.
+TEST_F(RtSafety, LooperSpillAndPlaybackAreRealtimeSafe) {
+    EffectEngine engine;
+    engine.prepare(kSR, kBlock);
+    auto looper = std::make_shared<LooperNode>();
+    looper->setId("looper");
+    looper->setMemorySeconds(0.25);
+    engine.chain().addNode(looper);
+    engine.parameterManager().syncFromChain();
+
+    auto waitForSpill = [&] {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (looper->spillPending() > 0 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+    };
+
+    AudioBuffer in(2, kBlock), out(2, kBlock);
+    long long n = 0;
+    auto block = [&](float inputGain) {
+        for (int s = 0; s < kBlock; ++s, ++n) {
+            float x = inputGain * 0.5f * static_cast<float>(std::sin(2.0 * 3.141592653589793 * 196.0 * n / kSR));
+            in.getWritePointer(0)[s] = in.getWritePointer(1)[s] = x;
+        }
+        engine.processBlock(in.view(), out.view(), kBlock);
+        waitForSpill();  // outside the real-time scope, keeps the test deterministic
+    };
+
+    ASSERT_TRUE(engine.looperCommand(LooperCommand::Record));  // allocates here, not in the scope
+    rtcheck::resetViolations();
+    const int loopBlocks = static_cast<int>(1.0 * kSR / kBlock);  // 4x the RAM budget
+    for (int b = 0; b < loopBlocks; ++b) block(1.0f);
+    engine.looperCommand(LooperCommand::Play);
+
+    // Every block of both passes plays back recorded audio, the spilled tail included
+    float quietestBlock = 1.0f;
+    for (int b = 0; b < 2 * loopBlocks; ++b) {
+        block(0.0f);
+        float peak = 0.0f;
+        for (int s = 0; s < kBlock; ++s)
+            peak = std::max(peak, std::abs(out.getReadPointer(0)[s]));
+        quietestBlock = std::min(quietestBlock, peak);
+    }
+    EXPECT_EQ(rtcheck::totalViolations(), 0u) << summary();
+    EXPECT_EQ(looper->state(), LooperState::Playing);
+    EXPECT_EQ(looper->spillUnderruns(), 0);
+    EXPECT_GT(quietestBlock, 0.25f);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "SimulatedAudioIO.h"
+#include "EffectEngine.h"
+#include <chrono>
+#include <thread>
+
+using namespace gearboxfx;
+
+// 10 ms blocks keep the schedule coarse enough for a loaded CI machine.
+static AudioFormat simFormat() {
+    AudioFormat fmt;
+    fmt.sampleRate  = 48000;
+    fmt.numChannels = 2;
+    fmt.bufferSize  = 480;
+    return fmt;
+}
+
+TEST(SimulatedAudioIO, PacesBlocksAtThePeriod) {
+    EffectEngine engine;
+    SimRtConfig cfg;
+    cfg.durationSeconds = 0.3;
+    SimulatedAudioIO io(engine, cfg);
+    ASSERT_TRUE(io.open(simFormat()));
+    io.start();
+
+    auto rep = io.report();
+    EXPECT_EQ(rep.blocks, 30u);
+    EXPECT_NEAR(rep.periodUs, 10000.0, 1e-6);
+    EXPECT_GE(rep.minLatencyMs, 20.0 - 1e-6);  // two periods, empty chain
+    if (rep.deadlineMisses == 0) EXPECT_NEAR(rep.minLatencyMs, 20.0, 1e-6);
+    EXPECT_EQ(rep.wakeLatency.total(), 30u);
+
+    auto st = io.stats().snapshot();
+    EXPECT_EQ(st.callbacks, 30u);
+    EXPECT_EQ(st.interval.total(), 29u);
+    EXPECT_GT(st.interval.percentileUs(50), 5000.0);  // paced, not run back to back
+    EXPECT_GT(io.outputLevel(), 0.1f);                // the default input went through
+    EXPECT_NE(rep.format().find("30 blocks"), std::string::npos);
+}
+
+TEST(SimulatedAudioIO, LateBlockIsADeadlineMissAndShiftsPlayback) {
+    EffectEngine engine;
+    SimRtConfig cfg;
+    cfg.durationSeconds = 0.2;
+    SimulatedAudioIO io(engine, cfg);
+    ASSERT_TRUE(io.open(simFormat()));
+    io.setInputGenerator([](AudioBufferView in, std::uint64_t frame) {
+        for (int c = 0; c < in.numChannels; ++c)
+            for (int s = 0; s < in.numSamples; ++s) in[c][s] = 0.0f;
+        if (frame == 5 * 480) std::this_thread::sleep_for(std::chrono::milliseconds(45));
+    });
+    io.start();
+
+    // Block 5 finishes 45+ ms after its tick, 55+ ms after its capture
+    // started, however early blocks fared on a busy machine.
+    auto rep = io.report();
+    EXPECT_EQ(rep.blocks, 20u);
+    EXPECT_GE(rep.deadlineMisses, 1u);
+    EXPECT_GE(rep.underruns, 1u);
+    EXPECT_GE(rep.maxLatencyMs, 55.0);
+    EXPECT_GE(io.stats().snapshot().overruns, 1u);
+}
+
+TEST(SimulatedAudioIO, LockedChainSkipsBlocks) {
+    EffectEngine engine;
+    SimRtConfig cfg;
+    cfg.durationSeconds = 0.4;
+    SimulatedAudioIO io(engine, cfg);
+    ASSERT_TRUE(io.open(simFormat()));
+
+    std::thread audio([&] { io.start(); });
+    while (!io.isRunning()) std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    {
+        auto lock = io.lockChain();  // as a preset switch would
+        ASSERT_TRUE(engine.loadPreset("presets/05_delay_reverb.json"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    }
+    audio.join();
+
+    auto rep = io.report();
+    EXPECT_GE(rep.lockSkips, 1u);
+    EXPECT_EQ(rep.lockSkips, io.stats().snapshot().lockSkips);
+    EXPECT_LT(rep.lockSkips, rep.blocks);
+}
+
+TEST(SimulatedAudioIO, InjectsJitterAndContention) {
+    EffectEngine engine;
+    SimRtConfig cfg;
+    cfg.durationSeconds   = 0.3;
+    cfg.jitterUs          = 2000.0;
+    cfg.contentionThreads = 1;
+    cfg.contentionDuty    = 0.3;
+    SimulatedAudioIO io(engine, cfg);
+    ASSERT_TRUE(io.open(simFormat()));
+    io.start();
+
+    auto rep = io.report();
+    EXPECT_EQ(rep.blocks, 30u);
+    EXPECT_GE(rep.maxWakeLatencyUs, 1000.0);
+    EXPECT_GE(rep.wakeLatency.percentileUs(99), 1000.0);
+}